@@ -59,6 +59,12 @@ PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOESEXT = 0;
 PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT = 0;
 PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT = 0;
 
+// defined in core gl/hardware.cpp
+extern "C" {
+    extern PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESEXT;
+    extern PFNGLPROGRAMBINARYOESPROC glProgramBinaryOESEXT;
+}
+
 void bindJniEnvToThread(JNIEnv* jniEnv) {
     jniEnv->GetJavaVM(&jvm);
     jniRenderThreadEnv = jniEnv;
@@ -316,11 +322,11 @@ void featurePickCallback(JNIEnv* jniEnv, jobject listener, const std::vector<Tan
 
     jobject hashmap = jniEnv->NewObject(hashmapClass, hashmapInitMID);
 
-    for (const auto& item : properties->items()) {
-        jstring jkey = jniEnv->NewStringUTF(item.key.c_str());
-        jstring jvalue = jniEnv->NewStringUTF(properties->asString(item.value).c_str());
+    properties->forEach([&](const std::string& _key, const Tangram::Value& _value) {
+        jstring jkey = jniEnv->NewStringUTF(_key.c_str());
+        jstring jvalue = jniEnv->NewStringUTF(properties->asString(_value).c_str());
         jniEnv->CallObjectMethod(hashmap, hashmapPutMID, jkey, jvalue);
-    }
+    });
 
     jniEnv->CallVoidMethod(listener, onFeaturePickMID, hashmap, position[0], position[1]);
 }
@@ -331,6 +337,9 @@ void initGLExtensions() {
     glBindVertexArrayOESEXT = (PFNGLBINDVERTEXARRAYOESPROC) dlsym(libhandle, "glBindVertexArrayOES");
     glDeleteVertexArraysOESEXT = (PFNGLDELETEVERTEXARRAYSOESPROC) dlsym(libhandle, "glDeleteVertexArraysOES");
     glGenVertexArraysOESEXT = (PFNGLGENVERTEXARRAYSOESPROC) dlsym(libhandle, "glGenVertexArraysOES");
+
+    glGetProgramBinaryOESEXT = (PFNGLGETPROGRAMBINARYOESPROC) dlsym(libhandle, "glGetProgramBinaryOES");
+    glProgramBinaryOESEXT = (PFNGLPROGRAMBINARYOESPROC) dlsym(libhandle, "glProgramBinaryOES");
 }
 
 std::string stringFromJString(JNIEnv* jniEnv, jstring string) {
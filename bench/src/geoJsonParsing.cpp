@@ -0,0 +1,94 @@
+#include "data/tileData.h"
+#include "tile/tileID.h"
+#include "util/geoJson.h"
+#include "util/json.h"
+#include "util/mapProjection.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// A GeoJSON tile of N polygons with 32 vertices each and a few properties,
+// about 1.2kB per feature
+static std::string makeCollection(size_t _count) {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> dist(-0.5, 0.5);
+
+    std::string json = "{\"type\":\"FeatureCollection\",\"features\":[";
+    for (size_t i = 0; i < _count; i++) {
+        if (i > 0) { json += ","; }
+        json += "{\"type\":\"Feature\",\"id\":" + std::to_string(i) +
+            ",\"properties\":{\"kind\":\"building\",\"name\":\"Building " + std::to_string(i) +
+            "\",\"height\":" + std::to_string(i % 50) + "},";
+        json += "\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[";
+        for (int v = 0; v < 32; v++) {
+            if (v > 0) { json += ","; }
+            json += "[" + std::to_string(dist(gen)) + "," + std::to_string(dist(gen)) + "]";
+        }
+        json += "]]}}";
+    }
+    json += "]}";
+    return json;
+}
+
+static void BM_Tangram_GeoJsonDocument(benchmark::State& state) {
+    std::string json = makeCollection(state.range_x());
+    MercatorProjection projection;
+    GeoJson::TileProjection proj(projection, TileID(0, 0, 0));
+
+    while (state.KeepRunning()) {
+        const char* error;
+        size_t offset;
+        auto document = JsonParseBytes(json.data(), json.size(), &error, &offset);
+
+        TileData tileData;
+        tileData.layers.push_back(GeoJson::getLayer(document, proj, 0));
+        benchmark::DoNotOptimize(tileData);
+    }
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_Tangram_GeoJsonDocument)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void BM_Tangram_GeoJsonStream(benchmark::State& state) {
+    std::string json = makeCollection(state.range_x());
+    MercatorProjection projection;
+    GeoJson::TileProjection proj(projection, TileID(0, 0, 0));
+
+    while (state.KeepRunning()) {
+        const char* error;
+        size_t offset;
+        TileData tileData;
+        GeoJson::parseTileData(json.data(), json.size(), proj, 0, tileData, &error, &offset);
+        benchmark::DoNotOptimize(tileData);
+    }
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_Tangram_GeoJsonStream)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Includes copying the buffer that is consumed by the in-situ parsing
+static void BM_Tangram_GeoJsonStreamInsitu(benchmark::State& state) {
+    std::string json = makeCollection(state.range_x());
+    MercatorProjection projection;
+    GeoJson::TileProjection proj(projection, TileID(0, 0, 0));
+    std::vector<char> buffer;
+
+    while (state.KeepRunning()) {
+        buffer.assign(json.begin(), json.end());
+        buffer.push_back('\0');
+
+        const char* error;
+        size_t offset;
+        TileData tileData;
+        GeoJson::parseTileDataInsitu(buffer.data(), proj, 0, tileData, &error, &offset);
+        benchmark::DoNotOptimize(tileData);
+    }
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_Tangram_GeoJsonStreamInsitu)->Arg(100)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
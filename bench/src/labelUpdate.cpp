@@ -0,0 +1,87 @@
+#include "tangram.h"
+#include "gl.h"
+#include "labels/labels.h"
+#include "labels/labelSet.h"
+#include "labels/textLabel.h"
+#include "labels/textLabels.h"
+#include "marker/marker.h"
+#include "style/textStyle.h"
+#include "tile/tile.h"
+#include "view/view.h"
+
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Projection of 16 tiles with 256 labels each, on the main thread only (0)
+// or together with 1 to 3 update workers
+struct LabelScene {
+    View view;
+    std::vector<std::unique_ptr<Style>> styles;
+    std::vector<std::shared_ptr<Tile>> tiles;
+    std::vector<std::unique_ptr<Marker>> markers;
+
+    // Leaked, since TextLabels release their glyphs from the style font context
+    TextStyle* dummyStyle = new TextStyle("dummy", nullptr);
+    TextLabels* dummyLabels = new TextLabels(*dummyStyle);
+
+    LabelScene() : view(1024, 1024) {
+        view.setPosition(0, 0);
+        view.setZoom(2);
+        view.update(false);
+
+        auto style = std::make_unique<TextStyle>("labels", nullptr, false);
+        style->setID(0);
+
+        struct BenchLabelSet : public LabelSet {
+            void addLabel(std::unique_ptr<Label> _label) { m_labels.push_back(std::move(_label)); }
+        };
+
+        for (int x = 0; x < 4; x++) {
+            for (int y = 0; y < 4; y++) {
+                auto labelSet = std::make_unique<BenchLabelSet>();
+
+                for (int i = 0; i < 256; i++) {
+                    Label::Options options;
+                    options.anchors.anchor[0] = LabelProperty::Anchor::center;
+                    options.anchors.count = 1;
+
+                    glm::vec2 p0((i % 16) / 16.f, (i / 16) / 16.f);
+                    glm::vec2 p1 = p0 + glm::vec2(1.f / 16.f, 0.f);
+                    Label::Type type = (i % 2) ? Label::Type::line : Label::Type::point;
+
+                    labelSet->addLabel(std::make_unique<TextLabel>(Label::Transform{p0, p1}, type, options,
+                                                                   TextLabel::FontVertexAttributes{},
+                                                                   glm::vec2{20, 10}, *dummyLabels,
+                                                                   TextRange{}, TextLabelProperty::Align::none));
+                }
+
+                auto tile = std::make_shared<Tile>(TileID(x, y, 2), view.getMapProjection());
+                tile->initGeometry(1);
+                tile->setMesh(*style, std::move(labelSet));
+                tile->update(0, view);
+                tiles.push_back(tile);
+            }
+        }
+        styles.push_back(std::move(style));
+    }
+};
+
+static void BM_Tangram_UpdateLabels(benchmark::State& state) {
+    static LabelScene scene;
+
+    Labels labels;
+    labels.setUpdateWorkers(state.range_x());
+
+    while (state.KeepRunning()) {
+        labels.updateLabels(scene.view, 0.016f, scene.styles, scene.tiles, scene.markers, false);
+    }
+    state.SetItemsProcessed(state.iterations() * scene.tiles.size() * 256);
+}
+BENCHMARK(BM_Tangram_UpdateLabels)->DenseRange(0, 3)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+#include "tangram.h"
+#include "gl.h"
+#include "labels/labelCollider.h"
+#include "labels/repeatGrid.h"
+#include "labels/textLabel.h"
+#include "labels/textLabels.h"
+#include "style/textStyle.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtx/norm.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Dense repeat group: N labels (e.g. shields of one highway) spread over a 2048px
+// screen with a repeat distance of 64px, each tested and kept when far enough
+static std::vector<glm::vec2> makePositions(size_t _count) {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(0.f, 2048.f);
+
+    std::vector<glm::vec2> positions;
+    for (size_t i = 0; i < _count; i++) {
+        positions.emplace_back(dist(gen), dist(gen));
+    }
+    return positions;
+}
+
+static const float repeatDistance = 64.f;
+
+static void BM_Tangram_RepeatGroupLinear(benchmark::State& state) {
+    auto positions = makePositions(state.range_x());
+    std::vector<glm::vec2> placed;
+
+    while (state.KeepRunning()) {
+        placed.clear();
+        for (auto& p : positions) {
+            bool within = false;
+            for (auto& q : placed) {
+                if (glm::distance2(p, q) < repeatDistance * repeatDistance) { within = true; break; }
+            }
+            if (!within) { placed.push_back(p); }
+        }
+        benchmark::DoNotOptimize(placed.data());
+    }
+    state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_Tangram_RepeatGroupLinear)->Range(64, 8192);
+
+static void BM_Tangram_RepeatGroupGrid(benchmark::State& state) {
+    auto positions = makePositions(state.range_x());
+    RepeatGrid grid;
+
+    while (state.KeepRunning()) {
+        grid.reset(repeatDistance);
+        for (auto& p : positions) {
+            if (!grid.withinDistance(p, repeatDistance)) { grid.insert(p); }
+        }
+        benchmark::DoNotOptimize(grid.size());
+    }
+    state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_Tangram_RepeatGroupGrid)->Range(64, 8192);
+
+// Tile build time collision of one repeat group with overlapping labels
+static void BM_Tangram_CollideRepeatGroup(benchmark::State& state) {
+    // Leaked, since TextLabels release their glyphs from the style font context
+    static TextStyle* style = new TextStyle("dummy", nullptr);
+    static TextLabels* textLabels = new TextLabels(*style);
+
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        std::vector<std::unique_ptr<Label>> labels;
+        for (int i = 0; i < state.range_x(); i++) {
+            Label::Options options;
+            options.anchors.anchor[0] = LabelProperty::Anchor::center;
+            options.anchors.count = 1;
+            options.repeatGroup = 1;
+            options.repeatDistance = repeatDistance;
+            options.priority = i % 4;
+
+            labels.push_back(std::make_unique<TextLabel>(Label::Transform{{dist(gen), dist(gen)}},
+                                                         Label::Type::point, options,
+                                                         TextLabel::FontVertexAttributes{},
+                                                         glm::vec2{32, 16}, *textLabels,
+                                                         TextRange{}, TextLabelProperty::Align::none));
+        }
+        LabelCollider collider;
+        collider.setup(256, 4, 14);
+        collider.addLabels(labels);
+        state.ResumeTiming();
+
+        collider.process();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range_x());
+}
+BENCHMARK(BM_Tangram_CollideRepeatGroup)->Range(64, 4096);
+
+BENCHMARK_MAIN();
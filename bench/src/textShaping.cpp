@@ -0,0 +1,123 @@
+#include "tangram.h"
+#include "gl.h"
+#include "platform.h"
+#include "data/dataSource.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+#include "text/fontContext.h"
+#include "util/mapProjection.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Label layout of many distinct strings, run on 1 to 4 threads sharing one FontContext
+static FontContext& sharedFontContext() {
+    static FontContext* context = [] {
+        auto ctx = new FontContext();
+        ctx->loadFonts();
+        return ctx;
+    }();
+    return *context;
+}
+
+static std::vector<std::string> makeLabels() {
+    const char* words[] = { "Main", "Street", "Avenue", "Park", "North", "Boulevard", "Lake",
+                            "Saint", "Bridge", "Station", "Market", "Hill", "Road", "Square" };
+    const size_t nWords = sizeof(words) / sizeof(words[0]);
+
+    std::vector<std::string> labels;
+    for (size_t i = 0; i < 512; i++) {
+        labels.push_back(std::string(words[i % nWords]) + " " + words[(i * 7 + 3) % nWords] +
+                         " " + std::to_string(i));
+    }
+    return labels;
+}
+
+static void BM_Tangram_LayoutText(benchmark::State& state) {
+    auto& context = sharedFontContext();
+    static const std::vector<std::string> labels = makeLabels();
+
+    TextStyle::Parameters params;
+    params.font = context.getFont("sans-serif", "normal", "400", 16);
+    params.fontScale = params.fontSize / params.font->size();
+
+    std::vector<GlyphQuad> quads;
+    std::bitset<FontContext::max_textures> refs;
+    glm::vec2 size;
+    TextRange ranges;
+
+    while (state.KeepRunning()) {
+        for (auto& label : labels) {
+            quads.clear();
+            context.layoutText(params, label, quads, refs, size, ranges);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * labels.size());
+
+    context.releaseAtlas(refs);
+}
+BENCHMARK(BM_Tangram_LayoutText)->ThreadRange(1, 4)->UseRealTime();
+
+// Building a label heavy tile on 1 to 4 threads, each with its own TileBuilder
+struct SharedScene {
+    MercatorProjection projection;
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<DataSource> source;
+    std::vector<char> rawTileData;
+
+    SharedScene() {
+        const char* sceneFile = "scene.yaml";
+        scene = std::make_shared<Scene>(sceneFile);
+
+        YAML::Node sceneNode;
+        try { sceneNode = YAML::Load(stringFromFile(sceneFile)); }
+        catch (YAML::ParserException e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return;
+        }
+        SceneLoader::applyConfig(sceneNode, scene);
+        scene->fontContext()->loadFonts();
+
+        source = *scene->dataSources().begin();
+
+        size_t size = 0;
+        unsigned char* data = bytesFromFile("tile.mvt", size);
+        if (data) {
+            rawTileData.assign(data, data + size);
+            free(data);
+        }
+    }
+
+    std::shared_ptr<TileData> parseTile(const TileID& _tileID) {
+        auto task = source->createTask(_tileID);
+        auto& t = dynamic_cast<DownloadTileTask&>(*task);
+        t.rawTileData = std::make_shared<std::vector<char>>(rawTileData);
+
+        return source->parse(*task, projection);
+    }
+};
+
+static void BM_Tangram_BuildLabelTile(benchmark::State& state) {
+    static SharedScene shared;
+
+    TileID tileID(0, 0, 10, 10, 0);
+    TileBuilder builder(shared.scene);
+    auto tileData = shared.parseTile(tileID);
+
+    while (state.KeepRunning()) {
+        auto tile = builder.build(tileID, *tileData, *shared.source);
+        benchmark::DoNotOptimize(tile);
+    }
+}
+BENCHMARK(BM_Tangram_BuildLabelTile)->ThreadRange(1, 4)->UseRealTime();
+
+BENCHMARK_MAIN();
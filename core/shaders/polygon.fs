@@ -6,11 +6,9 @@ precision highp float;
 
 #pragma tangram: defines
 
-uniform mat4 u_model;
 uniform mat4 u_view;
 uniform mat4 u_proj;
 uniform mat3 u_normal_matrix;
-uniform vec4 u_tile_origin;
 uniform vec3 u_map_position;
 uniform vec2 u_resolution;
 uniform float u_time;
@@ -18,6 +16,14 @@ uniform float u_meters_per_pixel;
 uniform float u_device_pixel_ratio;
 uniform mat3 u_inverse_normal_matrix;
 
+#ifdef TANGRAM_BATCH_TILES
+    varying vec4 v_batch_tile_origin;
+    #define u_tile_origin v_batch_tile_origin
+#else
+    uniform mat4 u_model;
+    uniform vec4 u_tile_origin;
+#endif
+
 #pragma tangram: uniforms
 
 varying vec4 v_world_position;
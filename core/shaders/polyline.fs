@@ -6,12 +6,10 @@ precision highp float;
 
 #pragma tangram: defines
 
-uniform mat4 u_model;
 uniform mat4 u_view;
 uniform mat4 u_proj;
 uniform mat3 u_normal_matrix;
 uniform mat3 u_inverse_normal_matrix;
-uniform vec4 u_tile_origin;
 uniform vec3 u_map_position;
 uniform vec2 u_resolution;
 uniform float u_time;
@@ -20,6 +18,14 @@ uniform float u_device_pixel_ratio;
 uniform float u_texture_ratio;
 uniform sampler2D u_texture;
 
+#ifdef TANGRAM_BATCH_TILES
+    varying vec4 v_batch_tile_origin;
+    #define u_tile_origin v_batch_tile_origin
+#else
+    uniform mat4 u_model;
+    uniform vec4 u_tile_origin;
+#endif
+
 #pragma tangram: uniforms
 
 varying vec4 v_world_position;
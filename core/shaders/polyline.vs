@@ -6,17 +6,28 @@ precision highp float;
 
 #pragma tangram: defines
 
-uniform mat4 u_model;
 uniform mat4 u_view;
 uniform mat4 u_proj;
 uniform mat3 u_normal_matrix;
-uniform vec4 u_tile_origin;
 uniform vec3 u_map_position;
 uniform vec2 u_resolution;
 uniform float u_time;
 uniform float u_meters_per_pixel;
 uniform float u_device_pixel_ratio;
-uniform float u_proxy_depth;
+
+#ifdef TANGRAM_BATCH_TILES
+    // Per tile of the batch: translation, scale and proxy depth, then the tile origin
+    uniform vec4 u_batch_tiles[TANGRAM_BATCH_TILES * 2];
+    attribute float a_batch_index;
+    varying vec4 v_batch_tile_origin;
+    mat4 u_model;
+    vec4 u_tile_origin;
+    float u_proxy_depth;
+#else
+    uniform mat4 u_model;
+    uniform vec4 u_tile_origin;
+    uniform float u_proxy_depth;
+#endif
 
 #pragma tangram: uniforms
 
@@ -70,6 +81,18 @@ vec4 modelPositionBaseZoom() {
 
 void main() {
 
+    #ifdef TANGRAM_BATCH_TILES
+        int batch_tile = int(a_batch_index) * 2;
+        vec4 batch_transform = u_batch_tiles[batch_tile];
+        u_model = mat4(batch_transform.z, 0., 0., 0.,
+                       0., batch_transform.z, 0., 0.,
+                       0., 0., batch_transform.z, 0.,
+                       batch_transform.x, batch_transform.y, 0., 1.);
+        u_proxy_depth = batch_transform.w;
+        u_tile_origin = u_batch_tiles[batch_tile + 1];
+        v_batch_tile_origin = u_tile_origin;
+    #endif
+
     // Initialize globals
     #pragma tangram: setup
 
@@ -1,36 +1,23 @@
 #include "clientGeoJsonSource.h"
-#define GEOJSONVT_CUSTOM_TAGS
-#include "mapbox/geojsonvt/geojsonvt_types.hpp"
-#include "mapbox/geojsonvt/geojsonvt.hpp"
-#include "mapbox/geojsonvt/geojsonvt_convert.hpp"
 #include "platform.h"
 #include "tangram.h"
 #include "tile/tileTask.h"
-#include "util/geom.h"
+#include "util/geoJsonTiler.h"
+#include "glm/common.hpp"
 #include "data/propertyItem.h"
 #include "data/tileData.h"
 #include "tile/tile.h"
 #include "view/view.h"
 
+#include <algorithm>
 #include <regex>
 
-using namespace mapbox::util;
-
 namespace Tangram {
 
-const double extent = 4096;
-const uint32_t indexMaxPoints = 100000;
-double tolerance = 1E-8;
-
 std::shared_ptr<TileTask> ClientGeoJsonSource::createTask(TileID _tileId, int _subTask) {
     return std::make_shared<TileTask>(_tileId, shared_from_this(), _subTask);
 }
 
-// Transform a geojsonvt::TilePoint into the corresponding Tangram::Point
-Point transformPoint(geojsonvt::TilePoint pt) {
-    return { pt.x / extent, 1. - pt.y / extent, 0 };
-}
-
 // TODO: pass scene's resourcePath to constructor to be used with `stringFromFile`
 ClientGeoJsonSource::ClientGeoJsonSource(const std::string& _name, const std::string& _url, int32_t _maxZoom)
     : DataSource(_name, _url, _maxZoom) {
@@ -39,6 +26,11 @@ ClientGeoJsonSource::ClientGeoJsonSource(const std::string& _name, const std::st
     // TODO: generic uri handling
     m_generateGeometry = true;
 
+    {
+        std::lock_guard<std::mutex> lock(m_mutexStore);
+        publishChanges();
+    }
+
     if (!_url.empty()) {
         std::regex r("^(http|https):/");
         std::smatch match;
@@ -59,18 +51,25 @@ ClientGeoJsonSource::ClientGeoJsonSource(const std::string& _name, const std::st
 
 ClientGeoJsonSource::~ClientGeoJsonSource() {}
 
+constexpr size_t ClientGeoJsonSource::min_merge_features;
+constexpr size_t ClientGeoJsonSource::max_changed_bounds;
+
 void ClientGeoJsonSource::addData(const std::string& _data) {
 
-    auto features = geojsonvt::GeoJSONVT::convertFeatures(_data);
+    std::vector<ProjectedFeature> features;
+    GeoJsonTiler::parseFeatures(_data, features);
+
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+
+    bool inBatch = m_inBatch;
+    m_inBatch = true;
 
     for (auto& f : features) {
-        m_features.push_back(std::move(f));
+        addFeature(std::move(f));
     }
 
-    std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-    m_generation++;
-
+    m_inBatch = inBatch;
+    if (!m_inBatch) { applyChanges(); }
 }
 
 bool ClientGeoJsonSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
@@ -86,134 +85,349 @@ bool ClientGeoJsonSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTa
 
 void ClientGeoJsonSource::clearData() {
 
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+
     m_features.clear();
+    m_recentFeatures.clear();
+    m_hiddenFeatures.clear();
+    m_featureEntries.clear();
+    m_index.reset();
+    m_indexChanged = false;
+
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>());
+
+    m_changes.clear();
+    m_pendingBounds.clear();
 
-    std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store.reset();
     m_generation++;
+    m_fullUpdate = m_generation;
+
+    publishChanges();
 }
 
-void ClientGeoJsonSource::addPoint(const Properties& _tags, LngLat _point) {
+static std::vector<glm::dvec2> projectLine(const Coordinates& _line) {
 
-    auto container = geojsonvt::Convert::project({ geojsonvt::LonLat(_point.longitude, _point.latitude) }, tolerance);
+    std::vector<glm::dvec2> line;
+    line.reserve(_line.size());
+    for (auto& lngLat : _line) {
+        line.push_back(GeoJsonTiler::project(lngLat));
+    }
+    return line;
+}
+
+static GeoJsonTiler::ProjectedFeature createPoint(const Properties& _tags, LngLat _point) {
 
-    geojsonvt::Tags tags;
+    GeoJsonTiler::ProjectedFeature feature;
+    feature.geometryType = GeometryType::points;
+    feature.parts.push_back({ GeoJsonTiler::project(_point) });
+    feature.setProperties(_tags);
+    feature.updateBounds();
+
+    return feature;
+}
 
-    auto feature = geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
-                                              geojsonvt::ProjectedFeatureType::Point,
-                                              container.members);
+static GeoJsonTiler::ProjectedFeature createLine(const Properties& _tags, const Coordinates& _line) {
 
-    m_features.push_back(std::move(feature));
+    GeoJsonTiler::ProjectedFeature feature;
+    feature.geometryType = GeometryType::lines;
+    feature.parts.push_back(projectLine(_line));
+    feature.setProperties(_tags);
+    feature.updateBounds();
+    feature.simplify();
 
+    return feature;
+}
+
+static GeoJsonTiler::ProjectedFeature createPoly(const Properties& _tags, const std::vector<Coordinates>& _poly) {
+
+    GeoJsonTiler::ProjectedFeature feature;
+    feature.geometryType = GeometryType::polygons;
+    for (auto& ring : _poly) {
+        feature.parts.push_back(projectLine(ring));
+    }
+    if (!_poly.empty()) { feature.ringCounts.push_back(_poly.size()); }
+    feature.setProperties(_tags);
+    feature.updateBounds();
+    feature.simplify();
+
+    return feature;
+}
+
+auto ClientGeoJsonSource::addPoint(const Properties& _tags, LngLat _point) -> FeatureID {
     std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-    m_generation++;
+    return addFeature(createPoint(_tags, _point));
 }
 
-void ClientGeoJsonSource::addLine(const Properties& _tags, const Coordinates& _line) {
-    auto& line = reinterpret_cast<const std::vector<geojsonvt::LonLat>&>(_line);
+auto ClientGeoJsonSource::addLine(const Properties& _tags, const Coordinates& _line) -> FeatureID {
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+    return addFeature(createLine(_tags, _line));
+}
 
-    std::vector<geojsonvt::ProjectedGeometry> geometry = { geojsonvt::Convert::project(line, tolerance) };
+auto ClientGeoJsonSource::addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly) -> FeatureID {
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+    return addFeature(createPoly(_tags, _poly));
+}
 
-    auto feature = geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
-                                              geojsonvt::ProjectedFeatureType::LineString,
-                                              geometry);
+bool ClientGeoJsonSource::updatePoint(FeatureID _id, const Properties& _tags, LngLat _point) {
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+    return replaceFeature(_id, createPoint(_tags, _point));
+}
 
-    m_features.push_back(std::move(feature));
+bool ClientGeoJsonSource::updateLine(FeatureID _id, const Properties& _tags, const Coordinates& _line) {
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+    return replaceFeature(_id, createLine(_tags, _line));
+}
 
+bool ClientGeoJsonSource::updatePoly(FeatureID _id, const Properties& _tags, const std::vector<Coordinates>& _poly) {
     std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-    m_generation++;
+    return replaceFeature(_id, createPoly(_tags, _poly));
 }
 
-void ClientGeoJsonSource::addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly) {
+bool ClientGeoJsonSource::removeFeature(FeatureID _id) {
+    std::lock_guard<std::mutex> lock(m_mutexStore);
 
-    geojsonvt::ProjectedGeometryContainer geometry;
-    for (auto& _ring : _poly) {
-        auto& ring = reinterpret_cast<const std::vector<geojsonvt::LonLat>&>(_ring);
-        geometry.members.push_back(geojsonvt::Convert::project(ring, tolerance));
-    }
+    auto it = m_featureEntries.find(_id);
+    if (it == m_featureEntries.end()) { return false; }
+
+    dropFeature(_id, it->second);
+    addChange(it->second.bounds);
+
+    m_featureEntries.erase(it);
+    return true;
+}
+
+void ClientGeoJsonSource::beginUpdate() {
+    std::lock_guard<std::mutex> lock(m_mutexStore);
 
-    auto feature = geojsonvt::Convert::create(geojsonvt::Tags{std::make_shared<Properties>(_tags)},
-                                              geojsonvt::ProjectedFeatureType::Polygon,
-                                              geometry);
+    // Index the committed changes, the features of the batch must not be cut before
+    // it is committed
+    updateIndex();
 
-    m_features.push_back(std::move(feature));
+    m_inBatch = true;
+}
 
+void ClientGeoJsonSource::commitUpdate() {
     std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
+    m_inBatch = false;
+    applyChanges();
+}
+
+auto ClientGeoJsonSource::addFeature(ProjectedFeature&& _feature) -> FeatureID {
+
+    FeatureID id = m_nextFeatureId++;
+    _feature.id = id;
+
+    Bounds bounds{ _feature.min, _feature.max };
+    m_featureEntries[id] = FeatureEntry{ false, bounds };
+
+    m_recentFeatures.push_back(std::make_shared<ProjectedFeature>(std::move(_feature)));
+
+    addChange(bounds);
+    return id;
+}
+
+bool ClientGeoJsonSource::replaceFeature(FeatureID _id, ProjectedFeature&& _feature) {
+
+    auto it = m_featureEntries.find(_id);
+    if (it == m_featureEntries.end()) { return false; }
+
+    dropFeature(_id, it->second);
+
+    _feature.id = _id;
+
+    Bounds bounds{ _feature.min, _feature.max };
+
+    // Tiles of the old and the new geometry change
+    Bounds changed{ glm::min(bounds.min, it->second.bounds.min),
+                    glm::max(bounds.max, it->second.bounds.max) };
+
+    it->second = FeatureEntry{ false, bounds };
+
+    m_recentFeatures.push_back(std::make_shared<ProjectedFeature>(std::move(_feature)));
+
+    addChange(changed);
+    return true;
+}
+
+void ClientGeoJsonSource::dropFeature(FeatureID _id, const FeatureEntry& _entry) {
+
+    if (_entry.indexed) {
+        // Filtered out until the main index is rebuilt
+        m_hiddenFeatures.insert(_id);
+    } else {
+        auto it = std::find_if(m_recentFeatures.begin(), m_recentFeatures.end(),
+                               [&](auto& f) { return f->id == _id; });
+        if (it != m_recentFeatures.end()) { m_recentFeatures.erase(it); }
+    }
+}
+
+void ClientGeoJsonSource::addChange(const Bounds& _bounds) {
+
+    m_pendingBounds.push_back(_bounds);
+
+    if (!m_inBatch) { applyChanges(); }
+}
+
+void ClientGeoJsonSource::applyChanges() {
+
+    if (m_pendingBounds.empty()) { return; }
+
+    // The index is updated lazily, before tiles of the new generation are cut
+    m_indexChanged = true;
     m_generation++;
+
+    if (m_changes.size() + m_pendingBounds.size() > max_changed_bounds) {
+        // Too many to track, reload all tiles once
+        m_changes.clear();
+        m_fullUpdate = m_generation;
+    } else {
+        for (auto& bounds : m_pendingBounds) {
+            m_changes.push_back({ m_generation, bounds });
+        }
+    }
+    m_pendingBounds.clear();
+
+    publishChanges();
 }
 
-std::shared_ptr<TileData> ClientGeoJsonSource::parse(const TileTask& _task,
-                                                     const MapProjection& _projection) const {
+void ClientGeoJsonSource::publishChanges() {
+    auto changeLog = std::make_shared<ChangeLog>();
+    changeLog->generation = m_generation;
+    changeLog->fullUpdate = m_fullUpdate;
+    changeLog->changes = m_changes;
 
-    auto data = std::make_shared<TileData>();
+    std::atomic_store(&m_changeLog, std::shared_ptr<const ChangeLog>(std::move(changeLog)));
+}
 
-    geojsonvt::Tile tile;
-    {
+void ClientGeoJsonSource::setOldestGeneration(int64_t _generation) {
+
+    std::lock_guard<std::mutex> lock(m_mutexStore);
+
+    // Tiles loaded at _generation need the changes after it
+    if (_generation <= m_fullUpdate) { return; }
+
+    auto end = std::find_if(m_changes.begin(), m_changes.end(),
+                            [&](auto& change) { return change.generation > _generation; });
+    if (end == m_changes.begin()) { return; }
+
+    // Tiles that were released before, e.g. into the TileCache, are reloaded
+    m_changes.erase(m_changes.begin(), end);
+    m_fullUpdate = _generation;
+
+    publishChanges();
+}
+
+bool ClientGeoJsonSource::isOutdated(const TileID& _tileID, int64_t _generation) const {
+
+    auto changeLog = std::atomic_load(&m_changeLog);
+
+    if (_generation >= changeLog->generation) { return false; }
+    if (_generation < changeLog->fullUpdate) { return true; }
+
+    // Tile bounds in projected coordinates, with the buffer of the tiler
+    double size = 1.0 / (1 << _tileID.z);
+    double buffer = size * GeoJsonTiler::buffer;
+    glm::dvec2 min{ _tileID.x * size - buffer, _tileID.y * size - buffer };
+    glm::dvec2 max{ (_tileID.x + 1) * size + buffer, (_tileID.y + 1) * size + buffer };
+
+    auto& changes = changeLog->changes;
+    for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
+        if (it->generation <= _generation) { break; }
+
+        auto& b = it->bounds;
+        if (b.min.x <= max.x && b.max.x >= min.x &&
+            b.min.y <= max.y && b.max.y >= min.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ClientGeoJsonSource::updateIndex() const {
+
+    if (!m_indexChanged) { return; }
+    m_indexChanged = false;
+
+    size_t mergeLimit = std::max(min_merge_features, m_features.size() / 8);
+
+    if (m_recentFeatures.size() > mergeLimit || m_hiddenFeatures.size() > mergeLimit) {
+
+        m_features.erase(std::remove_if(m_features.begin(), m_features.end(),
+                                        [&](auto& f) { return m_hiddenFeatures.count(f->id) > 0; }),
+                         m_features.end());
+        m_hiddenFeatures.clear();
+
+        for (auto& f : m_recentFeatures) {
+            m_featureEntries[f->id].indexed = true;
+            m_features.push_back(std::move(f));
+        }
+        m_recentFeatures.clear();
+
+        m_index.reset();
+        if (!m_features.empty()) {
+            m_index = std::make_shared<GeoJsonTiler::Index>(m_features);
+        }
+    }
+
+    // Features are shared between the indices of all snapshots, only the index
+    // of recent features and the hidden ids are rebuilt
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->index = m_index;
+    if (!m_recentFeatures.empty()) {
+        snapshot->recentIndex = std::make_shared<GeoJsonTiler::Index>(m_recentFeatures);
+    }
+    snapshot->hiddenFeatures = m_hiddenFeatures;
+
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
+auto ClientGeoJsonSource::snapshot() const -> std::shared_ptr<const Snapshot> {
+    if (m_indexChanged) {
         std::lock_guard<std::mutex> lock(m_mutexStore);
-        if (!m_store) { return nullptr; }
-        tile = m_store->getTile(_task.tileId().z, _task.tileId().x, _task.tileId().y);
+        updateIndex();
     }
+    return std::atomic_load(&m_snapshot);
+}
 
-    Layer layer(""); // empty name will skip filtering by 'collection'
+std::shared_ptr<TileData> ClientGeoJsonSource::parse(const TileTask& _task,
+                                                     const MapProjection& _projection) const {
+
+    // Tiles are cut from the current snapshot, in parallel on all workers
+    auto snapshot = this->snapshot();
+    if (!snapshot || (!snapshot->index && !snapshot->recentIndex)) { return nullptr; }
+
+    TileID id = _task.tileId();
+    std::vector<const ProjectedFeature*> features;
 
-    for (auto& it : tile.features) {
-
-        Feature feat(m_id);
-
-        const auto& geom = it.tileGeometry;
-        const auto type = it.type;
-
-        switch (type) {
-            case geojsonvt::TileFeatureType::Point: {
-                feat.geometryType = GeometryType::points;
-                for (const auto& pt : geom) {
-                    const auto& point = pt.get<geojsonvt::TilePoint>();
-                    feat.points.push_back(transformPoint(point));
-                }
-                break;
-            }
-            case geojsonvt::TileFeatureType::LineString: {
-                feat.geometryType = GeometryType::lines;
-                for (const auto& r : geom) {
-                    Line line;
-                    for (const auto& pt : r.get<geojsonvt::TileRing>().points) {
-                        line.push_back(transformPoint(pt));
-                    }
-                    feat.lines.emplace_back(std::move(line));
-                }
-                break;
-            }
-            case geojsonvt::TileFeatureType::Polygon: {
-                feat.geometryType = GeometryType::polygons;
-                for (const auto& r : geom) {
-                    Line line;
-                    for (const auto& pt : r.get<geojsonvt::TileRing>().points) {
-                        line.push_back(transformPoint(pt));
-                    }
-                    // Polygons are in a flat list of rings, with ccw rings indicating
-                    // the beginning of a new polygon
-                    if (signedArea(line.begin(), line.end()) >= 0 || feat.polygons.empty()) {
-                        feat.polygons.emplace_back();
-                    }
-                    feat.polygons.back().push_back(std::move(line));
-                }
-                break;
-            }
-            default: break;
+    if (snapshot->index) {
+        snapshot->index->query(id, features);
+
+        auto& hidden = snapshot->hiddenFeatures;
+        if (!hidden.empty()) {
+            features.erase(std::remove_if(features.begin(), features.end(),
+                                          [&](auto* f) { return hidden.count(f->id) > 0; }),
+                           features.end());
         }
+    }
+    if (snapshot->recentIndex) {
+        snapshot->recentIndex->query(id, features);
+    }
+
+    auto data = std::make_shared<TileData>();
 
-        feat.props = *it.tags.map;
-        layer.features.emplace_back(std::move(feat));
+    Layer layer(""); // empty name will skip filtering by 'collection'
+    layer.features.reserve(features.size());
 
+    for (auto* f : features) {
+        Feature feature(m_id);
+        if (GeoJsonTiler::cutFeature(*f, id, feature)) {
+            layer.features.push_back(std::move(feature));
+        }
     }
 
     data->layers.emplace_back(std::move(layer));
 
     return data;
-
 }
 
 }
@@ -3,49 +3,169 @@
 #include "dataSource.h"
 #include "util/types.h"
 
-#include <mutex>
+#include "glm/vec2.hpp"
 
-namespace mapbox {
-namespace util {
-namespace geojsonvt {
-class GeoJSONVT;
-class TilePoint;
-class ProjectedFeature;
-}}}
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Tangram {
 
-using GeoJSONVT = mapbox::util::geojsonvt::GeoJSONVT;
-
 struct Properties;
 
+namespace GeoJsonTiler {
+struct ProjectedFeature;
+class Index;
+}
+
 class ClientGeoJsonSource : public DataSource {
 
 public:
 
+    using FeatureID = uint64_t;
+
     ClientGeoJsonSource(const std::string& _name, const std::string& _url, int32_t _maxZoom = 18);
     ~ClientGeoJsonSource();
 
     // Add geometry from a GeoJSON string
     void addData(const std::string& _data);
-    void addPoint(const Properties& _tags, LngLat _point);
-    void addLine(const Properties& _tags, const Coordinates& _line);
-    void addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly);
+
+    // Add a feature, returns the id to update or remove it
+    FeatureID addPoint(const Properties& _tags, LngLat _point);
+    FeatureID addLine(const Properties& _tags, const Coordinates& _line);
+    FeatureID addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly);
+
+    // Replace the feature _id, returns false when there is none
+    bool updatePoint(FeatureID _id, const Properties& _tags, LngLat _point);
+    bool updateLine(FeatureID _id, const Properties& _tags, const Coordinates& _line);
+    bool updatePoly(FeatureID _id, const Properties& _tags, const std::vector<Coordinates>& _poly);
+
+    bool removeFeature(FeatureID _id);
+
+    /* Collect the following changes and apply them together on commitUpdate().
+     * Otherwise each change is applied on its own. */
+    void beginUpdate();
+    void commitUpdate();
 
     virtual bool loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) override;
     std::shared_ptr<TileTask> createTask(TileID _tileId, int _subTask) override;
 
     virtual void cancelLoadingTile(const TileID& _tile) override {};
     virtual void clearData() override;
+    virtual bool slicesOverzoomedTiles() const override { return false; }
+
+    /* Tiles are only outdated when a change since _generation touched their bounds */
+    virtual bool isOutdated(const TileID& _tileID, int64_t _generation) const override;
+
+    /* Drop the changes that no loaded tile is older than */
+    virtual void setOldestGeneration(int64_t _generation) override;
+
+    // Number of recent features that are tiled separately until they are merged
+    // into the main index, unless there are more than 1/8 of its features
+    static constexpr size_t min_merge_features = 256;
+    // Number of tracked changed bounds beyond which all tiles are outdated
+    static constexpr size_t max_changed_bounds = 4096;
 
 protected:
 
     virtual std::shared_ptr<TileData> parse(const TileTask& _task,
                                             const MapProjection& _projection) const override;
 
-    std::unique_ptr<GeoJSONVT> m_store;
+    using ProjectedFeature = GeoJsonTiler::ProjectedFeature;
+    using FeaturePtr = std::shared_ptr<const ProjectedFeature>;
+
+    struct Bounds {
+        glm::dvec2 min;
+        glm::dvec2 max;
+    };
+
+    struct FeatureEntry {
+        bool indexed;
+        Bounds bounds;
+    };
+
+    struct Change {
+        int64_t generation;
+        Bounds bounds;
+    };
+
+    /* The changes at one point in time, published like the Snapshot so that
+     * isOutdated() does not lock m_mutexStore */
+    struct ChangeLog {
+        int64_t generation;
+        // Tiles of generations before are outdated
+        int64_t fullUpdate;
+        std::vector<Change> changes;
+    };
+
+    /* The indexed features at one point in time. Snapshots are not modified after they
+     * were published, so that tile workers can cut tiles from the current one in parallel
+     * without holding a lock, while changes are prepared in a new snapshot. */
+    struct Snapshot {
+        // Main index and the index of features added since it was built
+        std::shared_ptr<const GeoJsonTiler::Index> index;
+        std::shared_ptr<const GeoJsonTiler::Index> recentIndex;
+        // Features of the main index that were removed or replaced
+        std::unordered_set<FeatureID> hiddenFeatures;
+    };
+
+    FeatureID addFeature(ProjectedFeature&& _feature);
+    bool replaceFeature(FeatureID _id, ProjectedFeature&& _feature);
+
+    // Drop the feature _id from the recent features, or hide it in the main index
+    void dropFeature(FeatureID _id, const FeatureEntry& _entry);
+
+    void addChange(const Bounds& _bounds);
+    void applyChanges();
+
+    // Publish m_changes for isOutdated(). Must be called with m_mutexStore locked.
+    void publishChanges();
+
+    // Rebuild the index of recent features, merging them into the main index
+    // when they became too many, and publish a new snapshot. Must be called with
+    // m_mutexStore locked.
+    void updateIndex() const;
+
+    // The current snapshot, may be called without holding m_mutexStore. The index is
+    // updated here when it changed, by the first tile worker that needs it, so that
+    // a series of changes is indexed once instead of on each change.
+    std::shared_ptr<const Snapshot> snapshot() const;
+
+    // Guards the state of the index below, readers only take m_snapshot
     mutable std::mutex m_mutexStore;
-    std::vector<mapbox::util::geojsonvt::ProjectedFeature> m_features;
+
+    // Read and replaced with std::atomic_load and std::atomic_store
+    mutable std::shared_ptr<const Snapshot> m_snapshot;
+    std::shared_ptr<const ChangeLog> m_changeLog;
+
+    // The index state is mutable for updateIndex() on tile workers, under m_mutexStore
+
+    // Features of the main index
+    mutable std::vector<FeaturePtr> m_features;
+    mutable std::shared_ptr<const GeoJsonTiler::Index> m_index;
+    // Features added since the main index was built, tiled separately
+    mutable std::vector<FeaturePtr> m_recentFeatures;
+    // Set when changes were applied, may be read without holding m_mutexStore
+    mutable std::atomic<bool> m_indexChanged{false};
+
+    // Features of the main index that were removed or replaced
+    mutable std::unordered_set<FeatureID> m_hiddenFeatures;
+
+    mutable std::unordered_map<FeatureID, FeatureEntry> m_featureEntries;
+    FeatureID m_nextFeatureId = 1;
+
+    // Bounds changed since m_fullUpdate, in projected coordinates. Tiles of
+    // earlier generations are outdated, as their changes were dropped.
+    std::vector<Change> m_changes;
+    int64_t m_fullUpdate = 0;
+
+    // Changes of the current batch, applied on commitUpdate()
+    std::vector<Bounds> m_pendingBounds;
+    bool m_inBatch = false;
+
     bool m_hasPendingData = false;
 
 };
@@ -8,11 +8,15 @@
 #include "tile/tileManager.h"
 #include "tile/tileTask.h"
 #include "gl/texture.h"
+#include "util/lruCache.h"
+#include "util/tileClip.h"
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <list>
 #include <functional>
+#include <future>
 #include <unordered_map>
 
 namespace Tangram {
@@ -32,12 +36,12 @@ struct RawCache {
     int m_usage = 0;
     int m_maxUsage = 0;
 
-    bool get(DownloadTileTask& _task) {
+    bool get(const TileID& tileID, DownloadTileTask& _task) {
 
         if (m_maxUsage <= 0) { return false; }
 
         std::lock_guard<std::mutex> lock(m_mutex);
-        TileID id(_task.tileId().x, _task.tileId().y, _task.tileId().z);
+        TileID id(tileID.x, tileID.y, tileID.z);
 
         auto it = m_cacheMap.find(id);
         if (it != m_cacheMap.end()) {
@@ -88,9 +92,51 @@ struct RawCache {
     }
 };
 
+struct ParsedCache {
+
+    // Parent tiles are large, keep only those of the tiles around the view
+    static constexpr size_t max_tiles = 8;
+
+    struct Entry {
+        int64_t generation;
+        std::shared_ptr<TileData> tileData;
+    };
+
+    ConcurrentLruCache<TileID, Entry, std::hash<TileID>, 1> m_tiles{max_tiles};
+
+    struct Parsing {
+        int64_t generation;
+        std::shared_future<std::shared_ptr<TileData>> tileData;
+    };
+
+    // Parent tiles being parsed, so that workers building other children of one
+    // parent wait for its data instead of parsing it again
+    std::mutex m_mutex;
+    std::unordered_map<TileID, Parsing> m_parsing;
+};
+
+struct UrlRequests {
+
+    struct Waiting {
+        std::shared_ptr<TileTask> task;
+        TileTaskCb cb;
+    };
+
+    // Used to ensure safe access from async loading threads
+    std::mutex m_mutex;
+
+    std::unordered_map<std::string, std::vector<Waiting>> m_waiting;
+};
+
+// Extent of the clipped lines beyond overzoomed tiles, in tile units. Keeps the caps
+// and joins of lines at the tile border within the geometry of the neighbors.
+static constexpr float overzoom_line_buffer = 0.125f;
+
 DataSource::DataSource(const std::string& _name, const std::string& _urlTemplate, int32_t _maxZoom) :
     m_name(_name), m_maxZoom(_maxZoom), m_urlTemplate(_urlTemplate),
-    m_cache(std::make_unique<RawCache>()){
+    m_cache(std::make_unique<RawCache>()),
+    m_parsedCache(std::make_unique<ParsedCache>()),
+    m_requests(std::make_unique<UrlRequests>()) {
 
     static std::atomic<int32_t> s_serial;
 
@@ -114,18 +160,90 @@ void DataSource::setCacheSize(size_t _cacheSize) {
 }
 
 bool DataSource::cacheGet(DownloadTileTask& _task) {
-    return m_cache->get(_task);
+    // Overzoomed tiles share the raw data of their parent
+    return m_cache->get(_task.tileId().withMaxSourceZoom(m_maxZoom), _task);
 }
 
 void DataSource::cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef) {
-    m_cache->put(_tileID, _rawDataRef);
+    m_cache->put(_tileID.withMaxSourceZoom(m_maxZoom), _rawDataRef);
 }
 
 void DataSource::clearData() {
     m_cache->clear();
+
+    std::vector<ParsedCache::Entry> evicted;
+    m_parsedCache->m_tiles.clear(evicted);
+
     m_generation++;
 }
 
+std::shared_ptr<TileData> DataSource::parseOverzoomed(const DownloadTileTask& _task,
+                                                      const MapProjection& _projection) {
+
+    TileID tileID = _task.tileId();
+    TileID parentID = tileID.withMaxSourceZoom(m_maxZoom);
+    TileID dataID(parentID.x, parentID.y, parentID.z);
+
+    auto& cache = *m_parsedCache;
+    int64_t generation = _task.sourceGeneration();
+
+    std::shared_ptr<TileData> parentData;
+    auto getCached = [&]() {
+        cache.m_tiles.get(dataID, [&](auto& entry) {
+            if (entry.generation == generation) { parentData = entry.tileData; }
+        });
+        return bool(parentData);
+    };
+
+    if (!getCached()) {
+        std::promise<std::shared_ptr<TileData>> promise;
+        std::shared_future<std::shared_ptr<TileData>> parsing;
+        bool owner = false;
+        {
+            std::lock_guard<std::mutex> lock(cache.m_mutex);
+
+            // Checked again, the parent may have been parsed meanwhile
+            if (!getCached()) {
+                auto it = cache.m_parsing.find(dataID);
+                if (it != cache.m_parsing.end() && it->second.generation == generation) {
+                    parsing = it->second.tileData;
+                } else {
+                    parsing = promise.get_future().share();
+                    cache.m_parsing[dataID] = { generation, parsing };
+                    owner = true;
+                }
+            }
+        }
+
+        if (owner) {
+            DownloadTileTask parentTask(dataID, shared_from_this(), -1);
+            parentTask.rawTileData = _task.rawTileData;
+
+            parentData = parse(parentTask, _projection);
+            if (parentData) {
+                std::vector<ParsedCache::Entry> evicted;
+                cache.m_tiles.put(dataID, { generation, parentData }, evicted);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(cache.m_mutex);
+                auto it = cache.m_parsing.find(dataID);
+                if (it != cache.m_parsing.end() && it->second.generation == generation) {
+                    cache.m_parsing.erase(it);
+                }
+            }
+            promise.set_value(parentData);
+
+        } else if (parsing.valid()) {
+            parentData = parsing.get();
+        }
+
+        if (!parentData) { return nullptr; }
+    }
+
+    return TileClip::clipToDescendant(*parentData, dataID, tileID, overzoom_line_buffer);
+}
+
 void DataSource::constructURL(const TileID& _tileCoord, std::string& _url) const {
     _url.assign(m_urlTemplate);
     try {
@@ -152,43 +270,119 @@ bool DataSource::equals(const DataSource& other) const {
     return true;
 }
 
-void DataSource::onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<TileTask>&& _task,
+void DataSource::onTileLoaded(std::shared_ptr<std::vector<char>> _rawData, std::shared_ptr<TileTask>&& _task,
                               TileTaskCb _cb) {
 
     if (_task->isCanceled()) { return; }
 
-    TileID tileID = _task->tileId();
+    if (!_rawData->empty()) {
+        auto& task = static_cast<DownloadTileTask&>(*_task);
+        task.rawTileData = _rawData;
+
+        _cb.func(std::move(_task));
+    }
+}
 
-    if (!_rawData.empty()) {
+void DataSource::onRequestDone(const std::string& _url, std::vector<char>&& _rawData) {
 
-        auto rawDataRef = std::make_shared<std::vector<char>>();
-        std::swap(*rawDataRef, _rawData);
+    std::vector<UrlRequests::Waiting> waiting;
+    {
+        std::lock_guard<std::mutex> lock(m_requests->m_mutex);
 
-        auto& task = static_cast<DownloadTileTask&>(*_task);
-        task.rawTileData = rawDataRef;
+        auto it = m_requests->m_waiting.find(_url);
+        if (it == m_requests->m_waiting.end()) { return; }
 
-        _cb.func(std::move(_task));
+        waiting = std::move(it->second);
+        m_requests->m_waiting.erase(it);
+    }
+
+    auto rawDataRef = std::make_shared<std::vector<char>>();
+    std::swap(*rawDataRef, _rawData);
+
+    if (!rawDataRef->empty() && !waiting.empty()) {
+        cachePut(waiting.front().task->tileId(), rawDataRef);
+    }
 
-        cachePut(tileID, rawDataRef);
+    for (auto& entry : waiting) {
+        onTileLoaded(rawDataRef, std::move(entry.task), entry.cb);
     }
 }
 
 bool DataSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
 
-    std::string url(constructURL(_task->tileId()));
+    std::string url(constructURL(_task->tileId().withMaxSourceZoom(m_maxZoom)));
+    const TileTask* task = _task.get();
 
-    // lambda captured parameters are const by default, we want "task" (moved) to be non-const,
-    // hence "mutable"
-    // Refer: http://en.cppreference.com/w/cpp/language/lambda
-    return startUrlRequest(url,
-            [this, _cb, task = std::move(_task)](std::vector<char>&& rawData) mutable {
-                this->onTileLoaded(std::move(rawData), std::move(task), _cb);
+    {
+        std::lock_guard<std::mutex> lock(m_requests->m_mutex);
+
+        auto& waiting = m_requests->m_waiting[url];
+        bool running = !waiting.empty();
+
+        waiting.push_back({ std::move(_task), _cb });
+
+        // Wait for the running request of another tile
+        if (running) { return true; }
+    }
+
+    // The request holds a reference to this source until it completes
+    auto source = shared_from_this();
+
+    bool started = startUrlRequest(url,
+            [source, url](std::vector<char>&& rawData) {
+                source->onRequestDone(url, std::move(rawData));
             });
 
+    if (!started) {
+        std::vector<UrlRequests::Waiting> waiting;
+        {
+            std::lock_guard<std::mutex> lock(m_requests->m_mutex);
+
+            auto it = m_requests->m_waiting.find(url);
+            if (it != m_requests->m_waiting.end()) {
+                waiting = std::move(it->second);
+                m_requests->m_waiting.erase(it);
+            }
+        }
+
+        // The caller handles its task on the return value. Tasks of other tiles
+        // that joined meanwhile are passed back without data, as failed.
+        for (auto& entry : waiting) {
+            if (entry.task.get() == task) { continue; }
+            entry.cb.func(std::move(entry.task));
+        }
+    }
+
+    return started;
 }
 
 void DataSource::cancelLoadingTile(const TileID& _tileID) {
-    cancelUrlRequest(constructURL(_tileID));
+    std::string url(constructURL(_tileID.withMaxSourceZoom(m_maxZoom)));
+
+    bool unused = false;
+    {
+        std::lock_guard<std::mutex> lock(m_requests->m_mutex);
+
+        auto it = m_requests->m_waiting.find(url);
+        if (it != m_requests->m_waiting.end()) {
+            // Tasks are canceled before their tile is removed. Drop them and
+            // keep the request as long as other tasks are waiting for it.
+            auto& waiting = it->second;
+            waiting.erase(std::remove_if(waiting.begin(), waiting.end(),
+                                         [](auto& entry) { return entry.task->isCanceled(); }),
+                          waiting.end());
+
+            if (waiting.empty()) {
+                m_requests->m_waiting.erase(it);
+                unused = true;
+            }
+        }
+    }
+
+    if (unused) {
+        cancelUrlRequest(url);
+    }
+
     for (auto& raster : m_rasterSources) {
         TileID rasterID = _tileID.withMaxSourceZoom(raster->maxZoom());
         raster->cancelLoadingTile(rasterID);
@@ -16,6 +16,8 @@ struct Raster;
 class Tile;
 class TileManager;
 struct RawCache;
+struct ParsedCache;
+struct UrlRequests;
 class Texture;
 
 class DataSource : public std::enable_shared_from_this<DataSource> {
@@ -35,17 +37,28 @@ public:
      *
      * LoadTile starts an asynchronous I/O task to retrieve the data for a tile. When
      * the I/O task is complete, the tile data is added to a queue in @_tileManager for
-     * further processing before it is renderable.
+     * further processing before it is renderable. Tasks for the same URL share one
+     * request, that is passed on to each of them when it completes.
      */
     virtual bool loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb);
 
 
-    /* Stops any running I/O tasks pertaining to @_tile */
+    /* Stops any running I/O tasks pertaining to @_tile. Shared requests are only
+     * stopped when all of their tasks were canceled. */
     virtual void cancelLoadingTile(const TileID& _tile);
 
     /* Parse a <TileTask> with data into a <TileData>, returning an empty TileData on failure */
     virtual std::shared_ptr<TileData> parse(const TileTask& _task, const MapProjection& _projection) const = 0;
 
+    /* Get the share of an overzoomed tile from the TileData of its parent tile at <m_maxZoom>.
+     * The parsed parent is cached for the other descendants. */
+    std::shared_ptr<TileData> parseOverzoomed(const DownloadTileTask& _task, const MapProjection& _projection);
+
+    /* Whether tiles beyond <m_maxZoom> are loaded as such, each clipped from the data of
+     * their parent tile. Otherwise they are replaced by the parent tile, which is drawn
+     * with the overzoomed style. */
+    virtual bool slicesOverzoomedTiles() const { return true; }
+
     /* Clears all data associated with this DataSource */
     virtual void clearData();
 
@@ -69,6 +82,16 @@ public:
     /* Generation ID of DataSource state (incremented for each update, e.g. on clearData()) */
     int64_t generation() const { return m_generation; }
 
+    /* Whether the data of _tileID loaded at _generation has changed since.
+     * By default every update of the source outdates all of its tiles. */
+    virtual bool isOutdated(const TileID& _tileID, int64_t _generation) const {
+        return _generation < m_generation;
+    }
+
+    /* Called with the oldest generation of the tiles of this source that are loaded
+     * or in progress. Sources may drop what they keep for isOutdated() of older tiles. */
+    virtual void setOldestGeneration(int64_t _generation) {}
+
     int32_t maxZoom() const { return m_maxZoom; }
 
     /* assign/get raster datasources to this datasource */
@@ -83,9 +106,12 @@ public:
 
 protected:
 
-    virtual void onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<TileTask>&& _task,
+    /* Pass the raw data of a completed request to one of its tasks */
+    virtual void onTileLoaded(std::shared_ptr<std::vector<char>> _rawData, std::shared_ptr<TileTask>&& _task,
                               TileTaskCb _cb);
 
+    void onRequestDone(const std::string& _url, std::vector<char>&& _rawData);
+
     /* Constructs the URL of a tile using <m_urlTemplate> */
     virtual void constructURL(const TileID& _tileCoord, std::string& _url) const;
 
@@ -119,6 +145,12 @@ protected:
 
     std::unique_ptr<RawCache> m_cache;
 
+    // Parsed parent tiles of overzoomed tiles
+    std::unique_ptr<ParsedCache> m_parsedCache;
+
+    // Tasks waiting for each running request
+    std::unique_ptr<UrlRequests> m_requests;
+
     /* vector of raster sources (as raster samplers) referenced by this datasource */
     std::vector<std::shared_ptr<DataSource>> m_rasterSources;
 };
@@ -8,19 +8,101 @@ Properties::Properties() : sourceId(0) {}
 
 Properties::~Properties() {}
 
+Properties::Properties(const Properties& _other) = default;
+
+Properties::Properties(Properties&& _other) = default;
+
+Properties& Properties::operator=(const Properties& _other) = default;
+
 Properties& Properties::operator=(Properties&& _other) {
     props = std::move(_other.props);
+    m_dictionary = std::move(_other.m_dictionary);
+    m_tags = std::move(_other.m_tags);
     sourceId = _other.sourceId;
     return *this;
 }
 
 void Properties::setSorted(std::vector<Item>&& _items) {
     props = std::move(_items);
+    m_dictionary.reset();
+    m_tags.clear();
+}
+
+void Properties::setShared(std::shared_ptr<const Dictionary> _dictionary, std::vector<Tag>&& _tags) {
+    props.clear();
+    m_dictionary = std::move(_dictionary);
+    m_tags = std::move(_tags);
+}
+
+void Properties::detach() {
+    if (!m_dictionary) { return; }
+
+    props.clear();
+    props.reserve(m_tags.size());
+    for (auto& tag : m_tags) {
+        props.emplace_back(m_dictionary->keys[tag.key], m_dictionary->values[tag.value]);
+    }
+
+    m_dictionary.reset();
+    std::vector<Tag>().swap(m_tags);
+}
+
+void Properties::forEach(const std::function<void(const std::string&, const Value&)>& _fn) const {
+    if (m_dictionary) {
+        for (auto& tag : m_tags) {
+            _fn(m_dictionary->keys[tag.key], m_dictionary->values[tag.value]);
+        }
+    } else {
+        for (auto& item : props) {
+            _fn(item.key, item.value);
+        }
+    }
+}
+
+size_t Properties::size() const {
+    return m_dictionary ? m_tags.size() : props.size();
+}
+
+size_t Properties::memoryUsage() const {
+    if (m_dictionary) {
+        return m_tags.capacity() * sizeof(Tag);
+    }
+
+    size_t size = props.capacity() * sizeof(Item);
+    for (auto& item : props) {
+        size += item.key.capacity();
+        if (item.value.is<std::string>()) {
+            size += item.value.get<std::string>().capacity();
+        }
+    }
+    return size;
+}
+
+size_t PropertyDictionary::memoryUsage() const {
+    size_t size = keys.capacity() * sizeof(std::string) + values.capacity() * sizeof(Value);
+    for (auto& key : keys) {
+        size += key.capacity();
+    }
+    for (auto& value : values) {
+        if (value.is<std::string>()) {
+            size += value.get<std::string>().capacity();
+        }
+    }
+    return size;
 }
 
 const Value& Properties::get(const std::string& key) const {
     const static Value NOT_FOUND(none_type{});
 
+    if (m_dictionary) {
+        for (auto& tag : m_tags) {
+            if (m_dictionary->keys[tag.key] == key) {
+                return m_dictionary->values[tag.value];
+            }
+        }
+        return NOT_FOUND;
+    }
+
     const auto it = std::find_if(props.begin(), props.end(),
                                  [&](const auto& item) {
                                      return item.key == key;
@@ -40,7 +122,11 @@ const Value& Properties::get(const std::string& key) const {
     return it->value;
 }
 
-void Properties::clear() { props.clear(); }
+void Properties::clear() {
+    props.clear();
+    m_dictionary.reset();
+    m_tags.clear();
+}
 
 bool Properties::contains(const std::string& key) const {
     return !get(key).is<none_type>();
@@ -112,11 +198,19 @@ std::string Properties::getAsString(const std::string& key) const {
 }
 
 void Properties::sort() {
+    if (m_dictionary) {
+        auto& keys = m_dictionary->keys;
+        std::sort(m_tags.begin(), m_tags.end(),
+                  [&](auto& a, auto& b) { return keyComparator(keys[a.key], keys[b.key]); });
+        return;
+    }
     std::sort(props.begin(), props.end());
 }
 
 void Properties::set(std::string key, std::string value) {
 
+    detach();
+
     auto it = std::lower_bound(props.begin(), props.end(), key,
                                [](auto& item, auto& key) {
                                    return keyComparator(item.key, key);
@@ -131,6 +225,8 @@ void Properties::set(std::string key, std::string value) {
 
 void Properties::set(std::string key, double value) {
 
+    detach();
+
     auto it = std::lower_bound(props.begin(), props.end(), key,
                                [](auto& item, auto& key) {
                                    return keyComparator(item.key, key);
@@ -147,9 +243,20 @@ std::string Properties::toJson() const {
 
     std::string json = "{ ";
 
-    for (const auto& item : props) {
-        bool last = (&item == &props.back());
-        json += "\"" + item.key + "\": \"" + asString(item.value) + (last ? "\"" : "\",");
+    auto append = [&](const std::string& _key, const Value& _value, bool _last) {
+        json += "\"" + _key + "\": \"" + asString(_value) + (_last ? "\"" : "\",");
+    };
+
+    if (m_dictionary) {
+        for (const auto& tag : m_tags) {
+            bool last = (&tag == &m_tags.back());
+            append(m_dictionary->keys[tag.key], m_dictionary->values[tag.value], last);
+        }
+    } else {
+        for (const auto& item : props) {
+            bool last = (&item == &props.back());
+            append(item.key, item.value, last);
+        }
     }
 
     json += " }";
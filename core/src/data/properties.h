@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -7,17 +10,25 @@ namespace Tangram {
 
 class Value;
 struct PropertyItem;
+struct PropertyDictionary;
 
 struct Properties {
     using Item = PropertyItem;
+    using Dictionary = PropertyDictionary;
+
+    // Indices of a key and its value in a Dictionary
+    struct Tag {
+        uint32_t key;
+        uint32_t value;
+    };
 
     Properties();
     ~Properties();
 
-    Properties(const Properties& _other) = default;
-    Properties(Properties&& _other) = default;
+    Properties(const Properties& _other);
+    Properties(Properties&& _other);
     Properties(std::vector<Item>&& _items);
-    Properties& operator=(const Properties& _other) = default;
+    Properties& operator=(const Properties& _other);
     Properties& operator=(Properties&& _other);
 
     const Value& get(const std::string& key) const;
@@ -49,13 +60,32 @@ struct Properties {
 
     void setSorted(std::vector<Item>&& _items);
 
+    /* Reference the keys and values of _dictionary, shared between the features
+     * of a layer, instead of holding copies. _tags must be sorted by key like
+     * the items of Properties. On modification the properties are copied out
+     * of the dictionary. */
+    void setShared(std::shared_ptr<const Dictionary> _dictionary, std::vector<Tag>&& _tags);
+
+    bool isShared() const { return bool(m_dictionary); }
+
+    const std::shared_ptr<const Dictionary>& dictionary() const { return m_dictionary; }
+
+    const std::vector<Tag>& tags() const { return m_tags; }
+
+    // Call _fn with each key and value, in key order
+    void forEach(const std::function<void(const std::string&, const Value&)>& _fn) const;
+
+    size_t size() const;
+
+    // Approximate heap memory owned by these Properties, not counting a shared dictionary,
+    // see PropertyDictionary::memoryUsage()
+    size_t memoryUsage() const;
+
     // template <typename... Args> void set(std::string key, Args&&... args) {
     //     props.emplace_back(std::move(key), Value{std::forward<Args>(args)...});
     //     sort();
     // }
 
-    const std::vector<Item>& items() const { return props; }
-
     int32_t sourceId;
 
     static bool keyComparator(const std::string& a, const std::string& b) {
@@ -66,7 +96,13 @@ struct Properties {
         }
     }
 private:
+    // Copy the items out of the shared dictionary before modification
+    void detach();
+
     std::vector<Item> props;
+
+    std::shared_ptr<const Dictionary> m_dictionary;
+    std::vector<Tag> m_tags;
 };
 
 }
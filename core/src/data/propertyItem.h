@@ -2,6 +2,9 @@
 
 #include "util/variant.h"
 
+#include <string>
+#include <vector>
+
 namespace Tangram {
 
 struct PropertyItem {
@@ -17,4 +20,13 @@ struct PropertyItem {
     }
 };
 
+/* Keys and values of a tile layer, referenced by the Properties of its features */
+struct PropertyDictionary {
+    std::vector<std::string> keys;
+    std::vector<Value> values;
+
+    // Approximate heap memory of the keys and values
+    size_t memoryUsage() const;
+};
+
 }
@@ -5,11 +5,26 @@
 #include "tileData.h"
 #include "tile/tile.h"
 #include "tile/tileTask.h"
+#include "util/asyncWorker.h"
 #include "util/geoJson.h"
 #include "platform.h"
 
+#include <array>
+
 namespace Tangram {
 
+constexpr size_t RasterSource::default_texture_cache_size;
+
+// Threads shared by all raster sources to decode images,
+// so that tile workers are not blocked by raster tiles.
+// Tasks for the same raster run in order, to decode it once.
+static void decodeAsync(const TileID& _tileID, std::function<void()> _decode) {
+    static std::array<AsyncWorker, 2> workers;
+
+    TileID id(_tileID.x, _tileID.y, _tileID.z);
+    workers[std::hash<TileID>()(id) % workers.size()].enqueue(std::move(_decode));
+}
+
 class RasterTileTask : public DownloadTileTask {
 public:
     RasterTileTask(TileID& _tileId, std::shared_ptr<DataSource> _source, int _subTask)
@@ -34,8 +49,8 @@ public:
         auto source = reinterpret_cast<RasterSource*>(m_source.get());
 
         if (!m_texture) {
-            // Decode texture data
-            m_texture = source->createTexture(*rawTileData);
+            // Decode texture data from the raw data cache
+            m_texture = source->decodeTexture(m_tileId, *rawTileData);
         }
 
         // Create tile geometries
@@ -70,8 +85,9 @@ public:
 
 
 RasterSource::RasterSource(const std::string& _name, const std::string& _urlTemplate, int32_t _maxZoom,
-                           TextureOptions _options, bool _genMipmap)
-    : DataSource(_name, _urlTemplate, _maxZoom), m_texOptions(_options), m_genMipmap(_genMipmap) {
+                           TextureOptions _options, bool _genMipmap, size_t _textureCacheSize)
+    : DataSource(_name, _urlTemplate, _maxZoom), m_texOptions(_options), m_genMipmap(_genMipmap),
+      m_textures(_textureCacheSize) {
 
     m_emptyTexture = std::make_shared<Texture>(nullptr, 0, m_texOptions, m_genMipmap);
 }
@@ -89,6 +105,24 @@ std::shared_ptr<Texture> RasterSource::createTexture(const std::vector<char>& _r
     return texture;
 }
 
+std::shared_ptr<Texture> RasterSource::decodeTexture(const TileID& _tileID,
+                                                     const std::vector<char>& _rawTileData) {
+    TileID id(_tileID.x, _tileID.y, _tileID.z);
+
+    std::shared_ptr<Texture> texture;
+    if (m_textures.get(id, [&](auto& cached) { texture = cached; })) {
+        return texture;
+    }
+
+    texture = createTexture(_rawTileData);
+
+    if (texture != m_emptyTexture) {
+        std::vector<std::shared_ptr<Texture>> evicted;
+        m_textures.put(id, texture, evicted, texture->bufferSize());
+    }
+    return texture;
+}
+
 std::shared_ptr<TileData> RasterSource::parse(const TileTask& _task, const MapProjection& _projection) const {
 
     std::shared_ptr<TileData> tileData = std::make_shared<TileData>();
@@ -117,9 +151,7 @@ std::shared_ptr<TileTask> RasterSource::createTask(TileID _tileId, int _subTask)
     {
         TileID id(_tileId.x, _tileId.y, _tileId.z);
 
-        auto texIt = m_textures.find(id);
-        if (texIt != m_textures.end()) {
-            task->m_texture = texIt->second;
+        if (m_textures.get(id, [&](auto& texture) { task->m_texture = texture; })) {
             return task;
         }
     }
@@ -130,37 +162,32 @@ std::shared_ptr<TileTask> RasterSource::createTask(TileID _tileId, int _subTask)
     return task;
 }
 
-void RasterSource::onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<TileTask>&& _task,
+void RasterSource::onTileLoaded(std::shared_ptr<std::vector<char>> _rawData, std::shared_ptr<TileTask>&& _task,
                                 TileTaskCb _cb) {
 
     if (_task->isCanceled()) { return; }
 
     TileID tileID = _task->tileId();
 
-    auto rawDataRef = std::make_shared<std::vector<char>>();
-    std::swap(*rawDataRef, _rawData);
-
     auto& task = static_cast<DownloadTileTask&>(*_task);
-    task.rawTileData = rawDataRef;
+    task.rawTileData = _rawData;
+
+    // The task holds a reference to this source until it is decoded
+    decodeAsync(tileID, [this, _cb, task = std::move(_task)]() mutable {
+        if (task->isCanceled()) { return; }
 
-    _cb.func(std::move(_task));
+        auto& rasterTask = static_cast<RasterTileTask&>(*task);
+        rasterTask.m_texture = decodeTexture(rasterTask.tileId(), *rasterTask.rawTileData);
 
-    cachePut(tileID, rawDataRef);
+        _cb.func(std::move(task));
+    });
 }
 
 bool RasterSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
 
-    std::string url(constructURL(_task->tileId()));
-
     auto copyTask = _task;
 
-    // lambda captured parameters are const by default, we want "task" (moved) to be non-const,
-    // hence "mutable"
-    // Refer: http://en.cppreference.com/w/cpp/language/lambda
-    bool status = startUrlRequest(url,
-            [this, _cb, task = std::move(_task)](std::vector<char>&& rawData) mutable {
-                this->onTileLoaded(std::move(rawData), std::move(task), _cb);
-            });
+    bool status = DataSource::loadTileData(std::move(_task), _cb);
 
     // For "dependent" raster datasources if this returns false make sure to create a black texture
     // for tileID in this task, and consider dependent raster ready
@@ -175,13 +202,16 @@ bool RasterSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _c
 Raster RasterSource::getRaster(const TileTask& _task) {
     TileID id(_task.tileId().x, _task.tileId().y, _task.tileId().z);
 
-    auto texIt = m_textures.find(id);
-    if (texIt != m_textures.end()) {
-        return { id, texIt->second };
+    std::shared_ptr<Texture> texture;
+    if (m_textures.get(id, [&](auto& cached) { texture = cached; })) {
+        return { id, texture };
     }
 
     auto& task = static_cast<const RasterTileTask&>(_task);
-    m_textures.emplace(id, task.m_texture);
+    if (task.m_texture != m_emptyTexture) {
+        std::vector<std::shared_ptr<Texture>> evicted;
+        m_textures.put(id, task.m_texture, evicted, task.m_texture->bufferSize());
+    }
 
     return { id, task.m_texture };
 }
@@ -191,7 +221,8 @@ void RasterSource::clearRasters() {
         raster->clearRasters();
     }
 
-    m_textures.clear();
+    std::vector<std::shared_ptr<Texture>> evicted;
+    m_textures.clear(evicted);
 }
 
 void RasterSource::clearRaster(const TileID &tileID) {
@@ -202,13 +233,8 @@ void RasterSource::clearRaster(const TileID &tileID) {
         raster->clearRaster(rasterID);
     }
 
-    auto rasterID = id.withMaxSourceZoom(m_maxZoom);
-
-    // We do not want to delete the texture reference from the
-    // DS if any of the tiles is still using this as a reference
-    if (m_textures[rasterID].use_count() <= 1) {
-        m_textures.erase(rasterID);
-    }
+    // Textures of this source stay in the LRU cache, for tiles that
+    // map to the same raster or come back into view
 }
 
 }
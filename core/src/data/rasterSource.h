@@ -5,9 +5,9 @@
 #include "tile/tileHash.h"
 #include "dataSource.h"
 #include "gl/texture.h"
+#include "util/lruCache.h"
 
 #include <functional>
-#include <unordered_map>
 #include <mutex>
 
 namespace Tangram {
@@ -18,7 +18,10 @@ class RasterSource : public DataSource {
 
     TextureOptions m_texOptions;
     bool m_genMipmap;
-    std::unordered_map<TileID, std::shared_ptr<Texture>> m_textures;
+
+    // Decoded textures by raster TileID, shared by all tiles that map to the same raster,
+    // weighted by their size in bytes. Tiles keep their textures alive after they were evicted.
+    ConcurrentLruCache<TileID, std::shared_ptr<Texture>> m_textures;
 
     std::shared_ptr<Texture> m_emptyTexture;
 
@@ -27,13 +30,17 @@ protected:
     virtual std::shared_ptr<TileData> parse(const TileTask& _task,
                                             const MapProjection& _projection) const override;
 
-    virtual void onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<TileTask>&& _task,
+    virtual void onTileLoaded(std::shared_ptr<std::vector<char>> _rawData, std::shared_ptr<TileTask>&& _task,
                               TileTaskCb _cb) override;
 
 public:
 
     RasterSource(const std::string& _name, const std::string& _urlTemplate, int32_t _maxZoom,
-                 TextureOptions _options, bool genMipmap = false);
+                 TextureOptions _options, bool genMipmap = false,
+                 size_t _textureCacheSize = default_texture_cache_size);
+
+    // Bytes of decoded textures kept for tiles that need them again
+    static constexpr size_t default_texture_cache_size = 32 * 1024 * 1024;
 
     virtual std::shared_ptr<TileTask> createTask(TileID _tile, int _subTask) override;
 
@@ -44,9 +51,13 @@ public:
     virtual void clearRasters() override;
     virtual void clearRaster(const TileID& id) override;
     virtual bool isRaster() const override { return true; }
+    virtual bool slicesOverzoomedTiles() const override { return false; }
 
     std::shared_ptr<Texture> createTexture(const std::vector<char>& _rawTileData);
 
+    /* Get the cached texture of the raster _tileID or decode it from _rawTileData */
+    std::shared_ptr<Texture> decodeTexture(const TileID& _tileID, const std::vector<char>& _rawTileData);
+
     Raster getRaster(const TileTask& _task);
 
 };
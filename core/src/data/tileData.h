@@ -3,6 +3,7 @@
 #include "glm/vec3.hpp"
 #include "data/properties.h"
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -80,6 +81,10 @@ struct Feature {
     std::vector<Polygon> polygons;
 
     Properties props;
+
+    // Identifier of the feature in its source, the same in all tiles that
+    // contain a part of the feature. Zero when the source has none.
+    uint64_t id = 0;
 };
 
 struct Layer {
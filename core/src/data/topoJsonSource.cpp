@@ -4,6 +4,7 @@
 #include "tile/tile.h"
 #include "tile/tileTask.h"
 #include "util/mapProjection.h"
+#include "util/geoJson.h"
 #include "util/topoJson.h"
 #include "platform.h"
 
@@ -32,18 +33,7 @@ std::shared_ptr<TileData> TopoJsonSource::parse(const TileTask& _task,
     }
 
     // Transform JSON data into a TileData using TopoJson functions
-    BoundingBox tileBounds(_projection.TileBounds(task.tileId()));
-    glm::dvec2 tileOrigin = {tileBounds.min.x, tileBounds.max.y*-1.0};
-    double tileInverseScale = 1.0 / tileBounds.width();
-
-    const auto projFn = [&](glm::dvec2 _lonLat){
-        glm::dvec2 tmp = _projection.LonLatToMeters(_lonLat);
-        return Point {
-            (tmp.x - tileOrigin.x) * tileInverseScale,
-            (tmp.y - tileOrigin.y) * tileInverseScale,
-             0
-        };
-    };
+    GeoJson::TileProjection projFn(_projection, task.tileId());
 
     // Parse topology and transform
     auto topology = TopoJson::getTopology(document, projFn);
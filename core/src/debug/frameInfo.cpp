@@ -2,6 +2,10 @@
 
 #include "tangram.h"
 #include "debug/textDisplay.h"
+#include "labels/labels.h"
+#include "labels/labelSet.h"
+#include "scene/scene.h"
+#include "text/fontContext.h"
 #include "tile/tileManager.h"
 #include "tile/tile.h"
 #include "tile/tileCache.h"
@@ -52,7 +56,8 @@ void FrameInfo::beginFrame() {
 }
 
 
-void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManager) {
+void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManager, const Scene& _scene,
+                     const Labels& _labels) {
 
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
         static int cpt = 0;
@@ -101,8 +106,20 @@ void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManag
         avgTimeUpdate /= 60;
 
         size_t memused = 0;
+        int culledTiles = 0;
+        int culledDraws = 0;
+        size_t tileLabels = 0;
         for (const auto& tile : _tileManager.getVisibleTiles()) {
             memused += tile->getMemoryUsage();
+
+            for (const auto& labelMesh : tile->getLabelMeshes()) {
+                tileLabels += labelMesh.labelSet->getLabels().size();
+            }
+
+            culledDraws += tile->getCulledMeshCount();
+            if (tile->getMeshCount() > 0 && tile->getCulledMeshCount() == tile->getMeshCount()) {
+                culledTiles++;
+            }
         }
 
         if (getDebugFlag(DebugFlags::tangram_infos)) {
@@ -110,9 +127,27 @@ void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManag
 
             debuginfos.push_back("visible tiles:"
                                  + std::to_string(_tileManager.getVisibleTiles().size()));
+            debuginfos.push_back("culled tiles:" + std::to_string(culledTiles));
+            debuginfos.push_back("culled draws:" + std::to_string(culledDraws));
+            debuginfos.push_back("tile labels:" + std::to_string(tileLabels));
+            debuginfos.push_back("collision candidates:" + std::to_string(_labels.collisionCandidates()));
+            debuginfos.push_back("merged labels:" + std::to_string(_labels.mergedLabels()));
+
+            const auto& fontContext = _scene.fontContext();
+            size_t layoutHits = fontContext->layoutCacheHits();
+            size_t layoutLookups = layoutHits + fontContext->layoutCacheMisses();
+            debuginfos.push_back("text layout cache hits:" + std::to_string(layoutHits) + "/"
+                                 + std::to_string(layoutLookups));
             debuginfos.push_back("tile cache size:"
                                  + std::to_string(_tileManager.getTileCache()->getMemoryUsage() / 1024) + "kb");
             debuginfos.push_back("tile size:" + std::to_string(memused / 1024) + "kb");
+            const auto& loading = _tileManager.getLoadingMemory();
+            debuginfos.push_back("loading memory:" + std::to_string(loading.rawData / 1024) + "/"
+                                 + std::to_string(loading.tileData / 1024) + "/"
+                                 + std::to_string(loading.meshes / 1024) + "kb");
+            const auto& prefetch = _tileManager.getPrefetchStats();
+            debuginfos.push_back("prefetch hits:" + std::to_string(prefetch.hits) + "/"
+                                 + std::to_string(prefetch.requested));
             debuginfos.push_back("avg frame cpu time:" + to_string_with_precision(avgTimeCpu, 2) + "ms");
             debuginfos.push_back("avg frame render time:" + to_string_with_precision(avgTimeRender, 2) + "ms");
             debuginfos.push_back("avg frame update time:" + to_string_with_precision(avgTimeUpdate, 2) + "ms");
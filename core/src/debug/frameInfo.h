@@ -2,7 +2,9 @@
 
 namespace Tangram {
 
+class Labels;
 class RenderState;
+class Scene;
 class TileManager;
 class View;
 
@@ -13,7 +15,8 @@ struct FrameInfo {
 
     static void endUpdate();
 
-    static void draw(RenderState& rs, const View& _view, TileManager& _tileManager);
+    static void draw(RenderState& rs, const View& _view, TileManager& _tileManager, const Scene& _scene,
+                     const Labels& _labels);
 };
 
 }
@@ -110,6 +110,8 @@ typedef char            GLchar;
 #define GL_3_BYTES                      0x1408
 #define GL_4_BYTES                      0x1409
 #define GL_DOUBLE                       0x140A
+#define GL_UNSIGNED_SHORT_4_4_4_4       0x8033
+#define GL_UNSIGNED_SHORT_5_6_5         0x8363
 
 /* Primitives */
 #define GL_POINTS                       0x0000
@@ -252,6 +254,7 @@ typedef char            GLchar;
 #define GL_ELEMENT_ARRAY_BUFFER         0x8893
 #define GL_ARRAY_BUFFER_BINDING         0x8894
 #define GL_ELEMENT_ARRAY_BUFFER_BINDING 0x8895
+#define GL_STREAM_DRAW                  0x88E0
 #define GL_STATIC_DRAW                  0x88E4
 #define GL_DYNAMIC_DRAW                 0x88E8
 
@@ -262,6 +265,10 @@ typedef char            GLchar;
 #define GL_LINK_STATUS                  0x8B82
 #define GL_INFO_LOG_LENGTH              0x8B84
 
+// program binary
+#define GL_PROGRAM_BINARY_LENGTH_OES        0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS_OES   0x87FE
+
 // mapbuffer
 #define GL_READ_ONLY                    0x88B8
 #define GL_WRITE_ONLY                   0x88B9
@@ -269,6 +276,7 @@ typedef char            GLchar;
 
 #define GL_MAX_TEXTURE_SIZE             0x0D33
 #define GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS 0x8B4D
+#define GL_MAX_VERTEX_UNIFORM_VECTORS   0x8DFB
 
 #ifdef PLATFORM_ANDROID
 #define GL_APICALL  __attribute__((visibility("default")))
@@ -422,4 +430,14 @@ extern "C" {
     GL_APICALL void GL_APIENTRY glGenVertexArrays(GLsizei n, GLuint *arrays);
 #endif
 
+    // program binary (GL_OES_get_program_binary)
+    typedef void (GL_APIENTRY* PFNGLGETPROGRAMBINARYOESPROC) (GLuint program, GLsizei bufSize, GLsizei *length,
+                                                             GLenum *binaryFormat, GLvoid *binary);
+    typedef void (GL_APIENTRY* PFNGLPROGRAMBINARYOESPROC) (GLuint program, GLenum binaryFormat,
+                                                          const GLvoid *binary, GLint length);
+
+    // defined in gl/hardware.cpp, resolved by initGLExtensions() where available
+    extern PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESEXT;
+    extern PFNGLPROGRAMBINARYOESPROC glProgramBinaryOESEXT;
+
 };
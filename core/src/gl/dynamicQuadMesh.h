@@ -35,6 +35,7 @@ public:
 
     size_t numberOfVertices() const { return m_vertices.size(); }
 
+    // Must be called once per frame after RenderState::quadStream() has begun the frame
     void upload(RenderState& rs) override;
 
     bool isReady() { return m_isUploaded; }
@@ -42,6 +43,7 @@ public:
     // Reserves space for one quad and returns pointer
     // into m_vertices to write into 4 vertices.
     T* pushQuad() {
+        m_isUploaded = false;
         m_nVertices += 4;
         m_vertices.resize(m_nVertices);
         return &m_vertices[m_nVertices - 4];
@@ -49,33 +51,49 @@ public:
 
 private:
 
+    void stage(RenderState& rs);
+
     std::vector<T> m_vertices;
+
+    // Byte offset of this mesh's vertices in the current quad stream buffer
+    GLintptr m_streamOffset = 0;
+    // Quad stream frame holding the vertices at m_streamOffset
+    uint32_t m_streamFrame = 0;
 };
 
 template<class T>
-void DynamicQuadMesh<T>::upload(RenderState& rs) {
+void DynamicQuadMesh<T>::stage(RenderState& rs) {
+
+    // Stage the vertices into the frame's quad stream, all dynamic meshes
+    // of a frame are sent to the GPU with a single buffer upload
+    auto& stream = rs.quadStream();
+    m_streamOffset = stream.append(m_vertices.data(), m_nVertices * m_vertexLayout->getStride());
+    m_streamFrame = stream.frame();
 
-    if (m_nVertices == 0 || m_isUploaded) { return; }
+    m_isUploaded = true;
+}
 
-    MeshBase::checkValidity(rs);
+template<class T>
+void DynamicQuadMesh<T>::upload(RenderState& rs) {
 
-    // Generate vertex buffer, if needed
-    if (m_glVertexBuffer == 0) {
-        GL_CHECK(glGenBuffers(1, &m_glVertexBuffer));
-    }
+    if (m_nVertices == 0) { return; }
 
-    MeshBase::subDataUpload(rs, reinterpret_cast<GLbyte*>(m_vertices.data()));
+    // Unchanged vertices are still in the stream when no other mesh was staged since
+    if (m_isUploaded && m_streamFrame == rs.quadStream().frame()) { return; }
 
-    m_isUploaded = true;
+    stage(rs);
 }
 
 template<class T>
 bool DynamicQuadMesh<T>::draw(RenderState& rs, ShaderProgram& _shader) {
 
-    if (m_nVertices == 0) { return false; }
+    if (m_nVertices == 0 || !m_isUploaded) { return false; }
+
+    // Another mesh has started a new stream frame after this one was kept
+    if (m_streamFrame != rs.quadStream().frame()) { stage(rs); }
 
     // Bind buffers for drawing
-    rs.vertexBuffer(m_glVertexBuffer);
+    rs.quadStream().bind(rs);
     rs.indexBuffer(rs.getQuadIndexBuffer());
 
     // Enable shader program
@@ -92,7 +110,7 @@ bool DynamicQuadMesh<T>::draw(RenderState& rs, ShaderProgram& _shader) {
         if (offset + maxVertices > m_nVertices) {
             nVertices = m_nVertices - offset;
         }
-        size_t byteOffset = vertexOffset * m_vertexLayout->getStride();
+        size_t byteOffset = m_streamOffset + vertexOffset * m_vertexLayout->getStride();
 
         m_vertexLayout->enable(rs, _shader, byteOffset);
 
@@ -8,15 +8,21 @@
 #include "gl/error.h"
 #include "gl.h"
 
+PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESEXT = nullptr;
+PFNGLPROGRAMBINARYOESPROC glProgramBinaryOESEXT = nullptr;
+
 namespace Tangram {
 namespace Hardware {
 
 bool supportsMapBuffer = false;
 bool supportsVAOs = false;
 bool supportsTextureNPOT = false;
+bool supportsProgramBinary = false;
 
 uint32_t maxTextureSize = 0;
 uint32_t maxCombinedTextureUnits = 0;
+// Guaranteed by OpenGL ES 2.0 until the capabilities are loaded
+uint32_t maxVertexUniformVectors = 128;
 static char* s_glExtensions;
 
 bool isAvailable(std::string _extension) {
@@ -59,6 +65,14 @@ void loadExtensions() {
 
     // find extension symbols if needed
     initGLExtensions();
+
+    if (isAvailable("get_program_binary") && glGetProgramBinaryOESEXT && glProgramBinaryOESEXT) {
+        GLint formats = 0;
+        GL_CHECK(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &formats));
+        supportsProgramBinary = formats > 0;
+    }
+
+    LOG("Driver supports program binaries: %d", supportsProgramBinary);
 }
 
 void loadCapabilities() {
@@ -69,8 +83,12 @@ void loadCapabilities() {
     GL_CHECK(glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &val));
     maxCombinedTextureUnits = val;
 
+    GL_CHECK(glGetIntegerv(GL_MAX_VERTEX_UNIFORM_VECTORS, &val));
+    maxVertexUniformVectors = val;
+
     LOG("Hardware max texture size %d", maxTextureSize);
     LOG("Hardware max combined texture units %d", maxCombinedTextureUnits);
+    LOG("Hardware max vertex uniform vectors %d", maxVertexUniformVectors);
 }
 
 }
@@ -8,8 +8,10 @@ namespace Hardware {
 extern bool supportsMapBuffer;
 extern bool supportsVAOs;
 extern bool supportsTextureNPOT;
+extern bool supportsProgramBinary;
 extern uint32_t maxTextureSize;
 extern uint32_t maxCombinedTextureUnits;
+extern uint32_t maxVertexUniformVectors;
 
 void loadCapabilities();
 void loadExtensions();
@@ -5,8 +5,11 @@
 #include "platform.h"
 #include "gl/error.h"
 
+#include <atomic>
+
 namespace Tangram {
 
+static std::atomic<uint32_t> s_retainedMeshCount(0);
 
 MeshBase::MeshBase() {
     m_drawMode = GL_TRIANGLES;
@@ -138,8 +141,10 @@ void MeshBase::upload(RenderState& rs) {
     rs.vertexBuffer(m_glVertexBuffer);
     GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertexBytes, m_glVertexData, m_hint));
 
-    delete[] m_glVertexData;
-    m_glVertexData = nullptr;
+    if (!m_retainData) {
+        delete[] m_glVertexData;
+        m_glVertexData = nullptr;
+    }
 
     if (m_glIndexData) {
 
@@ -152,8 +157,10 @@ void MeshBase::upload(RenderState& rs) {
 
         GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_nIndices * sizeof(GLushort), m_glIndexData, m_hint));
 
-        delete[] m_glIndexData;
-        m_glIndexData = nullptr;
+        if (!m_retainData) {
+            delete[] m_glIndexData;
+            m_glIndexData = nullptr;
+        }
     }
 
     m_generation = rs.generation();
@@ -305,4 +312,10 @@ void MeshBase::setDirty(GLintptr _byteOffset, GLsizei _byteSize) {
     }
 }
 
+void MeshBase::setRetainData(bool _retain) {
+    m_retainData = _retain;
+    // Identifies the retained geometry for batches, unlike the address of the mesh
+    m_retainedId = _retain ? ++s_retainedMeshCount : 0;
+}
+
 }
@@ -104,6 +104,10 @@ protected:
     bool m_isCompiled;
     bool m_dirty;
 
+    // Keep compiled data after upload, to be merged into tile batches
+    bool m_retainData = false;
+    uint32_t m_retainedId = 0;
+
     GLsizei m_dirtySize;
     GLintptr m_dirtyOffset;
 
@@ -115,6 +119,8 @@ protected:
                           const std::vector<uint16_t>& _indices, size_t _offset);
 
     void setDirty(GLintptr _byteOffset, GLsizei _byteSize);
+
+    void setRetainData(bool _retain);
 };
 
 template<class T>
@@ -156,6 +162,36 @@ public:
         return MeshBase::draw(rs, shader);
     }
 
+    size_t pendingUploadSize() const override {
+        // Retained geometry goes to the GPU with the batch it is merged into
+        if (m_retainData) { return 0; }
+        return (m_isCompiled && !m_isUploaded) ? MeshBase::bufferSize() : 0;
+    }
+
+    void uploadPending(RenderState& rs) override {
+        if (m_isCompiled && !m_isUploaded) {
+            MeshBase::checkValidity(rs);
+            MeshBase::upload(rs);
+        }
+    }
+
+    bool retainedData(RetainedMeshData& _data) const override {
+        if (!m_retainData || !m_isCompiled || !m_glIndexData) { return false; }
+        _data.id = m_retainedId;
+        _data.vertices = m_glVertexData;
+        _data.nVertices = m_nVertices;
+        _data.indices = m_glIndexData;
+        _data.nIndices = m_nIndices;
+        _data.offsets = &m_vertexOffsets;
+        return true;
+    }
+
+    /*
+     * Keep the compiled geometry on the client side so that it can be merged
+     * with the meshes of other tiles, see <TileBatch>
+     */
+    void retainData() { setRetainData(true); }
+
     void compile(const std::vector<MeshData<T>>& _meshes);
 
     void compile(const MeshData<T>& _mesh);
@@ -38,6 +38,8 @@ GLuint RenderState::getTextureUnit(GLuint _unit) {
 RenderState::~RenderState() {
 
     deleteQuadIndexBuffer();
+    m_quadStream.dispose(*this);
+    m_shaderCache.dispose();
 
 }
 
@@ -70,6 +72,8 @@ void RenderState::invalidate() {
 
 void RenderState::increaseGeneration() {
     generateQuadIndexBuffer();
+    m_quadStream.invalidate();
+    m_shaderCache.invalidate();
     m_validGeneration++;
 }
 
@@ -2,6 +2,8 @@
 
 #include "gl.h"
 #include "gl/disposer.h"
+#include "gl/shaderCache.h"
+#include "gl/streamBuffer.h"
 #include "util/jobQueue.h"
 #include <array>
 
@@ -95,6 +97,12 @@ public:
 
     GLuint getQuadIndexBuffer();
 
+    // Per-frame batch of the dynamic quad vertices (labels, sprites)
+    StreamBuffer& quadStream() { return m_quadStream; }
+
+    // Linked shader programs shared by all ShaderPrograms of this context
+    ShaderCache& shaderCache() { return m_shaderCache; }
+
     std::array<GLuint, MAX_ATTRIBUTES> attributeBindings = { { 0 } };
 
     JobQueue jobQueue;
@@ -105,6 +113,8 @@ private:
     uint32_t m_nextTextureUnit = 0;
 
     GLuint m_quadIndexBuffer = 0;
+    StreamBuffer m_quadStream;
+    ShaderCache m_shaderCache;
     void deleteQuadIndexBuffer();
     void generateQuadIndexBuffer();
 
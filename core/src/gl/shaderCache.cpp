@@ -0,0 +1,233 @@
+#include "shaderCache.h"
+
+#include "platform.h"
+#include "gl/error.h"
+#include "gl/hardware.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace Tangram {
+
+constexpr size_t ShaderCache::MAX_UNUSED_PROGRAMS;
+
+// Header of the program binary files
+struct ProgramBinaryHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+static const char program_binary_magic[4] = { 'T', 'G', 'P', 'B' };
+constexpr uint32_t program_binary_version = 1;
+
+uint64_t ShaderCache::hash(const std::string& _vertSrc, const std::string& _fragSrc) {
+    // 64 bit FNV-1a, stable between runs so that it can name binary files
+    uint64_t h = 14695981039346656037ULL;
+
+    auto add = [&](const std::string& _src) {
+        for (unsigned char c : _src) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        // Separate the sources so that moving text between them changes the hash
+        h ^= 0xff;
+        h *= 1099511628211ULL;
+    };
+
+    add(_vertSrc);
+    add(_fragSrc);
+
+    return h;
+}
+
+ShaderCache::Program ShaderCache::acquire(const std::string& _vertSrc, const std::string& _fragSrc) {
+
+    uint64_t key = hash(_vertSrc, _fragSrc);
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        auto& entry = it->second;
+        if (entry.vertSrc == _vertSrc && entry.fragSrc == _fragSrc) {
+            entry.uses++;
+            m_hits++;
+            return entry.program;
+        }
+        // Hash collision, the program is built and not cached
+        m_misses++;
+        return {};
+    }
+
+    GLuint glProgram = loadBinary(key);
+    if (glProgram != 0) {
+        m_hits++;
+        auto& entry = m_entries[key];
+        entry.vertSrc = _vertSrc;
+        entry.fragSrc = _fragSrc;
+        entry.program.glProgram = glProgram;
+        entry.program.uniforms = std::make_shared<UniformCache>();
+        entry.uses = 1;
+        return entry.program;
+    }
+
+    m_misses++;
+    return {};
+}
+
+ShaderCache::Program ShaderCache::insert(const std::string& _vertSrc, const std::string& _fragSrc,
+                                         GLuint _glProgram) {
+
+    uint64_t key = hash(_vertSrc, _fragSrc);
+
+    Program program;
+    program.glProgram = _glProgram;
+    program.uniforms = std::make_shared<UniformCache>();
+
+    if (m_entries.find(key) != m_entries.end()) {
+        // Colliding with a different program, keep it out of the cache
+        return program;
+    }
+
+    auto& entry = m_entries[key];
+    entry.vertSrc = _vertSrc;
+    entry.fragSrc = _fragSrc;
+    entry.program = program;
+    entry.uses = 1;
+
+    storeBinary(key, _glProgram);
+
+    return program;
+}
+
+void ShaderCache::release(GLuint _glProgram) {
+
+    if (_glProgram == 0) { return; }
+
+    for (auto& it : m_entries) {
+        auto& entry = it.second;
+        if (entry.program.glProgram == _glProgram) {
+            if (--entry.uses == 0) {
+                entry.lastUse = ++m_useCounter;
+                evictUnused();
+            }
+            return;
+        }
+    }
+
+    // Not a cached program
+    GL_CHECK(glDeleteProgram(_glProgram));
+}
+
+void ShaderCache::evictUnused() {
+
+    size_t unused = 0;
+    for (auto& it : m_entries) {
+        if (it.second.uses == 0) { unused++; }
+    }
+
+    while (unused > MAX_UNUSED_PROGRAMS) {
+        auto oldest = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->second.uses == 0 &&
+                (oldest == m_entries.end() || it->second.lastUse < oldest->second.lastUse)) {
+                oldest = it;
+            }
+        }
+        GL_CHECK(glDeleteProgram(oldest->second.program.glProgram));
+        m_entries.erase(oldest);
+        unused--;
+    }
+}
+
+void ShaderCache::setBinaryDirectory(const std::string& _path) {
+    m_binaryDirectory = _path;
+}
+
+void ShaderCache::invalidate() {
+    m_entries.clear();
+}
+
+void ShaderCache::dispose() {
+    for (auto& it : m_entries) {
+        GL_CHECK(glDeleteProgram(it.second.program.glProgram));
+    }
+    m_entries.clear();
+}
+
+std::string ShaderCache::binaryPath(uint64_t _key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)_key);
+    return m_binaryDirectory + "/" + name;
+}
+
+GLuint ShaderCache::loadBinary(uint64_t _key) {
+
+    if (m_binaryDirectory.empty() || !Hardware::supportsProgramBinary) { return 0; }
+
+    std::ifstream file(binaryPath(_key), std::ios::binary);
+    if (!file.is_open()) { return 0; }
+
+    ProgramBinaryHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, program_binary_magic, sizeof(header.magic)) != 0 ||
+        header.version != program_binary_version ||
+        header.key != _key || header.length == 0) {
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), header.length)) { return 0; }
+
+    GLuint glProgram = glCreateProgram();
+    GL_CHECK();
+    GL_CHECK(glProgramBinaryOESEXT(glProgram, header.format, binary.data(), header.length));
+
+    GLint isLinked = GL_FALSE;
+    GL_CHECK(glGetProgramiv(glProgram, GL_LINK_STATUS, &isLinked));
+
+    if (isLinked == GL_FALSE) {
+        // Binaries are rejected e.g. after driver updates, build from source instead
+        LOGD("Discarding program binary %s", binaryPath(_key).c_str());
+        GL_CHECK(glDeleteProgram(glProgram));
+        return 0;
+    }
+
+    return glProgram;
+}
+
+void ShaderCache::storeBinary(uint64_t _key, GLuint _glProgram) {
+
+    if (m_binaryDirectory.empty() || !Hardware::supportsProgramBinary) { return; }
+
+    GLint length = 0;
+    GL_CHECK(glGetProgramiv(_glProgram, GL_PROGRAM_BINARY_LENGTH_OES, &length));
+    if (length <= 0) { return; }
+
+    std::vector<char> binary(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    GL_CHECK(glGetProgramBinaryOESEXT(_glProgram, length, &written, &format, binary.data()));
+    if (written <= 0) { return; }
+
+    ProgramBinaryHeader header;
+    std::memcpy(header.magic, program_binary_magic, sizeof(header.magic));
+    header.version = program_binary_version;
+    header.key = _key;
+    header.format = format;
+    header.length = written;
+
+    std::ofstream file(binaryPath(_key), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOGW("Cannot write program binary to %s", m_binaryDirectory.c_str());
+        return;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.data(), written);
+}
+
+}
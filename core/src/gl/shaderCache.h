@@ -0,0 +1,92 @@
+#pragma once
+
+#include "gl.h"
+#include "gl/uniform.h"
+#include "util/fastmap.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Tangram {
+
+using UniformCache = fastmap<GLint, UniformValue>;
+
+/*
+ * ShaderCache - Linked shader programs of one GL context keyed by the hash of
+ * their final vertex and fragment source. ShaderPrograms with identical source
+ * share one GL program, also across scene reloads: programs that are no longer
+ * used are kept until more than MAX_UNUSED_PROGRAMS accumulate. When the driver
+ * supports GL_OES_get_program_binary and a directory is set, program binaries
+ * are also stored on disk and loaded instead of compiling on the next start.
+ */
+class ShaderCache {
+
+public:
+
+    static constexpr size_t MAX_UNUSED_PROGRAMS = 32;
+
+    struct Program {
+        GLuint glProgram = 0;
+        // Uniform values last set on glProgram, shared by all users of the program
+        std::shared_ptr<UniformCache> uniforms;
+    };
+
+    ShaderCache() = default;
+
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    // Returns the program linked from the given source, or an empty Program when
+    // it must be built; a returned program must be given back with release()
+    Program acquire(const std::string& _vertSrc, const std::string& _fragSrc);
+
+    // Add a program that was just linked from the given source
+    Program insert(const std::string& _vertSrc, const std::string& _fragSrc, GLuint _glProgram);
+
+    // Drop one use of _glProgram
+    void release(GLuint _glProgram);
+
+    // Set the directory for program binaries, an empty path disables persistence
+    void setBinaryDirectory(const std::string& _path);
+
+    // Forget the GL handles, to be called when the GL context has been lost
+    void invalidate();
+
+    // Delete all cached GL programs
+    void dispose();
+
+    size_t size() const { return m_entries.size(); }
+
+    int hits() const { return m_hits; }
+    int misses() const { return m_misses; }
+
+private:
+
+    struct Entry {
+        std::string vertSrc;
+        std::string fragSrc;
+        Program program;
+        int uses = 0;
+        uint64_t lastUse = 0;
+    };
+
+    static uint64_t hash(const std::string& _vertSrc, const std::string& _fragSrc);
+
+    std::string binaryPath(uint64_t _key) const;
+    GLuint loadBinary(uint64_t _key);
+    void storeBinary(uint64_t _key, GLuint _glProgram);
+
+    void evictUnused();
+
+    std::unordered_map<uint64_t, Entry> m_entries;
+
+    std::string m_binaryDirectory;
+
+    uint64_t m_useCounter = 0;
+    int m_hits = 0;
+    int m_misses = 0;
+
+};
+
+}
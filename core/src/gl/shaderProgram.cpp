@@ -22,22 +22,11 @@ ShaderProgram::~ShaderProgram() {
 
     auto generation = m_generation;
     auto glProgram = m_glProgram;
-    auto glFragmentShader = m_glFragmentShader;
-    auto glVertexShader = m_glVertexShader;
 
     m_disposer([=](RenderState& rs) {
         if (rs.isValidGeneration(generation)) {
-            if (glProgram != 0) {
-                GL_CHECK(glDeleteProgram(glProgram));
-            }
-
-            if (glFragmentShader != 0) {
-                GL_CHECK(glDeleteShader(glFragmentShader));
-            }
-
-            if (glVertexShader != 0) {
-                GL_CHECK(glDeleteShader(glVertexShader));
-            }
+            // The program stays cached for other users and scene reloads
+            rs.shaderCache().release(glProgram);
         }
         // Deleting the shader program that is currently in-use sets the current shader program to 0
         // so we un-set the current program in the render state.
@@ -129,40 +118,49 @@ bool ShaderProgram::build(RenderState& rs) {
     auto vertSrc = applySourceBlocks(m_vertexShaderSource, false);
     auto fragSrc = applySourceBlocks(m_fragmentShaderSource, true);
 
-    // Try to compile vertex and fragment shaders, releasing resources and quiting on failure
+    // Share the program with other styles or previous scenes that use the same source
 
-    GLint vertexShader = makeCompiledShader(vertSrc, GL_VERTEX_SHADER);
+    auto& cache = rs.shaderCache();
+    auto program = cache.acquire(vertSrc, fragSrc);
 
-    if (vertexShader == 0) {
-        return false;
-    }
+    if (program.glProgram == 0) {
 
-    GLint fragmentShader = makeCompiledShader(fragSrc, GL_FRAGMENT_SHADER);
+        // Try to compile vertex and fragment shaders, releasing resources and quiting on failure
 
-    if (fragmentShader == 0) {
-        GL_CHECK(glDeleteShader(vertexShader));
-        return false;
-    }
+        GLint vertexShader = makeCompiledShader(vertSrc, GL_VERTEX_SHADER);
+
+        if (vertexShader == 0) {
+            return false;
+        }
+
+        GLint fragmentShader = makeCompiledShader(fragSrc, GL_FRAGMENT_SHADER);
 
-    // Try to link shaders into a program, releasing resources and quiting on failure
+        if (fragmentShader == 0) {
+            GL_CHECK(glDeleteShader(vertexShader));
+            return false;
+        }
 
-    GLint program = makeLinkedShaderProgram(fragmentShader, vertexShader);
+        // Try to link shaders into a program; the linked program keeps what it needs
+        // from the shaders, so these are released in any case
+
+        GLint glProgram = makeLinkedShaderProgram(fragmentShader, vertexShader);
 
-    if (program == 0) {
         GL_CHECK(glDeleteShader(vertexShader));
         GL_CHECK(glDeleteShader(fragmentShader));
-        return false;
+
+        if (glProgram == 0) {
+            return false;
+        }
+
+        program = cache.insert(vertSrc, fragSrc, glProgram);
     }
 
-    // Delete handles for old shaders and program; values of 0 are silently ignored
+    // Release the old program
 
-    GL_CHECK(glDeleteShader(m_glFragmentShader));
-    GL_CHECK(glDeleteShader(m_glVertexShader));
-    GL_CHECK(glDeleteProgram(m_glProgram));
+    cache.release(m_glProgram);
 
-    m_glFragmentShader = fragmentShader;
-    m_glVertexShader = vertexShader;
-    m_glProgram = program;
+    m_glProgram = program.glProgram;
+    m_uniformCache = program.uniforms;
 
     // Clear any cached shader locations
 
@@ -346,11 +344,9 @@ std::string ShaderProgram::applySourceBlocks(const std::string& source, bool fra
 void ShaderProgram::checkValidity(RenderState& rs) {
 
     if (!rs.isValidGeneration(m_generation)) {
-        m_glFragmentShader = 0;
-        m_glVertexShader = 0;
         m_glProgram = 0;
         m_needsBuild = true;
-        m_uniformCache.clear();
+        m_uniformCache = std::make_shared<UniformCache>();
     }
 }
 
@@ -501,6 +497,15 @@ void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, co
     }
 }
 
+void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, const UniformArray4f& _value) {
+    if (!use(rs)) { return; }
+    GLint location = getUniformLocation(_loc);
+    if (location >= 0) {
+        bool cached = getFromCache(location, _value);
+        if (!cached) { GL_CHECK(glUniform4fv(location, _value.size(), (float*)_value.data())); }
+    }
+}
+
 void ShaderProgram::setUniformi(RenderState& rs, const UniformLocation& _loc, const UniformTextureArray& _value) {
     if (!use(rs)) { return; }
     GLint location = getUniformLocation(_loc);
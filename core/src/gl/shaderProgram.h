@@ -2,6 +2,7 @@
 
 #include "gl.h"
 #include "gl/disposer.h"
+#include "gl/shaderCache.h"
 #include "uniform.h"
 #include "util/fastmap.h"
 
@@ -40,8 +41,6 @@ public:
 
     // Getters
     GLuint getGlProgram() const { return m_glProgram; };
-    GLuint getGlFragmentShader() const { return m_glFragmentShader; };
-    GLuint getGlVertexShader() const { return m_glVertexShader; };
 
     // Fetch the location of a shader attribute, caching the result.
     GLint getAttribLocation(const std::string& _attribName);
@@ -75,6 +74,7 @@ public:
     void setUniformf(RenderState& rs, const UniformLocation& _loc, const UniformArray1f& _value);
     void setUniformf(RenderState& rs, const UniformLocation& _loc, const UniformArray2f& _value);
     void setUniformf(RenderState& rs, const UniformLocation& _loc, const UniformArray3f& _value);
+    void setUniformf(RenderState& rs, const UniformLocation& _loc, const UniformArray4f& _value);
     void setUniformi(RenderState& rs, const UniformLocation& _loc, const UniformTextureArray& _value);
 
     // Ensure the program is bound and then set the named uniform to the values
@@ -106,7 +106,7 @@ private:
     // Get a uniform value from the cache, and returns false when it's a cache miss
     template <class T>
     inline bool getFromCache(GLint _location, T _value) {
-        auto& v = m_uniformCache[_location];
+        auto& v = (*m_uniformCache)[_location];
         if (v.is<T>()) {
             T& value = v.get<T>();
             if (value == _value) {
@@ -119,11 +119,11 @@ private:
 
     int m_generation = -1;
     GLuint m_glProgram = 0;
-    GLuint m_glFragmentShader = 0;
-    GLuint m_glVertexShader = 0;
 
     fastmap<std::string, GLint> m_attribMap;
-    fastmap<GLint, UniformValue> m_uniformCache;
+
+    // Shared with all ShaderPrograms that use the same GL program
+    std::shared_ptr<UniformCache> m_uniformCache = std::make_shared<UniformCache>();
 
     std::string m_fragmentShaderSource;
     std::string m_vertexShaderSource;
@@ -0,0 +1,106 @@
+#include "streamBuffer.h"
+
+#include "platform.h"
+#include "gl/error.h"
+#include "gl/hardware.h"
+#include "gl/renderState.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Keep vertex attribute offsets of the batched meshes aligned
+#define STREAM_BUFFER_ALIGNMENT 4
+
+namespace Tangram {
+
+void StreamBuffer::beginFrame() {
+
+    m_frameStarted = false;
+    m_uploadCount = 0;
+}
+
+GLintptr StreamBuffer::append(const GLvoid* _data, size_t _size) {
+
+    if (!m_frameStarted) {
+        m_current = (m_current + 1) % RING_SIZE;
+
+        m_staging.clear();
+        m_uploadedBytes = 0;
+        m_frame++;
+        m_frameStarted = true;
+    }
+
+    size_t offset = (m_staging.size() + STREAM_BUFFER_ALIGNMENT - 1) & ~(STREAM_BUFFER_ALIGNMENT - 1);
+
+    m_staging.resize(offset + _size);
+    std::memcpy(m_staging.data() + offset, _data, _size);
+
+    return offset;
+}
+
+void StreamBuffer::bind(RenderState& rs) {
+
+    if (m_uploadedBytes != m_staging.size()) {
+        upload(rs);
+    }
+
+    rs.vertexBuffer(m_glBuffers[m_current]);
+}
+
+void StreamBuffer::upload(RenderState& rs) {
+
+    GLuint& buffer = m_glBuffers[m_current];
+    size_t& capacity = m_capacity[m_current];
+    size_t bytes = m_staging.size();
+
+    if (buffer == 0) {
+        GL_CHECK(glGenBuffers(1, &buffer));
+    }
+
+    rs.vertexBuffer(buffer);
+
+    if (Hardware::supportsMapBuffer) {
+        // Orphan the data store, the driver can hand out fresh memory while
+        // draw calls of the previous frames still read from the old one
+        capacity = std::max(capacity, bytes);
+        GL_CHECK(glBufferData(GL_ARRAY_BUFFER, capacity, NULL, GL_STREAM_DRAW));
+
+        GLvoid* dataStore = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+        GL_CHECK();
+
+        if (dataStore) {
+            std::memcpy(dataStore, m_staging.data(), bytes);
+            GL_CHECK(glUnmapBuffer(GL_ARRAY_BUFFER));
+        } else {
+            GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_staging.data()));
+        }
+    } else {
+        // ES2 without mapbuffer: respecifying the whole store orphans it as well
+        capacity = bytes;
+        GL_CHECK(glBufferData(GL_ARRAY_BUFFER, bytes, m_staging.data(), GL_STREAM_DRAW));
+    }
+
+    m_uploadedBytes = bytes;
+    m_uploadCount++;
+}
+
+void StreamBuffer::invalidate() {
+
+    m_glBuffers.fill(0);
+    m_capacity.fill(0);
+    m_uploadedBytes = 0;
+}
+
+void StreamBuffer::dispose(RenderState& rs) {
+
+    for (auto& buffer : m_glBuffers) {
+        if (buffer) {
+            rs.vertexBufferUnset(buffer);
+            GL_CHECK(glDeleteBuffers(1, &buffer));
+        }
+    }
+
+    invalidate();
+}
+
+}
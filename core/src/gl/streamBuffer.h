@@ -0,0 +1,73 @@
+#pragma once
+
+#include "gl.h"
+
+#include <array>
+#include <vector>
+
+namespace Tangram {
+
+class RenderState;
+
+/*
+ * StreamBuffer - Collects the dynamic vertex data of one frame (label and
+ * marker quads) into a single staging area and uploads it with one buffer
+ * update. Frames cycle through a ring of buffers so that writing the next
+ * frame does not wait on the GPU still reading from the previous ones.
+ */
+class StreamBuffer {
+
+public:
+
+    static constexpr size_t RING_SIZE = 3;
+
+    StreamBuffer() = default;
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Start a frame. The ring moves to its next buffer and drops the staged data of the
+    // previous frame only once new data is appended, so that a frame in which no mesh
+    // changed draws from the buffer of the previous one without any upload.
+    void beginFrame();
+
+    // Stage _size bytes for upload, returns the byte offset of the data in the frame buffer
+    GLintptr append(const GLvoid* _data, size_t _size);
+
+    // Incremented whenever the staged data is dropped, offsets returned by append()
+    // remain valid while this is unchanged
+    uint32_t frame() const { return m_frame; }
+
+    // Bind the buffer of the current frame, uploading staged data first if needed
+    void bind(RenderState& rs);
+
+    // Forget the GL handles, to be called when the GL context has been lost
+    void invalidate();
+
+    // Release all OpenGL resources of the ring
+    void dispose(RenderState& rs);
+
+    size_t stagedBytes() const { return m_staging.size(); }
+
+    // Number of buffer uploads issued since the last beginFrame()
+    int uploadCount() const { return m_uploadCount; }
+
+private:
+
+    void upload(RenderState& rs);
+
+    std::vector<GLbyte> m_staging;
+
+    std::array<GLuint, RING_SIZE> m_glBuffers = { { 0 } };
+    std::array<size_t, RING_SIZE> m_capacity = { { 0 } };
+
+    size_t m_current = 0;
+    size_t m_uploadedBytes = 0;
+    int m_uploadCount = 0;
+
+    uint32_t m_frame = 0;
+    bool m_frameStarted = false;
+
+};
+
+}
@@ -61,9 +61,7 @@ bool Texture::loadImageFromMemory(const unsigned char* blob, unsigned int size)
     }
 
     if (pixels) {
-        resize(width, height);
-
-        setData(reinterpret_cast<GLuint*>(pixels), width * height);
+        setRGBAData(reinterpret_cast<GLuint*>(pixels), width, height);
 
         stbi_image_free(pixels);
 
@@ -79,6 +77,44 @@ bool Texture::loadImageFromMemory(const unsigned char* blob, unsigned int size)
     return false;
 }
 
+void Texture::setRGBAData(const GLuint* _pixels, unsigned int _width, unsigned int _height) {
+
+    if (m_options.type != GL_UNSIGNED_BYTE && (_width & 1)) {
+        // Rows of 16 bit pixels would not match the default unpack alignment
+        LOGW("Texture width is odd, keeping 32 bit pixels");
+        m_options.internalFormat = GL_RGBA;
+        m_options.format = GL_RGBA;
+        m_options.type = GL_UNSIGNED_BYTE;
+    }
+
+    resize(_width, _height);
+
+    size_t count = _width * _height;
+    auto rgba = reinterpret_cast<const unsigned char*>(_pixels);
+
+    switch (m_options.type) {
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_4_4_4_4: {
+        // Two pixels per GLuint
+        std::vector<GLuint> packed((count + 1) / 2, 0);
+        auto out = reinterpret_cast<uint16_t*>(packed.data());
+
+        for (size_t i = 0; i < count; i++) {
+            const unsigned char* p = &rgba[i * 4];
+            if (m_options.type == GL_UNSIGNED_SHORT_5_6_5) {
+                out[i] = ((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3);
+            } else {
+                out[i] = ((p[0] >> 4) << 12) | ((p[1] >> 4) << 8) | ((p[2] >> 4) << 4) | (p[3] >> 4);
+            }
+        }
+        setData(packed.data(), packed.size());
+        break;
+    }
+    default:
+        setData(_pixels, count);
+    }
+}
+
 Texture::Texture(Texture&& _other) {
     *this = std::move(_other);
 }
@@ -249,7 +285,7 @@ void Texture::update(RenderState& rs, GLuint _textureUnit, const GLuint* data) {
 
         GL_CHECK(glTexImage2D(m_target, 0, m_options.internalFormat,
                      m_width, m_height, 0, m_options.format,
-                     GL_UNSIGNED_BYTE, data));
+                     m_options.type, data));
 
         if (data && m_generateMipmaps) {
             // generate the mipmaps for this texture
@@ -265,7 +301,7 @@ void Texture::update(RenderState& rs, GLuint _textureUnit, const GLuint* data) {
     for (auto& range : m_dirtyRanges) {
         size_t offset =  (range.min * m_width) / divisor;
         GL_CHECK(glTexSubImage2D(m_target, 0, 0, range.min, m_width, range.max - range.min,
-                        m_options.format, GL_UNSIGNED_BYTE,
+                        m_options.format, m_options.type,
                         data + offset));
     }
     m_dirtyRanges.clear();
@@ -292,7 +328,11 @@ bool Texture::isRepeatWrapping(TextureWrapping _wrapping) {
     return _wrapping.wraps == GL_REPEAT || _wrapping.wrapt == GL_REPEAT;
 }
 
-size_t Texture::bytesPerPixel() {
+size_t Texture::bytesPerPixel() const {
+    if (m_options.type == GL_UNSIGNED_SHORT_5_6_5 ||
+        m_options.type == GL_UNSIGNED_SHORT_4_4_4_4) {
+        return 2;
+    }
     switch (m_options.internalFormat) {
         case GL_ALPHA:
         case GL_LUMINANCE:
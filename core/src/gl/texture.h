@@ -26,6 +26,9 @@ struct TextureOptions {
     GLenum format;
     TextureFiltering filtering;
     TextureWrapping wrapping;
+    // Pixel type of the texture data, GL_UNSIGNED_SHORT_5_6_5 (with GL_RGB) and
+    // GL_UNSIGNED_SHORT_4_4_4_4 (with GL_RGBA) store decoded images in 16 bits per pixel
+    GLenum type = GL_UNSIGNED_BYTE;
 };
 
 #define DEFAULT_TEXTURE_OPTION \
@@ -62,6 +65,9 @@ public:
     unsigned int getWidth() const { return m_width; }
     unsigned int getHeight() const { return m_height; }
 
+    /* Size of the pixels of the texture in bytes, in the pixel type of its options */
+    size_t bufferSize() const { return bytesPerPixel() * m_width * m_height; }
+
     void bind(RenderState& rs, GLuint _unit);
 
     void setDirty(size_t yOffset, size_t height);
@@ -94,6 +100,9 @@ protected:
     void generate(RenderState& rs, GLuint _textureUnit);
     void checkValidity(RenderState& rs);
 
+    /* Set the texture data from 32 bit RGBA pixels, converted to the pixel type of the options */
+    void setRGBAData(const GLuint* _pixels, unsigned int _width, unsigned int _height);
+
     TextureOptions m_options;
     std::vector<GLuint> m_data;
     GLuint m_glHandle;
@@ -117,7 +126,7 @@ protected:
 
 private:
 
-    size_t bytesPerPixel();
+    size_t bytesPerPixel() const;
 
     bool m_generateMipmaps;
 };
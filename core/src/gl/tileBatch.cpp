@@ -0,0 +1,122 @@
+#include "tileBatch.h"
+
+#include "gl/hardware.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Tangram {
+
+// Bytes appended to each vertex: tile index and padding
+constexpr GLint batch_index_size = 4;
+
+// Vertex uniform vectors left to the matrices, lights and material of a style
+constexpr uint32_t reserved_uniform_vectors = 80;
+
+// Uniform vectors per batched tile: transform and origin
+constexpr uint32_t tile_uniform_vectors = 2;
+
+constexpr size_t TileBatch::MAX_TILES;
+
+TileBatch::TileBatch(std::shared_ptr<VertexLayout> _batchLayout, GLenum _drawMode, size_t _maxTiles)
+    : MeshBase(_batchLayout, _drawMode, GL_STATIC_DRAW),
+      m_maxTiles(_maxTiles) {}
+
+size_t TileBatch::maxTiles() {
+    uint32_t vectors = Hardware::maxVertexUniformVectors;
+    if (vectors <= reserved_uniform_vectors + tile_uniform_vectors) { return 1; }
+
+    return std::min(MAX_TILES, size_t((vectors - reserved_uniform_vectors) / tile_uniform_vectors));
+}
+
+std::shared_ptr<VertexLayout> TileBatch::createLayout(const VertexLayout& _layout) {
+    auto attribs = _layout.getAttribs();
+    attribs.push_back({"a_batch_index", batch_index_size, GL_UNSIGNED_BYTE, false, 0});
+
+    return std::shared_ptr<VertexLayout>(new VertexLayout(attribs));
+}
+
+bool TileBatch::add(const RetainedMeshData& _mesh) {
+    if (m_meshIds.size() >= m_maxTiles) { return false; }
+
+    m_meshes.push_back(_mesh);
+    m_meshIds.push_back(_mesh.id);
+
+    return true;
+}
+
+bool TileBatch::holds(const RetainedMeshData* _meshes, size_t _count) const {
+    if (_count != m_meshIds.size()) { return false; }
+
+    for (size_t i = 0; i < _count; i++) {
+        if (_meshes[i].id != m_meshIds[i]) { return false; }
+    }
+    return true;
+}
+
+void TileBatch::compile() {
+
+    m_nVertices = 0;
+    m_nIndices = 0;
+
+    for (auto& mesh : m_meshes) {
+        m_nVertices += mesh.nVertices;
+        m_nIndices += mesh.nIndices;
+    }
+
+    GLint stride = m_vertexLayout->getStride();
+    GLint meshStride = stride - batch_index_size;
+
+    m_glVertexData = new GLbyte[m_nVertices * stride];
+    m_glIndexData = new GLushort[m_nIndices];
+
+    GLbyte* dstVertex = m_glVertexData;
+    GLushort* dstIndex = m_glIndexData;
+
+    m_vertexOffsets.clear();
+    m_vertexOffsets.emplace_back(0, 0);
+    size_t curVertices = 0;
+
+    for (size_t tile = 0; tile < m_meshes.size(); tile++) {
+        auto& mesh = m_meshes[tile];
+        const GLbyte* srcVertex = mesh.vertices;
+        const GLushort* srcIndex = mesh.indices;
+
+        // Indices of the mesh are relative to the start of its own batches
+        for (auto& o : *mesh.offsets) {
+            uint32_t nIndices = o.first;
+            uint32_t nVertices = o.second;
+
+            if (curVertices + nVertices > MAX_INDEX_VALUE) {
+                m_vertexOffsets.emplace_back(0, 0);
+                curVertices = 0;
+            }
+
+            for (uint32_t i = 0; i < nVertices; i++) {
+                std::memcpy(dstVertex, srcVertex, meshStride);
+                dstVertex += meshStride;
+                srcVertex += meshStride;
+
+                std::memset(dstVertex, 0, batch_index_size);
+                dstVertex[0] = GLbyte(tile);
+                dstVertex += batch_index_size;
+            }
+
+            for (uint32_t i = 0; i < nIndices; i++) {
+                *dstIndex++ = *srcIndex++ + curVertices;
+            }
+
+            auto& offset = m_vertexOffsets.back();
+            offset.first += nIndices;
+            offset.second += nVertices;
+
+            curVertices += nVertices;
+        }
+    }
+
+    m_meshes.clear();
+
+    m_isCompiled = true;
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "gl/mesh.h"
+
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * TileBatch - Merges the retained meshes of up to MAX_TILES tiles of one style
+ * into a single vertex and index buffer. Each vertex gets the index of its tile
+ * appended, the shader reads the tile transform from the u_batch_tiles uniform
+ * array at this index. The batch is drawn with one draw call for every 65535
+ * vertices instead of one draw call per tile.
+ */
+class TileBatch : public MeshBase {
+
+public:
+
+    static constexpr size_t MAX_TILES = 32;
+
+    /*
+     * Creates a batch for meshes of a style, _batchLayout is the vertex
+     * layout of the style followed by the a_batch_index attribute
+     */
+    TileBatch(std::shared_ptr<VertexLayout> _batchLayout, GLenum _drawMode,
+              size_t _maxTiles = MAX_TILES);
+
+    /* Number of tiles whose transforms fit into the vertex uniforms of the hardware,
+     * next to the other uniforms of a style; at most MAX_TILES */
+    static size_t maxTiles();
+
+    /* Returns the vertex layout of _layout extended by the tile index */
+    static std::shared_ptr<VertexLayout> createLayout(const VertexLayout& _layout);
+
+    /* Add the geometry of the next tile, returns false when the batch is full */
+    bool add(const RetainedMeshData& _mesh);
+
+    /* Merge all added geometry, added meshes are not referenced afterwards */
+    void compile();
+
+    /* Whether this batch was built from exactly the _count meshes starting at _meshes */
+    bool holds(const RetainedMeshData* _meshes, size_t _count) const;
+
+    size_t tileCount() const { return m_meshIds.size(); }
+
+private:
+
+    std::vector<RetainedMeshData> m_meshes;
+    std::vector<uint32_t> m_meshIds;
+
+    size_t m_maxTiles;
+
+};
+
+}
@@ -32,20 +32,30 @@ Label::~Label() {}
 
 bool Label::updateScreenTransform(const glm::mat4& _mvp, const glm::vec2& _screenSize, bool _drawAllLabels) {
 
-    glm::vec2 screenPosition;
-    bool clipped = false;
+    glm::vec4 clipPos1 = worldToClipSpace(_mvp, glm::vec4(m_transform.modelPosition1, 0.0, 1.0));
+    glm::vec4 clipPos2 = clipPos1;
+
+    if (m_type == Type::line) {
+        clipPos2 = worldToClipSpace(_mvp, glm::vec4(m_transform.modelPosition2, 0.0, 1.0));
+    }
+
+    return updateScreenTransform(clipPos1, clipPos2, _screenSize, _drawAllLabels);
+}
+
+bool Label::updateScreenTransform(const glm::vec4& _clipPos1, const glm::vec4& _clipPos2,
+                                  const glm::vec2& _screenSize, bool _drawAllLabels) {
+
+    // check whether the label is behind the camera using the
+    // perspective division factor
+    if (_clipPos1.w <= 0.0f) {
+        return false;
+    }
 
     switch (m_type) {
         case Type::debug:
         case Type::point:
         {
-            glm::vec2 p0 = m_transform.modelPosition1;
-
-            screenPosition = worldToScreenSpace(_mvp, glm::vec4(p0, 0.0, 1.0),
-                                                _screenSize, clipped);
-            if (clipped) {
-                return false;
-            }
+            glm::vec2 screenPosition = clipToScreenSpace(_clipPos1, _screenSize);
 
             m_transform.state.screenPos = screenPosition + m_options.offset;
 
@@ -53,22 +63,15 @@ bool Label::updateScreenTransform(const glm::mat4& _mvp, const glm::vec2& _scree
         }
         case Type::line:
         {
-            // project label position from mercator world space to screen
-            // coordinates
-            glm::vec2 p0 = m_transform.modelPosition1;
-            glm::vec2 p2 = m_transform.modelPosition2;
-
-            glm::vec2 ap0 = worldToScreenSpace(_mvp, glm::vec4(p0, 0.0, 1.0),
-                                               _screenSize, clipped);
-            glm::vec2 ap2 = worldToScreenSpace(_mvp, glm::vec4(p2, 0.0, 1.0),
-                                               _screenSize, clipped);
-
-            // check whether the label is behind the camera using the
-            // perspective division factor
-            if (clipped) {
+            if (_clipPos2.w <= 0.0f) {
                 return false;
             }
 
+            // project label position from mercator world space to screen
+            // coordinates
+            glm::vec2 ap0 = clipToScreenSpace(_clipPos1, _screenSize);
+            glm::vec2 ap2 = clipToScreenSpace(_clipPos2, _screenSize);
+
             float length = glm::length(ap2 - ap0);
 
             // default heuristic : allow label to be 30% wider than segment
@@ -78,13 +81,12 @@ bool Label::updateScreenTransform(const glm::mat4& _mvp, const glm::vec2& _scree
                 return false;
             }
 
-            glm::vec2 p1 = glm::vec2(p2 + p0) * 0.5f;
-
-            glm::vec2 ap1 = worldToScreenSpace(_mvp, glm::vec4(p1, 0.0, 1.0),
-                                               _screenSize, clipped);
+            // The projection is linear before the perspective division,
+            // the segment center in clip space is the mean of its ends
+            glm::vec2 ap1 = clipToScreenSpace((_clipPos1 + _clipPos2) * 0.5f, _screenSize);
 
             // Keep screen position center at world center (less sliding in tilted view)
-            screenPosition = ap1;
+            glm::vec2 screenPosition = ap1;
 
             glm::vec2 rotation = (ap0.x <= ap2.x ? ap2 - ap0 : ap0 - ap2) / length;
             rotation = glm::vec2{rotation.x, -rotation.y};
@@ -228,6 +230,19 @@ bool Label::setAnchorIndex(int _index) {
 
 bool Label::update(const glm::mat4& _mvp, const glm::vec2& _screenSize, float _zoomFract, bool _drawAllLabels) {
 
+    glm::vec4 clipPos1 = worldToClipSpace(_mvp, glm::vec4(m_transform.modelPosition1, 0.0, 1.0));
+    glm::vec4 clipPos2 = clipPos1;
+
+    if (m_type == Type::line) {
+        clipPos2 = worldToClipSpace(_mvp, glm::vec4(m_transform.modelPosition2, 0.0, 1.0));
+    }
+
+    return update(clipPos1, clipPos2, _screenSize, _zoomFract, _drawAllLabels);
+}
+
+bool Label::update(const glm::vec4& _clipPos1, const glm::vec4& _clipPos2, const glm::vec2& _screenSize,
+                   float _zoomFract, bool _drawAllLabels) {
+
     m_occludedLastFrame = m_occluded;
     m_occluded = false;
 
@@ -239,7 +254,7 @@ bool Label::update(const glm::mat4& _mvp, const glm::vec2& _screenSize, float _z
         }
     }
 
-    bool ruleSatisfied = updateScreenTransform(_mvp, _screenSize, _drawAllLabels);
+    bool ruleSatisfied = updateScreenTransform(_clipPos1, _clipPos2, _screenSize, _drawAllLabels);
 
     // one of the label rules has not been satisfied
     if (!ruleSatisfied) {
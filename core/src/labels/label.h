@@ -10,6 +10,7 @@
 #include "util/hash.h"
 #include "data/properties.h"
 #include "labels/labelProperty.h"
+#include "labels/labelArena.h"
 
 #include <string>
 #include <limits>
@@ -76,6 +77,11 @@ public:
         // the label hash based on its styling parameters
         size_t paramHash = 0;
 
+        // id of the labeled feature, to find its labels in neighbouring tiles
+        uint64_t featureId = 0;
+        // hash of the name of the layer of the feature, ids are only unique within it
+        size_t featureLayer = 0;
+
         LabelProperty::Anchors anchors;
         bool required = true;
     };
@@ -86,8 +92,18 @@ public:
 
     virtual ~Label();
 
+    // Labels are allocated from the LabelArena of their LabelSet, when given
+    static void* operator new(size_t _size) { return LabelArena::allocate(_size, nullptr); }
+    static void* operator new(size_t _size, LabelArena& _arena) { return LabelArena::allocate(_size, &_arena); }
+    static void operator delete(void* _ptr) { LabelArena::free(_ptr); }
+    static void operator delete(void* _ptr, LabelArena&) { LabelArena::free(_ptr); }
+
     bool update(const glm::mat4& _mvp, const glm::vec2& _screenSize, float _zoomFract, bool _drawAllLabels = false);
 
+    /* Update from the clip coordinates of the model positions, as projected for a whole LabelSet */
+    bool update(const glm::vec4& _clipPos1, const glm::vec4& _clipPos2, const glm::vec2& _screenSize,
+                float _zoomFract, bool _drawAllLabels = false);
+
     bool nextAnchor();
     bool setAnchorIndex(int _index);
     int anchorIndex() { return m_anchorIndex; }
@@ -100,6 +116,9 @@ public:
     /* Update the screen position of the label */
     bool updateScreenTransform(const glm::mat4& _mvp, const glm::vec2& _screenSize, bool _drawAllLabels);
 
+    bool updateScreenTransform(const glm::vec4& _clipPos1, const glm::vec4& _clipPos2,
+                               const glm::vec2& _screenSize, bool _drawAllLabels);
+
     virtual void updateBBoxes(float _zoomFract) = 0;
 
     /* Occlude the label */
@@ -128,6 +147,16 @@ public:
     bool isOccluded() const { return m_occluded; }
     bool occludedLastFrame() const { return m_occludedLastFrame; }
 
+    /* Zoom from which the label does not collide with labels of higher priority
+     * in its tile. Below it the label is occluded without further tests while
+     * minZoomLabel(), the label of its tile it collides with, is placed */
+    float minZoom() const { return m_minZoom; }
+    const Label* minZoomLabel() const { return m_minZoomLabel; }
+    void setMinZoom(float _zoom, const Label* _label) {
+        m_minZoom = _zoom;
+        m_minZoomLabel = _label;
+    }
+
     Label* parent() const { return m_parent; }
     void setParent(Label& parent, bool definePriority, bool defineCollide);
 
@@ -177,6 +206,9 @@ protected:
 
     Label* m_parent;
 
+    float m_minZoom = 0.f;
+    const Label* m_minZoomLabel = nullptr;
+
 };
 
 }
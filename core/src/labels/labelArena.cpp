@@ -0,0 +1,55 @@
+#include "labelArena.h"
+
+#include <algorithm>
+#include <new>
+
+namespace Tangram {
+
+constexpr size_t LabelArena::min_block_size;
+constexpr size_t LabelArena::max_block_size;
+
+// Allocations are aligned like memory returned by operator new. Each one is preceded
+// by a header that holds its arena, or null for memory from the heap.
+static constexpr size_t alignment = alignof(std::max_align_t);
+static constexpr size_t header_size = alignment;
+
+static size_t alignedSize(size_t _size) {
+    return (_size + alignment - 1) / alignment * alignment;
+}
+
+void* LabelArena::allocate(size_t _size, LabelArena* _arena) {
+    size_t size = header_size + alignedSize(_size);
+
+    char* base = static_cast<char*>(_arena ? _arena->allocate(size) : ::operator new(size));
+    *reinterpret_cast<LabelArena**>(base) = _arena;
+
+    return base + header_size;
+}
+
+void LabelArena::free(void* _ptr) {
+    if (!_ptr) { return; }
+
+    char* base = static_cast<char*>(_ptr) - header_size;
+
+    // Memory of an arena is released with the arena
+    if (!*reinterpret_cast<LabelArena**>(base)) {
+        ::operator delete(base);
+    }
+}
+
+void* LabelArena::allocate(size_t _size) {
+
+    if (m_blocks.empty() || m_blockUsed + _size > m_blockSize) {
+        // Grow the blocks with the number of labels, starting small for tiles with few
+        m_blockSize = std::max(_size, std::min(max_block_size, std::max(min_block_size, m_blockSize * 2)));
+        m_blocks.emplace_back(new char[m_blockSize]);
+        m_blockUsed = 0;
+        m_memoryUsage += m_blockSize;
+    }
+
+    void* ptr = m_blocks.back().get() + m_blockUsed;
+    m_blockUsed += _size;
+    return ptr;
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * LabelArena - Storage of the labels of one LabelSet, so that the labels of a tile,
+ * which are created one after the other, lie next to each other in memory and the
+ * per-frame passes over them touch fewer cache lines. Labels are appended to blocks
+ * that grow up to max_block_size; their memory is released all at once with the
+ * arena, when the LabelSets that hold its labels are released with their tile.
+ * An arena is filled by the one tile worker that builds its LabelSet.
+ */
+class LabelArena {
+
+public:
+
+    LabelArena() = default;
+    LabelArena(const LabelArena&) = delete;
+    LabelArena& operator=(const LabelArena&) = delete;
+
+    /* Allocate _size bytes from _arena, or from the heap when _arena is null */
+    static void* allocate(size_t _size, LabelArena* _arena);
+
+    /* Free memory returned by allocate(), a no-op for memory of an arena */
+    static void free(void* _ptr);
+
+    size_t memoryUsage() const { return m_memoryUsage; }
+
+    static constexpr size_t min_block_size = 4 * 1024;
+    static constexpr size_t max_block_size = 64 * 1024;
+
+private:
+
+    void* allocate(size_t _size);
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    size_t m_blockSize = 0;
+    size_t m_blockUsed = 0;
+    size_t m_memoryUsage = 0;
+};
+
+}
@@ -1,17 +1,25 @@
 #include "labelCollider.h"
 
 #include "labels/labelSet.h"
+#include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtx/norm.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #define MAX_SCALE 2
+// Minimum scale for which the zoom range of labels is determined
+#define MIN_SCALE 0.5
 
 namespace Tangram {
 
-void LabelCollider::setup(float _tileSize, float _tileScale) {
+void LabelCollider::setup(float _tileSize, float _tileScale, int _tileZoom) {
 
     // Maximum scale at which this tile is used (unless it's a proxy)
     m_tileScale = _tileScale * MAX_SCALE;
+    m_tileZoom = _tileZoom;
 
     m_screenSize = glm::vec2{ _tileSize * m_tileScale };
 }
@@ -25,9 +33,19 @@ void LabelCollider::addLabels(std::vector<std::unique_ptr<Label>>& _labels) {
     }
 }
 
+bool LabelCollider::isOwnedByTile(const Label& _label) {
+
+    glm::vec2 anchor = _label.transform().modelPosition1;
+    if (_label.type() == Label::Type::line) {
+        anchor = (anchor + _label.transform().modelPosition2) * 0.5f;
+    }
+
+    return isOwnedByTile(anchor);
+}
+
 void LabelCollider::handleRepeatGroup(size_t startPos) {
 
-    float threshold2 = pow(m_labels[startPos]->options().repeatDistance, 2);
+    float repeatDistance = m_labels[startPos]->options().repeatDistance;
     size_t repeatGroup = m_labels[startPos]->options().repeatGroup;
 
     // Get the range
@@ -39,25 +57,40 @@ void LabelCollider::handleRepeatGroup(size_t startPos) {
         if (m_labels[endPos+1]->options().repeatGroup != repeatGroup) { break; }
     }
 
+    // Labels are sorted by priority: keep each label that is not within the
+    // repeat distance of a label kept before
+    m_repeatGrid.reset(repeatDistance);
 
-    for (size_t i = startPos; i < endPos; i++) {
-        Label* l1 = m_labels[i];
-        if (l1->isOccluded()) { continue; }
-
-        for (size_t j = i+1; j <= endPos; j++) {
-            Label* l2 = m_labels[j];
-            if (l2->isOccluded()) { continue; }
+    for (size_t i = startPos; i <= endPos; i++) {
+        Label* l = m_labels[i];
+        if (l->isOccluded()) { continue; }
 
-            float d2 = distance2(l1->center(), l2->center());
-            if (d2 < threshold2) {
-                l2->occlude();
-            }
+        if (m_repeatGrid.withinDistance(l->center(), repeatDistance)) {
+            l->occlude();
+        } else {
+            m_repeatGrid.insert(l->center());
         }
     }
 }
 
 void LabelCollider::process() {
 
+    // Labels anchored in the buffer around the tile are built by the neighbour
+    // tile that contains the anchor
+    auto owned = std::partition(m_labels.begin(), m_labels.end(),
+                                [](auto* l) { return isOwnedByTile(*l); });
+
+    for (auto it = owned; it != m_labels.end(); ++it) {
+        Label* label = *it;
+        label->occlude();
+        label->enterState(Label::State::dead, 0.0f);
+
+        if (label->parent() && label->options().required) {
+            label->parent()->occlude();
+        }
+    }
+    m_labels.erase(owned, m_labels.end());
+
     // Sort labels so that all labels of one repeat group are next to each other
     std::sort(m_labels.begin(), m_labels.end(),
               [](auto* l1, auto* l2) {
@@ -89,10 +122,22 @@ void LabelCollider::process() {
     mvp[3][0] = -1;
     mvp[3][1] = 1;
 
+    // The screen positions of the labels move apart with the scale while their
+    // sizes remain: cover the boxes down to the minimum scale to also find the
+    // pairs that only collide when zoomed out
+    float minScaleRatio = MIN_SCALE / MAX_SCALE;
+
     for (auto* label : m_labels) {
         label->update(mvp, m_screenSize, 1, true);
+        label->setMinZoom(0.f, nullptr);
+
+        AABB aabb = label->aabb();
+        glm::vec2 offset = (aabb.min + aabb.max) * 0.5f * (minScaleRatio - 1.f);
 
-         m_aabbs.push_back(label->aabb());
+        aabb.min = glm::min(aabb.min, aabb.min + offset);
+        aabb.max = glm::max(aabb.max, aabb.max + offset);
+
+        m_aabbs.push_back(aabb);
     }
 
     m_isect2d.resize({m_screenSize.x / 128, m_screenSize.y / 128}, m_screenSize);
@@ -224,8 +269,55 @@ void LabelCollider::process() {
         }
     }
 
+    // Pairs that do not collide at the maximum scale still may when zoomed out,
+    // the label with lower priority is hidden until they are apart
+    for (auto& pair : m_isect2d.pairs) {
+
+        auto* l1 = m_labels[pair.first];
+        auto* l2 = m_labels[pair.second];
+
+        if (l1->isOccluded() || l2->isOccluded()) { continue; }
+        if (l1->parent() == l2 || l2->parent() == l1) { continue; }
+
+        float scale = separationScale(*l1, *l2);
+        if (scale <= minScaleRatio || scale >= 1.f) {
+            // Apart over the whole range, or intersecting boxes whose
+            // oriented boxes did not collide at the maximum scale
+            continue;
+        }
+
+        // Consistent with the narrow phase: the first of the pair has the
+        // higher priority, or otherwise the greater hash
+        Label* hidden = l2;
+        if (l1->options().priority == l2->options().priority && l1->hash() < l2->hash()) {
+            hidden = l1;
+        }
+
+        float minZoom = m_tileZoom + std::log2(scale * m_tileScale);
+        if (minZoom > hidden->minZoom()) {
+            hidden->setMinZoom(minZoom, hidden == l1 ? l2 : l1);
+        }
+    }
+
     m_labels.clear();
     m_aabbs.clear();
 }
 
+float LabelCollider::separationScale(const Label& _l1, const Label& _l2) {
+
+    AABB a1 = _l1.aabb();
+    AABB a2 = _l2.aabb();
+
+    glm::vec2 distance = glm::abs((a1.min + a1.max) - (a2.min + a2.max)) * 0.5f;
+    glm::vec2 extent = ((a1.max - a1.min) + (a2.max - a2.min)) * 0.5f;
+
+    // The boxes overlap on an axis while the distance of their centers,
+    // which scales, is less than their combined half extent
+    float scale = std::numeric_limits<float>::infinity();
+    if (distance.x > 0.f) { scale = std::min(scale, extent.x / distance.x); }
+    if (distance.y > 0.f) { scale = std::min(scale, extent.y / distance.y); }
+
+    return scale;
+}
+
 }
@@ -2,6 +2,7 @@
 
 #include "isect2d.h"
 #include "glm_vec.h" // for isect2d.h
+#include "labels/repeatGrid.h"
 
 #include <memory>
 #include <vector>
@@ -14,16 +15,34 @@ class LabelCollider {
 
 public:
 
-    void setup(float _tileSize, float _tileScale);
+    void setup(float _tileSize, float _tileScale, int _tileZoom);
 
     void addLabels(std::vector<std::unique_ptr<Label>>& _labels);
 
+    /* Resolve the collisions at the maximum scale of the tile. The labels that
+     * survive get the zoom from which they do not collide with labels of higher
+     * priority in this tile, see Label::minZoom() */
     void process();
 
+    /* Whether the anchor of _label lies within the tile. Features that cross
+     * the tile border also produce labels in the buffer of the neighbour tiles,
+     * only the tile that contains the anchor keeps them. */
+    static bool isOwnedByTile(const Label& _label);
+
+    /* Whether a label anchored at _position in tile units is owned by the tile */
+    static bool isOwnedByTile(const glm::vec2& _position) {
+        // Half-open so that a label on a shared edge has exactly one owner
+        return _position.x >= 0.f && _position.x < 1.f &&
+               _position.y >= 0.f && _position.y < 1.f;
+    }
+
 private:
 
     void handleRepeatGroup(size_t startPos);
 
+    /* Fraction of the current scale below which the boxes of the labels overlap */
+    static float separationScale(const Label& _l1, const Label& _l2);
+
     using AABB = isect2d::AABB<glm::vec2>;
     using OBB = isect2d::OBB<glm::vec2>;
     using CollisionPairs = std::vector<isect2d::ISect2D<glm::vec2>::Pair>;
@@ -34,7 +53,10 @@ private:
 
     isect2d::ISect2D<glm::vec2> m_isect2d;
 
+    RepeatGrid m_repeatGrid;
+
     float m_tileScale = 1.f;
+    int m_tileZoom = 0;
 
     glm::vec2 m_screenSize;
 };
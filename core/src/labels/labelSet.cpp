@@ -1,5 +1,7 @@
 #include "labelSet.h"
 
+#include "util/geom.h"
+
 namespace Tangram {
 
 LabelSet::~LabelSet() {}
@@ -18,6 +20,76 @@ void LabelSet::setLabels(std::vector<std::unique_ptr<Label>>& _labels) {
                     std::move_iterator<iter_t>(_labels.end()));
 
     _labels.clear();
+
+    buildTransforms();
+}
+
+void LabelSet::takeLabels(LabelSet& _other) {
+    typedef std::vector<std::unique_ptr<Label>>::iterator iter_t;
+    m_labels.insert(m_labels.end(),
+                    std::move_iterator<iter_t>(_other.m_labels.begin()),
+                    std::move_iterator<iter_t>(_other.m_labels.end()));
+
+    _other.m_labels.clear();
+
+    m_arenas.insert(m_arenas.end(), _other.m_arenas.begin(), _other.m_arenas.end());
+}
+
+LabelArena& LabelSet::arena() {
+    // The own arena comes first, arenas of other sets are only appended
+    if (m_arenas.empty()) {
+        m_arenas.push_back(std::make_shared<LabelArena>());
+    }
+    return *m_arenas.front();
+}
+
+void LabelSet::buildTransforms() {
+    size_t count = m_labels.size();
+    auto& t = m_transforms;
+
+    t.x1.resize(count);
+    t.y1.resize(count);
+    t.x2.resize(count);
+    t.y2.resize(count);
+
+    for (size_t i = 0; i < count; i++) {
+        const auto& transform = m_labels[i]->transform();
+        t.x1[i] = transform.modelPosition1.x;
+        t.y1[i] = transform.modelPosition1.y;
+        t.x2[i] = transform.modelPosition2.x;
+        t.y2[i] = transform.modelPosition2.y;
+    }
+
+    t.clipX1.resize(count);
+    t.clipY1.resize(count);
+    t.clipW1.resize(count);
+    t.clipX2.resize(count);
+    t.clipY2.resize(count);
+    t.clipW2.resize(count);
+    t.updated.resize(count);
+}
+
+void LabelSet::updateTransforms(const glm::mat4& _mvp, const glm::vec2& _screenSize,
+                                float _zoomFract, bool _drawAllLabels) {
+
+    auto& t = m_transforms;
+    size_t count = m_labels.size();
+
+    // Labels may be added after setLabels()
+    if (t.x1.size() != count) { buildTransforms(); }
+
+    worldToClipSpace(_mvp, t.x1.data(), t.y1.data(), count,
+                     t.clipX1.data(), t.clipY1.data(), t.clipW1.data());
+
+    worldToClipSpace(_mvp, t.x2.data(), t.y2.data(), count,
+                     t.clipX2.data(), t.clipY2.data(), t.clipW2.data());
+
+    for (size_t i = 0; i < count; i++) {
+        glm::vec4 clipPos1(t.clipX1[i], t.clipY1[i], 0.f, t.clipW1[i]);
+        glm::vec4 clipPos2(t.clipX2[i], t.clipY2[i], 0.f, t.clipW2[i]);
+
+        t.updated[i] = m_labels[i]->update(clipPos1, clipPos2, _screenSize, _zoomFract, _drawAllLabels);
+    }
 }
 
 }
@@ -21,10 +21,40 @@ public:
 
     void setLabels(std::vector<std::unique_ptr<Label>>& _labels);
 
+    /* Move the labels of _other to the end of this set, together with their storage */
+    void takeLabels(LabelSet& _other);
+
+    /* Storage for the labels of this set, to be created with new (arena()) */
+    LabelArena& arena();
+
     void reset();
 
+    /* Project all labels with _mvp and update their screen transforms and bounding boxes.
+     * Only touches the labels of this set, so that sets can be updated concurrently.
+     */
+    void updateTransforms(const glm::mat4& _mvp, const glm::vec2& _screenSize,
+                          float _zoomFract, bool _drawAllLabels);
+
+    /* Result of Label::update() for the label at _index in the last updateTransforms() */
+    bool isUpdated(size_t _index) const { return m_transforms.updated[_index]; }
+
 protected:
+
+    void buildTransforms();
+
+    // Arenas of m_labels, declared first to release them after the labels
+    std::vector<std::shared_ptr<LabelArena>> m_arenas;
+
     std::vector<std::unique_ptr<Label>> m_labels;
+
+    // Model positions of the labels and their projection in clip space, as
+    // structure of arrays for the projection loop
+    struct {
+        std::vector<float> x1, y1, x2, y2;
+        std::vector<float> clipX1, clipY1, clipW1;
+        std::vector<float> clipX2, clipY2, clipW2;
+        std::vector<bool> updated;
+    } m_transforms;
 };
 
 }
@@ -13,17 +13,32 @@
 #include "labels/labelSet.h"
 #include "labels/textLabel.h"
 #include "marker/marker.h"
+#include "util/hash.h"
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtx/rotate_vector.hpp"
 #include "glm/gtx/norm.hpp"
 
+#include <algorithm>
+#include <thread>
+
 namespace Tangram {
 
+constexpr int Labels::max_coherent_frames;
+constexpr int Labels::retest_slices;
+constexpr float Labels::zoom_threshold;
+constexpr float Labels::angle_threshold;
+constexpr size_t Labels::parallel_update_min_labels;
+constexpr unsigned int Labels::max_update_workers;
+
 Labels::Labels()
     : m_needUpdate(false),
-      m_lastZoom(0.0f) {}
+      m_lastZoom(0.0f) {
+
+    unsigned int cores = std::thread::hardware_concurrency();
+    m_numUpdateWorkers = std::min(cores > 1 ? cores - 1 : 0u, max_update_workers);
+}
 
 Labels::~Labels() {}
 
@@ -31,17 +46,15 @@ Labels::~Labels() {}
 //     return (int) MIN(floor(((log(-_zoom + (_maxZoom + 2)) / log(_maxZoom + 2) * (_maxZoom )) * 0.5)), MAX_LOD);
 // }
 
-void Labels::processLabelUpdate(StyledMesh* mesh, Tile* tile,
-                               const glm::mat4& mvp, const glm::vec2& screen,
-                               float dt, float dz, bool drawAll,
-                               bool onlyTransitions, bool isProxy) {
+void Labels::processLabelUpdate(const LabelSet* labelMesh, Tile* tile, float dt,
+                                bool onlyTransitions, bool isProxy) {
+
+    const auto& labels = labelMesh->getLabels();
 
-    if (!mesh) { return; }
-    auto labelMesh = dynamic_cast<const LabelSet*>(mesh);
-    if (!labelMesh) { return; }
+    for (size_t i = 0; i < labels.size(); i++) {
+        auto& label = labels[i];
 
-    for (auto& label : labelMesh->getLabels()) {
-        if (!label->update(mvp, screen, dz, drawAll)) {
+        if (!labelMesh->isUpdated(i)) {
             // skip dead labels
             continue;
         }
@@ -62,6 +75,32 @@ void Labels::processLabelUpdate(StyledMesh* mesh, Tile* tile,
     }
 }
 
+void Labels::setUpdateWorkers(size_t _numWorkers) {
+    m_numUpdateWorkers = _numWorkers;
+    m_updateWorkers.reset();
+}
+
+void Labels::updateTransforms(const glm::vec2& _screenSize, float _dz, bool _drawAllLabels) {
+
+    size_t labelCount = 0;
+    for (auto& entry : m_labelSets) { labelCount += entry.labelSet->getLabels().size(); }
+
+    auto update = [&](size_t i) {
+        auto& entry = m_labelSets[i];
+        entry.labelSet->updateTransforms(entry.mvp, _screenSize, _dz, _drawAllLabels);
+    };
+
+    if (labelCount < parallel_update_min_labels || m_numUpdateWorkers == 0) {
+        for (size_t i = 0; i < m_labelSets.size(); i++) { update(i); }
+        return;
+    }
+
+    if (!m_updateWorkers) {
+        m_updateWorkers = std::make_unique<WorkerPool>(m_numUpdateWorkers);
+    }
+    m_updateWorkers->forEach(m_labelSets.size(), update);
+}
+
 void Labels::updateLabels(const View& _view, float _dt,
                           const std::vector<std::unique_ptr<Style>>& _styles,
                           const std::vector<std::shared_ptr<Tile>>& _tiles,
@@ -80,6 +119,11 @@ void Labels::updateLabels(const View& _view, float _dt,
 
     bool drawAllLabels = Tangram::getDebugFlag(DebugFlags::draw_all_labels);
 
+    // Project the labels of all meshes first, each mesh only touches its own labels
+    // so that this can run on the worker pool. Label states are evaluated afterwards
+    // on this thread, since labels push their vertices into meshes shared by a style.
+    m_labelSets.clear();
+
     for (const auto& tile : _tiles) {
 
         // discard based on level of detail
@@ -87,14 +131,8 @@ void Labels::updateLabels(const View& _view, float _dt,
         //     continue;
         // }
 
-        bool proxyTile = tile->isProxy();
-
-        glm::mat4 mvp = tile->mvp();
-
-        for (const auto& style : _styles) {
-            const auto& mesh = tile->getMesh(*style);
-            processLabelUpdate(mesh.get(), tile.get(), mvp, screenSize, _dt, dz,
-                               drawAllLabels, _onlyTransitions, proxyTile);
+        for (const auto& entry : tile->getLabelMeshes()) {
+            m_labelSets.push_back({ entry.labelSet, tile.get(), tile->mvp() });
         }
     }
 
@@ -106,21 +144,26 @@ void Labels::updateLabels(const View& _view, float _dt,
 
             if (marker->styleId() != style->getID()) { continue; }
 
-            const auto& mesh = marker->mesh();
-            processLabelUpdate(mesh, nullptr, mvp, screenSize, _dt, dz,
-                               drawAllLabels, _onlyTransitions, false);
+            auto labelSet = dynamic_cast<LabelSet*>(marker->mesh());
+            if (labelSet) { m_labelSets.push_back({ labelSet, nullptr, mvp }); }
         }
     }
+
+    updateTransforms(screenSize, dz, drawAllLabels);
+
+    for (auto& entry : m_labelSets) {
+        bool proxyTile = entry.tile && entry.tile->isProxy();
+        processLabelUpdate(entry.labelSet, entry.tile, _dt, _onlyTransitions, proxyTile);
+    }
 }
 
-void Labels::skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy) const {
+void Labels::skipTransitions(Tile& _tile, Tile& _proxy) const {
 
-    for (const auto& style : _styles) {
+    for (const auto& entry : _tile.getLabelMeshes()) {
 
-        auto* mesh0 = dynamic_cast<const LabelSet*>(_tile.getMesh(*style).get());
-        if (!mesh0) { continue; }
+        auto* mesh0 = entry.labelSet;
 
-        auto* mesh1 = dynamic_cast<const LabelSet*>(_proxy.getMesh(*style).get());
+        auto* mesh1 = _proxy.getLabelSet(entry.styleId);
         if (!mesh1) { continue; }
 
         for (auto& l0 : mesh0->getLabels()) {
@@ -166,15 +209,6 @@ void Labels::skipTransitions(const std::vector<std::unique_ptr<Style>>& _styles,
                              const std::vector<std::shared_ptr<Tile>>& _tiles,
                              TileCache& _cache, float _currentZoom) const {
 
-    std::vector<const Style*> styles;
-
-    for (const auto& style : _styles) {
-        if (dynamic_cast<const TextStyle*>(style.get()) ||
-            dynamic_cast<const PointStyle*>(style.get())) {
-            styles.push_back(style.get());
-        }
-    }
-
     for (const auto& tile : _tiles) {
         TileID tileID = tile->getID();
         std::shared_ptr<Tile> proxy;
@@ -182,20 +216,20 @@ void Labels::skipTransitions(const std::vector<std::unique_ptr<Style>>& _styles,
         if (m_lastZoom < _currentZoom) {
             // zooming in, add the one cached parent tile
             proxy = findProxy(tile->sourceID(), tileID.getParent(), _tiles, _cache);
-            if (proxy) { skipTransitions(styles, *tile, *proxy); }
+            if (proxy) { skipTransitions(*tile, *proxy); }
         } else {
             // zooming out, add the 4 cached children tiles
             proxy = findProxy(tile->sourceID(), tileID.getChild(0), _tiles, _cache);
-            if (proxy) { skipTransitions(styles, *tile, *proxy); }
+            if (proxy) { skipTransitions(*tile, *proxy); }
 
             proxy = findProxy(tile->sourceID(), tileID.getChild(1), _tiles, _cache);
-            if (proxy) { skipTransitions(styles, *tile, *proxy); }
+            if (proxy) { skipTransitions(*tile, *proxy); }
 
             proxy = findProxy(tile->sourceID(), tileID.getChild(2), _tiles, _cache);
-            if (proxy) { skipTransitions(styles, *tile, *proxy); }
+            if (proxy) { skipTransitions(*tile, *proxy); }
 
             proxy = findProxy(tile->sourceID(), tileID.getChild(3), _tiles, _cache);
-            if (proxy) { skipTransitions(styles, *tile, *proxy); }
+            if (proxy) { skipTransitions(*tile, *proxy); }
         }
     }
 }
@@ -249,37 +283,87 @@ void Labels::sortLabels() {
     std::sort(m_labels.begin(), m_labels.end(), Labels::labelComparator);
 }
 
-void Labels::handleOcclusions(const View& _view) {
+void Labels::mergeFeatureLabels() {
 
-    glm::vec2 screenSize = glm::vec2(_view.getWidth(), _view.getHeight());
-    float dz = _view.getZoom() - std::floor(_view.getZoom());
+    m_mergedLabels.clear();
+    m_featureOwners.clear();
 
-    m_isect2d.clear();
-    m_repeatGroups.clear();
+    auto featureKey = [](const LabelEntry& _entry) {
+        return FeatureKey{ _entry.label->options().featureId,
+                           _entry.label->options().featureLayer,
+                           _entry.tile->sourceID(),
+                           _entry.tile->getID().z };
+    };
 
-    for (auto& entry : m_labels){
-        auto* l = entry.label;
+    auto isMergeable = [](const LabelEntry& _entry) {
+        return _entry.tile && _entry.label->options().featureId != 0 &&
+            _entry.label->type() == Label::Type::point;
+    };
 
-        // Parent must have been processed earlier so at this point its
-        // occlusion and anchor position is determined for the current frame.
-        if (l->parent()) {
-            if (l->parent()->isOccluded()) {
-                l->occlude();
-                continue;
-            }
+    // Choose the tile that labels each feature: one that shows the label
+    // already, otherwise the first in TileID order to be stable between frames
+    for (auto& entry : m_labels) {
+        if (!isMergeable(entry)) { continue; }
+
+        bool visible = entry.label->visibleState();
+        auto it = m_featureOwners.emplace(featureKey(entry), FeatureOwner{ entry.tile, visible });
+        if (it.second) { continue; }
+
+        auto& owner = it.first->second;
+        if (owner.tile == entry.tile) {
+            owner.visible |= visible;
+        } else if (visible ? !owner.visible : (!owner.visible && entry.tile->getID() < owner.tile->getID())) {
+            owner = FeatureOwner{ entry.tile, visible };
         }
+    }
 
-        // Skip label if another label of this repeatGroup is
-        // within repeatDistance.
-        if (l->options().repeatDistance > 0.f) {
-            if (withinRepeatDistance(l)) {
-                l->occlude();
-                continue;
-            }
+    // Remove the labels of the other tiles from placement
+    auto it = std::stable_partition(m_labels.begin(), m_labels.end(),
+                                    [&](const LabelEntry& _entry) {
+        if (!isMergeable(_entry)) { return true; }
+        return m_featureOwners[featureKey(_entry)].tile == _entry.tile;
+    });
+
+    for (auto merged = it; merged != m_labels.end(); ++merged) {
+        merged->label->occlude();
+        m_mergedLabels.push_back(*merged);
+    }
+    m_labels.erase(it, m_labels.end());
+}
+
+bool Labels::placeLabel(Label* l, const glm::vec2& _screenSize, float _zoom,
+                        const std::unordered_set<const Label*>& _placedLabels) {
+
+    // Collides with a label of its own tile at this zoom, as long as that one is shown
+    bool belowMinZoom = _zoom < l->minZoom() && _placedLabels.count(l->minZoomLabel()) > 0;
+
+    float dz = _zoom - std::floor(_zoom);
+
+    // Parent must have been processed earlier so at this point its
+    // occlusion and anchor position is determined for the current frame.
+    if (l->parent()) {
+        if (l->parent()->isOccluded()) {
+            l->occlude();
+            return false;
         }
+    }
 
-        int anchorIndex = l->anchorIndex();
+    // Skip label if another label of this repeatGroup is
+    // within repeatDistance.
+    if (l->options().repeatDistance > 0.f) {
+        if (withinRepeatDistance(l)) {
+            l->occlude();
+            return false;
+        }
+    }
 
+    int anchorIndex = l->anchorIndex();
+    bool inViewport = false;
+
+    if (belowMinZoom) {
+        l->occlude();
+
+    } else {
         do {
             if (l->isOccluded()) {
                 // Update BBox for anchor fallback
@@ -290,8 +374,9 @@ void Labels::handleOcclusions(const View& _view) {
                 }
             }
 
-            if (l->offViewport(screenSize)) { continue; }
+            if (l->offViewport(_screenSize)) { continue; }
 
+            inViewport = true;
             l->occlude(false);
 
             // Skip label if it intersects with a previous label.
@@ -318,34 +403,165 @@ void Labels::handleOcclusions(const View& _view) {
 
             // Try next anchor
         } while (l->isOccluded() && l->nextAnchor());
+    }
 
-        // At this point, the label has a parent that is visible,
-        // if it is a required label, turn the parent to occluded
-        if (l->isOccluded()) {
-            if (l->parent() && l->options().required) {
-                l->parent()->occlude();
-            }
+    // At this point, the label has a parent that is visible,
+    // if it is a required label, turn the parent to occluded
+    if (l->isOccluded()) {
+        if (l->parent() && l->options().required) {
+            l->parent()->occlude();
         }
+    }
+
+    if (l->options().repeatDistance > 0.f) {
+        addToRepeatGroup(l);
+    }
+
+    return inViewport && !l->isOccluded();
+}
+
+void Labels::keepLabel(Label* l) {
+
+    auto aabb = l->aabb();
+    aabb.m_userData = static_cast<void*>(l);
+
+    // Insert without testing, the label was placed against the others before
+    m_isect2d.intersect(aabb, [](auto& a, auto& b) { return true; });
+
+    if (l->options().repeatDistance > 0.f) {
+        addToRepeatGroup(l);
+    }
+}
+
+void Labels::handleOcclusions(const View& _view) {
+
+    glm::vec2 screenSize = glm::vec2(_view.getWidth(), _view.getHeight());
+    float zoom = _view.getZoom();
+
+    m_isect2d.clear();
+    m_repeatGroups.clear();
+    m_placedLabels.clear();
 
-        if (l->options().repeatDistance > 0.f) {
-            m_repeatGroups[l->options().repeatGroup].push_back(l);
+    for (auto& entry : m_labels){
+        if (placeLabel(entry.label, screenSize, zoom, m_placedLabels)) {
+            m_placedLabels.insert(entry.label);
         }
     }
 }
 
-bool Labels::withinRepeatDistance(Label *_label) {
-    float threshold2 = pow(_label->options().repeatDistance, 2);
+void Labels::handleOcclusionsIncremental(const View& _view) {
 
-    auto it = m_repeatGroups.find(_label->options().repeatGroup);
-    if (it != m_repeatGroups.end()) {
-        for (auto* ll : it->second) {
-            float d2 = distance2(_label->center(), ll->center());
-            if (d2 < threshold2) {
-                return true;
+    glm::vec2 screenSize = glm::vec2(_view.getWidth(), _view.getHeight());
+    float zoom = _view.getZoom();
+
+    m_isect2d.clear();
+    m_repeatGroups.clear();
+    m_candidates.clear();
+
+    std::unordered_set<const Label*> placedLabels;
+    std::vector<Label*> keptLabels;
+
+    // Labels of tiles that were not placed on the last frame are all tested
+    std::unordered_set<const Tile*> lastTiles;
+    for (auto& tile : m_lastPlacement.tiles) {
+        if (auto t = tile.lock()) { lastTiles.insert(t.get()); }
+    }
+
+    for (size_t i = 0; i < m_labels.size(); i++) {
+        auto& entry = m_labels[i];
+        auto* l = entry.label;
+
+        if (entry.tile && lastTiles.count(entry.tile) == 0) {
+            m_candidates.push_back(entry);
+            continue;
+        }
+
+        bool wasPlaced = m_placedLabels.count(l) > 0;
+
+        if (wasPlaced && entry.tile && !l->offViewport(screenSize)) {
+            // Still in the viewport and moved together with the other labels
+            keepLabel(l);
+            placedLabels.insert(l);
+            keptLabels.push_back(l);
+
+        } else if (wasPlaced || !l->occludedLastFrame() || !entry.tile ||
+                   (i + m_coherentFrames) % retest_slices == 0) {
+            // Entering or leaving the viewport, labels of markers, and a
+            // slice of the occluded labels on each frame
+            m_candidates.push_back(entry);
+
+        } else {
+            l->occlude();
+        }
+    }
+
+    std::sort(m_candidates.begin(), m_candidates.end(), Labels::labelComparator);
+
+    for (auto& entry : m_candidates) {
+        if (placeLabel(entry.label, screenSize, zoom, placedLabels)) {
+            placedLabels.insert(entry.label);
+        }
+    }
+
+    // Kept labels were inserted before the candidates were placed: drop those
+    // whose parent got occluded since, or that a required child occluded.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto* l : keptLabels) {
+            if (!l->isOccluded() && l->parent() && l->parent()->isOccluded()) {
+                l->occlude();
+            }
+            if (l->isOccluded() && placedLabels.erase(l) > 0) {
+                changed = true;
             }
         }
     }
-    return false;
+
+    m_placedLabels = std::move(placedLabels);
+}
+
+bool Labels::canPlaceIncrementally(const View& _view) const {
+
+    const auto& last = m_lastPlacement;
+
+    if (!last.valid || m_coherentFrames >= max_coherent_frames) { return false; }
+
+    // Complete the placement as soon as the view comes to rest
+    if (!_view.changedOnLastUpdate()) { return false; }
+
+    if (last.width != _view.getWidth() || last.height != _view.getHeight()) { return false; }
+
+    // Labels keep their relative screen positions while the view only moves
+    if (std::abs(last.zoom - _view.getZoom()) > zoom_threshold ||
+        int(last.zoom) != int(_view.getZoom()) ||
+        std::abs(last.roll - _view.getRoll()) > angle_threshold ||
+        std::abs(last.pitch - _view.getPitch()) > angle_threshold) {
+        return false;
+    }
+
+    // Tiles may come and go, see handleOcclusionsIncremental()
+    return true;
+}
+
+bool Labels::withinRepeatDistance(Label *_label) {
+
+    auto it = m_repeatGroups.find(_label->options().repeatGroup);
+    if (it == m_repeatGroups.end()) { return false; }
+
+    return it->second.withinDistance(_label->center(), _label->options().repeatDistance);
+}
+
+void Labels::addToRepeatGroup(Label* _label) {
+
+    size_t group = _label->options().repeatGroup;
+
+    auto it = m_repeatGroups.find(group);
+    if (it == m_repeatGroups.end()) {
+        // Cells of the size of the repeat distance of the first label in this group
+        it = m_repeatGroups.emplace(group, RepeatGrid(_label->options().repeatDistance)).first;
+    }
+    it->second.insert(_label->center());
 }
 
 void Labels::updateLabelSet(const View& _view, float _dt,
@@ -357,19 +573,46 @@ void Labels::updateLabelSet(const View& _view, float _dt,
     /// Collect and update labels from visible tiles
     updateLabels(_view, _dt, _styles, _tiles, _markers, false);
 
-    sortLabels();
-
-    /// Mark labels to skip transitions
-
-    if (int(m_lastZoom) != int(_view.getZoom())) {
-        skipTransitions(_styles, _tiles, _cache, _view.getZoom());
-        m_lastZoom = _view.getZoom();
-    }
+    mergeFeatureLabels();
 
     m_isect2d.resize({_view.getWidth() / 256, _view.getHeight() / 256},
                      {_view.getWidth(), _view.getHeight()});
 
-    handleOcclusions(_view);
+    if (canPlaceIncrementally(_view)) {
+        /// Keep the placement of the last frame, place only changed labels
+
+        handleOcclusionsIncremental(_view);
+
+        m_coherentFrames++;
+
+        // Complete the placement on the next frame, even when the view stops
+        m_needPlacement = true;
+
+    } else {
+        sortLabels();
+
+        /// Mark labels to skip transitions
+
+        if (int(m_lastZoom) != int(_view.getZoom())) {
+            skipTransitions(_styles, _tiles, _cache, _view.getZoom());
+            m_lastZoom = _view.getZoom();
+        }
+
+        handleOcclusions(_view);
+
+        auto& last = m_lastPlacement;
+        last.valid = true;
+        last.zoom = _view.getZoom();
+        last.roll = _view.getRoll();
+        last.pitch = _view.getPitch();
+        last.width = _view.getWidth();
+        last.height = _view.getHeight();
+
+        m_coherentFrames = 0;
+        m_needPlacement = false;
+    }
+
+    m_lastPlacement.tiles.assign(_tiles.begin(), _tiles.end());
 
     /// Update label meshes
 
@@ -379,6 +622,13 @@ void Labels::updateLabelSet(const View& _view, float _dt,
         m_needUpdate |= label->evalState(_dt);
         label->pushTransform();
     }
+
+    for (auto& entry : m_mergedLabels) {
+        Label* label = entry.label;
+
+        m_needUpdate |= label->evalState(_dt);
+        label->pushTransform();
+    }
 }
 
 const std::vector<TouchItem>& Labels::getFeaturesAtPoint(const View& _view, float _dt,
@@ -402,14 +652,9 @@ const std::vector<TouchItem>& Labels::getFeaturesAtPoint(const View& _view, floa
 
         glm::mat4 mvp = tile->mvp();
 
-        for (const auto& style : _styles) {
-            const auto& mesh = tile->getMesh(*style);
-            if (!mesh) { continue; }
-
-            auto labelMesh = dynamic_cast<const LabelSet*>(mesh.get());
-            if (!labelMesh) { continue; }
+        for (const auto& entry : tile->getLabelMeshes()) {
 
-            for (auto& label : labelMesh->getLabels()) {
+            for (auto& label : entry.labelSet->getLabels()) {
 
                 auto& options = label->options();
                 if (!options.interactive) { continue; }
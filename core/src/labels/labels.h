@@ -2,16 +2,19 @@
 
 #include "label.h"
 #include "spriteLabel.h"
+#include "repeatGrid.h"
 #include "tile/tileID.h"
 #include "data/properties.h"
 #include "isect2d.h"
 #include "glm_vec.h" // for isect2d.h
+#include "util/workerPool.h"
 
 #include <memory>
 #include <mutex>
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <set>
 
 #define PERF_TRACE __attribute__ ((noinline))
@@ -19,6 +22,7 @@
 namespace Tangram {
 
 class FontContext;
+class LabelSet;
 class Marker;
 class Tile;
 class View;
@@ -54,6 +58,33 @@ public:
 
     bool needUpdate() const { return m_needUpdate; }
 
+    /* Whether the last updateLabelSet() only placed labels incrementally, to be
+     * followed by a complete placement even when the view does not change */
+    bool needPlacement() const { return m_needPlacement; }
+
+    // Number of frames the placement can be carried over while the view moves
+    static constexpr int max_coherent_frames = 30;
+    // Occluded labels are tested again in this many slices over the frames
+    static constexpr int retest_slices = 8;
+    // Changes of zoom and of rotation or tilt in radians that keep placement coherent
+    static constexpr float zoom_threshold = 0.02f;
+    static constexpr float angle_threshold = 0.01f;
+
+    /* Set the number of threads that help projecting labels in updateLabels(),
+     * zero projects all labels on the calling thread */
+    void setUpdateWorkers(size_t _numWorkers);
+
+    // Below this number of labels the projection is not worth to be distributed
+    static constexpr size_t parallel_update_min_labels = 512;
+    static constexpr unsigned int max_update_workers = 3;
+
+    /* Number of labels dropped on the last updateLabelSet() as their feature
+     * is already labeled by a neighbour tile */
+    size_t mergedLabels() const { return m_mergedLabels.size(); }
+
+    /* Number of labels tested for collisions on the last updateLabelSet() */
+    size_t collisionCandidates() const { return m_labels.size(); }
+
 protected:
 
     using AABB = isect2d::AABB<glm::vec2>;
@@ -65,17 +96,38 @@ protected:
                          const std::vector<std::shared_ptr<Tile>>& _tiles,
                          TileCache& _cache, float _currentZoom) const;
 
-    PERF_TRACE void skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy) const;
+    PERF_TRACE void skipTransitions(Tile& _tile, Tile& _proxy) const;
 
     PERF_TRACE void sortLabels();
 
+    /* Keep the point labels of each feature only from one tile, labels of
+     * polygons that are split across tiles are built in each of them */
+    PERF_TRACE void mergeFeatureLabels();
+
     PERF_TRACE void handleOcclusions(const View& _view);
 
+    /* Keep the labels placed on the last frame, test only those that changed
+     * and the labels of tiles that were added since */
+    PERF_TRACE void handleOcclusionsIncremental(const View& _view);
+
+    bool canPlaceIncrementally(const View& _view) const;
+
+    /* Test _label against the labels placed before, returns true when it was placed.
+     * _placedLabels holds the labels placed so far in this frame */
+    bool placeLabel(Label* _label, const glm::vec2& _screenSize, float _zoom,
+                    const std::unordered_set<const Label*>& _placedLabels);
+
+    /* Insert a label that was placed on the last frame */
+    void keepLabel(Label* _label);
+
     PERF_TRACE bool withinRepeatDistance(Label *_label);
 
-    void processLabelUpdate(StyledMesh* mesh, Tile* tile,
-                            const glm::mat4& mvp, const glm::vec2& screen,
-                            float dt, float dz, bool drawAll,
+    void addToRepeatGroup(Label* _label);
+
+    /* Project the labels of m_labelSets, on the update workers when there are enough */
+    PERF_TRACE void updateTransforms(const glm::vec2& _screenSize, float _dz, bool _drawAllLabels);
+
+    void processLabelUpdate(const LabelSet* labelMesh, Tile* tile, float dt,
                             bool onlyTransitions, bool isProxy);
 
     bool m_needUpdate;
@@ -102,7 +154,75 @@ protected:
 
     std::vector<LabelEntry> m_labels;
 
-    std::unordered_map<size_t, std::vector<Label*>> m_repeatGroups;
+    // Labels removed from m_labels by mergeFeatureLabels(), fading out
+    std::vector<LabelEntry> m_mergedLabels;
+
+    struct FeatureKey {
+        uint64_t featureId;
+        size_t layer;
+        int32_t sourceId;
+        int32_t zoom;
+
+        bool operator==(const FeatureKey& _other) const {
+            return featureId == _other.featureId && layer == _other.layer &&
+                sourceId == _other.sourceId && zoom == _other.zoom;
+        }
+    };
+
+    struct FeatureKeyHash {
+        size_t operator()(const FeatureKey& _key) const {
+            size_t seed = 0;
+            hash_combine(seed, _key.featureId);
+            hash_combine(seed, _key.layer);
+            hash_combine(seed, _key.sourceId);
+            hash_combine(seed, _key.zoom);
+            return seed;
+        }
+    };
+
+    struct FeatureOwner {
+        Tile* tile;
+        bool visible;
+    };
+    std::unordered_map<FeatureKey, FeatureOwner, FeatureKeyHash> m_featureOwners;
+
+    // Labels that are not occluded and within the viewport, from the last placement.
+    // Only used to compare with current labels, these may have been deleted meanwhile.
+    std::unordered_set<const Label*> m_placedLabels;
+
+    // Labels to be placed on an incremental update
+    std::vector<LabelEntry> m_candidates;
+
+    // View of the last complete placement and tiles of the last placement. Tiles are
+    // weak references, a new tile at the address of a released one is not mistaken for it.
+    struct {
+        bool valid = false;
+        float zoom = 0;
+        float roll = 0;
+        float pitch = 0;
+        float width = 0;
+        float height = 0;
+        std::vector<std::weak_ptr<Tile>> tiles;
+    } m_lastPlacement;
+
+    int m_coherentFrames = 0;
+    bool m_needPlacement = false;
+
+    // Positions of the placed labels of each repeat group
+    std::unordered_map<size_t, RepeatGrid> m_repeatGroups;
+
+    struct LabelSetEntry {
+        LabelSet* labelSet;
+        // Null for markers
+        Tile* tile;
+        glm::mat4 mvp;
+    };
+
+    // Label meshes of the current update with the matrix to project them
+    std::vector<LabelSetEntry> m_labelSets;
+
+    size_t m_numUpdateWorkers = 0;
+    std::unique_ptr<WorkerPool> m_updateWorkers;
 
     float m_lastZoom;
 };
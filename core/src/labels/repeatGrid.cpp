@@ -0,0 +1,54 @@
+#include "repeatGrid.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtx/norm.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Tangram {
+
+void RepeatGrid::reset(float _cellSize) {
+    // Guard against degenerate distances, these would put every position in its own cell
+    m_cellSize = std::max(_cellSize, 1.f);
+    m_invCellSize = 1.f / m_cellSize;
+    m_size = 0;
+    m_cells.clear();
+}
+
+int32_t RepeatGrid::cell(float _coord) const {
+    return int32_t(std::floor(_coord * m_invCellSize));
+}
+
+void RepeatGrid::insert(const glm::vec2& _position) {
+    m_cells[key(cell(_position.x), cell(_position.y))].push_back(_position);
+    m_size++;
+}
+
+bool RepeatGrid::withinDistance(const glm::vec2& _position, float _distance) const {
+    if (m_size == 0) { return false; }
+
+    float distance2 = _distance * _distance;
+
+    // Labels of one group usually share the repeat distance, then only the
+    // adjacent cells need to be checked
+    int32_t range = int32_t(std::ceil(_distance * m_invCellSize));
+    int32_t cx = cell(_position.x);
+    int32_t cy = cell(_position.y);
+
+    for (int32_t y = cy - range; y <= cy + range; y++) {
+        for (int32_t x = cx - range; x <= cx + range; x++) {
+            auto it = m_cells.find(key(x, y));
+            if (it == m_cells.end()) { continue; }
+
+            for (auto& p : it->second) {
+                if (glm::distance2(_position, p) < distance2) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+}
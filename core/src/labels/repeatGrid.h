@@ -0,0 +1,47 @@
+#pragma once
+
+#include "glm/vec2.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * RepeatGrid - Spatial hash of the label positions of one repeat group. Cells are
+ * as large as the repeat distance, so that a proximity query only has to look at
+ * the positions in the 3x3 cells around the queried one.
+ */
+class RepeatGrid {
+
+public:
+
+    explicit RepeatGrid(float _cellSize = 1.f) { reset(_cellSize); }
+
+    /* Remove all positions and set the cell size, usually the repeat distance */
+    void reset(float _cellSize);
+
+    void insert(const glm::vec2& _position);
+
+    /* Returns true when a position closer than _distance to _position was inserted */
+    bool withinDistance(const glm::vec2& _position, float _distance) const;
+
+    size_t size() const { return m_size; }
+
+private:
+
+    int32_t cell(float _coord) const;
+
+    static uint64_t key(int32_t _x, int32_t _y) {
+        return (uint64_t(uint32_t(_x)) << 32) | uint32_t(_y);
+    }
+
+    float m_cellSize = 1.f;
+    float m_invCellSize = 1.f;
+    size_t m_size = 0;
+
+    std::unordered_map<uint64_t, std::vector<glm::vec2>> m_cells;
+};
+
+}
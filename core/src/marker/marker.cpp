@@ -4,6 +4,7 @@
 #include "scene/scene.h"
 
 #include "style/style.h"
+#include "util/compactFeature.h"
 #include "view/view.h"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtx/transform.hpp"
@@ -22,7 +23,11 @@ void Marker::setBounds(BoundingBox bounds) {
 }
 
 void Marker::setFeature(std::unique_ptr<Feature> feature) {
-    m_feature = std::move(feature);
+    if (feature) {
+        m_feature = std::make_unique<CompactFeature>(*feature);
+    } else {
+        m_feature.reset();
+    }
 }
 
 void Marker::setStylingString(std::string stylingString) {
@@ -76,7 +81,7 @@ float Marker::extent() const {
     return glm::max(m_bounds.width(), m_bounds.height());
 }
 
-Feature* Marker::feature() const {
+const CompactFeature* Marker::feature() const {
     return m_feature.get();
 }
 
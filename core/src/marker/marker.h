@@ -10,6 +10,7 @@
 
 namespace Tangram {
 
+class CompactFeature;
 class MapProjection;
 class Scene;
 class View;
@@ -33,7 +34,8 @@ public:
     // maximum dimension (extent) of the bounds.
     void setBounds(BoundingBox bounds);
 
-    // Set the feature whose geometry will be used to build the marker.
+    // Set the feature whose geometry will be used to build the marker. The feature is kept
+    // in compact form and materialized when the marker is built.
     void setFeature(std::unique_ptr<Feature> feature);
 
     // Set the string of YAML that will be used to style the marker.
@@ -71,7 +73,7 @@ public:
 
     DrawRule* drawRule();
 
-    Feature* feature() const;
+    const CompactFeature* feature() const;
 
     const BoundingBox& bounds() const;
 
@@ -89,7 +91,7 @@ public:
 
 protected:
 
-    std::unique_ptr<Feature> m_feature;
+    std::unique_ptr<CompactFeature> m_feature;
     std::unique_ptr<StyledMesh> m_mesh;
     std::unique_ptr<DrawRuleData> m_drawRuleData;
     std::unique_ptr<DrawRule> m_drawRule;
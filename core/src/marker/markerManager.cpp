@@ -3,6 +3,7 @@
 #include "marker/marker.h"
 #include "scene/sceneLoader.h"
 #include "style/style.h"
+#include "util/compactFeature.h"
 
 namespace Tangram {
 
@@ -76,7 +77,7 @@ bool MarkerManager::setPoint(MarkerID markerID, LngLat lngLat) {
     if (!marker) { return false; }
 
     // If the marker does not have a 'point' feature mesh built, build it.
-    if (!marker->mesh() || !marker->feature() || marker->feature()->geometryType != GeometryType::points) {
+    if (!marker->mesh() || !marker->feature() || marker->feature()->geometryType() != GeometryType::points) {
         auto feature = std::make_unique<Feature>();
         feature->geometryType = GeometryType::points;
         feature->points.emplace_back();
@@ -96,7 +97,7 @@ bool MarkerManager::setPointEased(MarkerID markerID, LngLat lngLat, float durati
     if (!marker) { return false; }
 
     // If the marker does not have a 'point' feature built, set that point immediately.
-    if (!marker->mesh() || !marker->feature() || marker->feature()->geometryType != GeometryType::points) {
+    if (!marker->mesh() || !marker->feature() || marker->feature()->geometryType() != GeometryType::points) {
         return setPoint(markerID, lngLat);
     }
 
@@ -252,9 +253,9 @@ void MarkerManager::buildStyling(Marker& marker) {
 
 void MarkerManager::buildGeometry(Marker& marker, int zoom) {
 
-    auto feature = marker.feature();
+    auto compact = marker.feature();
     auto rule = marker.drawRule();
-    if (!feature || !rule) { return; }
+    if (!compact || !rule) { return; }
 
     StyleBuilder* styler = nullptr;
     {
@@ -274,7 +275,8 @@ void MarkerManager::buildGeometry(Marker& marker, int zoom) {
 
     if (valid) {
         styler->setup(marker, zoom);
-        styler->addFeature(*feature, *rule);
+        Feature feature = compact->feature();
+        styler->addFeature(feature, *rule);
         marker.setMesh(styler->style().getID(), zoom, styler->build());
     }
 
@@ -160,6 +160,8 @@ void DrawRuleMergeSet::apply(const Feature& _feature, const SceneLayer& _layer,
     // If no rules matched the feature, return immediately
     if (!match(_feature, _layer, _ctx)) { return; }
 
+    bool interactive = false;
+
     // For each matched rule, find the style to be used and
     // build the feature with the rule's parameters
     for (auto& rule : m_matchedRules) {
@@ -191,8 +193,17 @@ void DrawRuleMergeSet::apply(const Feature& _feature, const SceneLayer& _layer,
 
             // build feature with style
             style->addFeature(_feature, rule);
+
+            bool ruleInteractive = false;
+            if (rule.get(StyleParamKey::interactive, ruleInteractive)) {
+                interactive |= ruleInteractive;
+            }
         }
     }
+
+    if (interactive) {
+        _builder.addInteractiveFeature(_feature);
+    }
 }
 
 bool DrawRuleMergeSet::evaluateRuleForContext(DrawRule& rule, StyleContext& ctx) {
@@ -63,6 +63,9 @@ bool SceneLoader::loadScene(std::shared_ptr<Scene> _scene) {
         // Load font resources
         _scene->fontContext()->loadFonts();
 
+        // Build glyphs before tile workers need them
+        _scene->fontContext()->warmup();
+
         return true;
     }
     return false;
@@ -540,6 +543,23 @@ bool SceneLoader::extractTexFiltering(Node& filtering, TextureFiltering& filter)
     }
 }
 
+bool SceneLoader::extractTexFormat(Node& format, TextureOptions& options) {
+    const std::string& textureFormat = format.Scalar();
+    if (textureFormat == "rgba") {
+        options.internalFormat = options.format = GL_RGBA;
+        options.type = GL_UNSIGNED_BYTE;
+    } else if (textureFormat == "rgb565") {
+        options.internalFormat = options.format = GL_RGB;
+        options.type = GL_UNSIGNED_SHORT_5_6_5;
+    } else if (textureFormat == "rgba4444") {
+        options.internalFormat = options.format = GL_RGBA;
+        options.type = GL_UNSIGNED_SHORT_4_4_4_4;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 void SceneLoader::updateSpriteNodes(const std::string& texName,
         std::shared_ptr<Texture>& texture, const std::shared_ptr<Scene>& scene) {
     auto& spriteAtlases = scene->spriteAtlases();
@@ -768,6 +788,13 @@ void SceneLoader::loadStyleProps(Style& style, Node styleNode, const std::shared
         style.setTexCoordsGeneration(texcoordsNode.as<bool>());
     }
 
+    if (Node batchNode = styleNode["batch"]) {
+        bool batch;
+        if (getBool(batchNode, batch, "batch")) {
+            style.setBatching(batch);
+        }
+    }
+
     if (Node dashNode = styleNode["dash"]) {
         if (auto polylineStyle = dynamic_cast<PolylineStyle*>(&style)) {
             if (dashNode.IsSequence()) {
@@ -948,6 +975,12 @@ void SceneLoader::loadSource(const std::string& name, const Node& source, const
                 generateMipmaps = true;
             }
         }
+        // Decode into 16 bit textures to halve their memory
+        if (Node format = source["texture_format"]) {
+            if (!extractTexFormat(format, options)) {
+                LOGW("Unrecognized texture_format '%s' in source '%s'", format.Scalar().c_str(), name.c_str());
+            }
+        }
         sourcePtr = std::shared_ptr<DataSource>(new RasterSource(name, url, maxZoom, options, generateMipmaps));
     } else {
         LOGW("Unrecognized data source type '%s', skipping", type.c_str());
@@ -71,6 +71,7 @@ struct SceneLoader {
     static std::shared_ptr<Texture> fetchTexture(const std::string& name, const std::string& url,
             const TextureOptions& options, bool generateMipmaps, const std::shared_ptr<Scene>& scene);
     static bool extractTexFiltering(Node& filtering, TextureFiltering& filter);
+    static bool extractTexFormat(Node& format, TextureOptions& options);
 
     /*
      * Sprite nodes are created using a default 1x1 black texture when sprite atlas is requested over the network.
@@ -16,14 +16,8 @@ namespace Tangram {
 void IconMesh::setTextLabels(std::unique_ptr<StyledMesh> _textLabels) {
 
     auto* mesh = static_cast<TextLabels*>(_textLabels.get());
-    auto& labels = mesh->getLabels();
 
-    typedef std::vector<std::unique_ptr<Label>>::iterator iter_t;
-    m_labels.insert(m_labels.end(),
-                    std::move_iterator<iter_t>(labels.begin()),
-                    std::move_iterator<iter_t>(labels.end()));
-
-    labels.clear();
+    takeLabels(*mesh);
 
     textLabels = std::move(_textLabels);
 }
@@ -80,6 +74,9 @@ void PointStyleBuilder::setup(const Tile& _tile) {
     m_spriteLabels = std::make_unique<SpriteLabels>(m_style);
 
     m_textStyleBuilder->setup(_tile);
+
+    // Labels left from the last build are released before their storage
+    m_labels.clear();
     m_iconMesh = std::make_unique<IconMesh>();
 }
 
@@ -88,6 +85,8 @@ void PointStyleBuilder::setup(const Marker& _marker, int zoom) {
     m_spriteLabels = std::make_unique<SpriteLabels>(m_style);
 
     m_textStyleBuilder->setup(_marker, zoom);
+
+    m_labels.clear();
     m_iconMesh = std::make_unique<IconMesh>();
 }
 
@@ -151,6 +150,9 @@ auto PointStyleBuilder::applyRule(const DrawRule& _rule, const Properties& _prop
         p.labelOptions.properties = std::make_shared<Properties>(_props);
     }
 
+    p.labelOptions.featureId = m_featureId;
+    p.labelOptions.featureLayer = m_layer;
+
     std::hash<PointStyle::Parameters> hash;
     p.labelOptions.paramHash = hash(p);
 
@@ -160,12 +162,12 @@ auto PointStyleBuilder::applyRule(const DrawRule& _rule, const Properties& _prop
 void PointStyleBuilder::addLabel(const Point& _point, const glm::vec4& _quad,
                                  const PointStyle::Parameters& _params) {
 
-    m_labels.push_back(std::make_unique<SpriteLabel>(Label::Transform{glm::vec2(_point)},
-                                                     _params.size,
-                                                     _params.labelOptions,
-                                                     _params.extrudeScale,
-                                                     *m_spriteLabels,
-                                                     m_quads.size()));
+    m_labels.emplace_back(new (m_iconMesh->arena()) SpriteLabel(Label::Transform{glm::vec2(_point)},
+                                                                _params.size,
+                                                                _params.labelOptions,
+                                                                _params.extrudeScale,
+                                                                *m_spriteLabels,
+                                                                m_quads.size()));
 
     glm::i16vec2 size = _params.size * SpriteVertex::position_scale;
 
@@ -274,6 +276,7 @@ void PointStyleBuilder::addFeature(const Feature& _feat, const DrawRule& _rule)
 
     size_t iconsStart = m_labels.size();
 
+    m_featureId = _feat.id;
     StyleBuilder::addFeature(_feat, _rule);
 
     size_t iconsCount = m_labels.size() - iconsStart;
@@ -34,6 +34,11 @@ struct PointStyleBuilder : public StyleBuilder {
 
     const Style& style() const override { return m_style; }
 
+    void setLayer(size_t _layer) override {
+        StyleBuilder::setLayer(_layer);
+        m_textStyleBuilder->setLayer(_layer);
+    }
+
     PointStyleBuilder(const PointStyle& _style) : StyleBuilder(_style), m_style(_style) {
         m_textStyleBuilder = m_style.textStyle().createBuilder();
     }
@@ -50,12 +55,15 @@ struct PointStyleBuilder : public StyleBuilder {
     void addFeature(const Feature& _feat, const DrawRule& _rule) override;
 
 private:
+    // Holds the storage of m_labels, declared first to outlive them
+    std::unique_ptr<IconMesh> m_iconMesh;
+
     std::vector<std::unique_ptr<Label>> m_labels;
     std::vector<SpriteQuad> m_quads;
 
-    std::unique_ptr<IconMesh> m_iconMesh;
-
     float m_zoom = 0;
+    // Id of the feature whose labels are added
+    uint64_t m_featureId = 0;
     std::unique_ptr<SpriteLabels> m_spriteLabels;
     std::unique_ptr<StyleBuilder> m_textStyleBuilder;
 
@@ -96,12 +96,14 @@ public:
         m_tileUnitsPerMeter = _tile.getInverseScale();
         m_zoom = _tile.getID().z;
         m_meshData.clear();
+        m_bounds.clear();
     }
 
     void setup(const Marker& _marker, int zoom) override {
         m_zoom = zoom;
         m_tileUnitsPerMeter = 1.f / _marker.extent();
         m_meshData.clear();
+        m_bounds.clear();
     }
 
     void addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) override;
@@ -135,6 +137,8 @@ std::unique_ptr<StyledMesh> PolygonStyleBuilder<V>::build() {
 
     auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(),
                                                       m_style.drawMode());
+    if (m_style.isBatching()) { mesh->retainData(); }
+
     mesh->compile(m_meshData);
     m_meshData.clear();
 
@@ -166,6 +170,7 @@ void PolygonStyleBuilder<V>::addPolygon(const Polygon& _polygon, const Propertie
                                  const glm::vec3& normal,
                                  const glm::vec2& uv) {
         m_meshData.vertices.push_back({ coord, m_params.order, normal, uv, m_params.color });
+        if (!m_hasPositionShaderBlock) { m_bounds.expand(coord); }
     };
 
     if (m_params.minHeight != m_params.height) {
@@ -16,6 +16,7 @@ public:
     virtual void constructVertexLayout() override;
     virtual void constructShaderProgram() override;
     virtual std::unique_ptr<StyleBuilder> createBuilder() const override;
+    virtual bool supportsBatching() const override { return true; }
     virtual ~PolygonStyle() {}
 
 };
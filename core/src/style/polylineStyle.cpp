@@ -195,6 +195,9 @@ private:
     float m_tileUnitsPerPixel = 0;
     int m_zoom = 0;
     float m_overzoom2 = 1;
+
+    // Largest extrusion of the lines in m_bounds
+    float m_maxExtrusion = 0;
 };
 
 template <class V>
@@ -208,6 +211,9 @@ void PolylineStyleBuilder<V>::setup(const Tile& tile) {
     m_tileUnitsPerMeter = tile.getInverseScale();
     m_tileUnitsPerPixel = 1.f / tile.getProjection()->TileSize();
 
+    m_bounds.clear();
+    m_maxExtrusion = 0;
+
     // When a tile is overzoomed, we are actually styling the area of its
     // 'source' tile, which will have a larger effective pixel size at the
     // 'style' zoom level. This scaling is performed in the vertex shader to
@@ -227,6 +233,9 @@ void PolylineStyleBuilder<V>::setup(const Marker& marker, int zoom) {
     // by the ratio of the Marker's extent to the length of a tile side at this zoom.
     m_tileUnitsPerPixel = metersPerTile / (marker.extent() * 256.f);
 
+    m_bounds.clear();
+    m_maxExtrusion = 0;
+
 }
 
 template <class V>
@@ -237,6 +246,7 @@ std::unique_ptr<StyledMesh> PolylineStyleBuilder<V>::build() {
     }
 
     auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(), m_style.drawMode());
+    if (m_style.isBatching()) { mesh->retainData(); }
 
     bool painterMode = (m_style.blendMode() == Blending::overlay ||
                         m_style.blendMode() == Blending::inlay);
@@ -251,6 +261,9 @@ std::unique_ptr<StyledMesh> PolylineStyleBuilder<V>::build() {
 
     m_meshData[0].clear();
     m_meshData[1].clear();
+
+    m_bounds.inflate(glm::vec3(m_maxExtrusion, m_maxExtrusion, 0.f));
+
     return std::move(mesh);
 }
 
@@ -409,11 +422,22 @@ void PolylineStyleBuilder<V>::buildLine(const Line& _line, const typename Parame
                         MeshData<V>& _mesh) {
 
     float zoom = m_overzoom2;
+    float height = _att.height.x / position_scale;
+    bool trackBounds = !m_hasPositionShaderBlock;
+
     m_builder.addVertex = [&](const glm::vec3& coord, const glm::vec2& normal, const glm::vec2& uv) {
         _mesh.vertices.push_back({{ coord.x,coord.y }, normal, { uv.x, uv.y * zoom },
                                   _att.width, _att.height, _att.color});
+        if (trackBounds) { m_bounds.expand({ coord.x, coord.y, height }); }
     };
 
+    if (trackBounds) {
+        // Lines are extruded in the shader: use a coarse margin for miters, the
+        // interpolation with dwdz and drawing as proxy of the next lower zoom
+        float width = (std::abs(_att.width.x) + std::abs(_att.width.y)) / extrusion_scale;
+        m_maxExtrusion = std::max(m_maxExtrusion, width * std::max(_att.miterLimit, 1.f) * 4.f);
+    }
+
     Builders::buildPolyLine(_line, m_builder);
 
     _mesh.indices.insert(_mesh.indices.end(),
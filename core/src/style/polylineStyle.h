@@ -15,6 +15,7 @@ public:
     virtual void constructVertexLayout() override;
     virtual void constructShaderProgram() override;
     virtual std::unique_ptr<StyleBuilder> createBuilder() const override;
+    virtual bool supportsBatching() const override { return true; }
     virtual void onBeginDrawFrame(RenderState& rs, const View& _view, Scene& _scene) override;
     virtual ~PolylineStyle() {}
 
@@ -4,6 +4,7 @@
 #include "gl/renderState.h"
 #include "gl/shaderProgram.h"
 #include "gl/mesh.h"
+#include "gl/tileBatch.h"
 #include "scene/light.h"
 #include "scene/styleParam.h"
 #include "scene/drawRule.h"
@@ -17,6 +18,8 @@
 
 #include "shaders/rasters_glsl.h"
 
+#include <algorithm>
+
 namespace Tangram {
 
 Style::Style(std::string _name, Blending _blendMode, GLenum _drawMode) :
@@ -75,6 +78,21 @@ void Style::build(const Scene& _scene) {
     }
 
     setupRasters(_scene.dataSources());
+
+    // Tiles with rasters bind their own textures and are always drawn one by one
+    if (m_batching && supportsBatching() && !hasRasters()) {
+        m_batchLayout = TileBatch::createLayout(*m_vertexLayout);
+        m_batchTiles = TileBatch::maxTiles();
+        m_batchGroupLevels = 0;
+        while (size_t(4) << (2 * m_batchGroupLevels) <= m_batchTiles) {
+            m_batchGroupLevels++;
+        }
+        m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_BATCH_TILES "
+                + std::to_string(m_batchTiles) + "\n", false);
+    } else {
+        m_batchLayout.reset();
+    }
+    m_batches.clear();
 }
 
 void Style::setMaterial(const std::shared_ptr<Material>& _material) {
@@ -287,13 +305,20 @@ void Style::draw(RenderState& rs, const Tile& _tile) {
         m_shaderProgram->setUniformf(rs, m_uRasterOffsets, rasterOffsetsUniform);
     }
 
-    m_shaderProgram->setUniformMatrix4f(rs, m_uModel, _tile.getModelMatrix());
-    m_shaderProgram->setUniformf(rs, m_uProxyDepth, _tile.isProxy() ? 1.f : 0.f);
-    m_shaderProgram->setUniformf(rs, m_uTileOrigin,
-                                 _tile.getOrigin().x,
-                                 _tile.getOrigin().y,
-                                 tileID.s,
-                                 tileID.z);
+    if (m_batchLayout) {
+        // Meshes that could not be batched read their transform at tile index 0
+        UniformArray4f batchTiles;
+        addBatchTile(batchTiles, _tile);
+        m_shaderProgram->setUniformf(rs, m_uBatchTiles, batchTiles);
+    } else {
+        m_shaderProgram->setUniformMatrix4f(rs, m_uModel, _tile.getModelMatrix());
+        m_shaderProgram->setUniformf(rs, m_uProxyDepth, _tile.isProxy() ? 1.f : 0.f);
+        m_shaderProgram->setUniformf(rs, m_uTileOrigin,
+                                     _tile.getOrigin().x,
+                                     _tile.getOrigin().y,
+                                     tileID.s,
+                                     tileID.z);
+    }
 
     if (!styleMesh->draw(rs, *m_shaderProgram)) {
         LOGN("Mesh built by style %s cannot be drawn", m_name.c_str());
@@ -318,9 +343,18 @@ void Style::draw(RenderState& rs, const Marker& marker) {
 
     if (!marker.isVisible()) { return; }
 
-    m_shaderProgram->setUniformMatrix4f(rs, m_uModel, marker.modelMatrix());
-    m_shaderProgram->setUniformf(rs, m_uTileOrigin, marker.origin().x, marker.origin().y,
-                                 marker.builtZoomLevel(), marker.builtZoomLevel());
+    if (m_batchLayout) {
+        auto& model = marker.modelMatrix();
+        UniformArray4f batchTiles;
+        batchTiles.emplace_back(model[3][0], model[3][1], model[0][0], 0.f);
+        batchTiles.emplace_back(marker.origin().x, marker.origin().y,
+                                marker.builtZoomLevel(), marker.builtZoomLevel());
+        m_shaderProgram->setUniformf(rs, m_uBatchTiles, batchTiles);
+    } else {
+        m_shaderProgram->setUniformMatrix4f(rs, m_uModel, marker.modelMatrix());
+        m_shaderProgram->setUniformf(rs, m_uTileOrigin, marker.origin().x, marker.origin().y,
+                                     marker.builtZoomLevel(), marker.builtZoomLevel());
+    }
 
     if (!mesh->draw(rs, *m_shaderProgram)) {
         LOGN("Mesh built by style %s cannot be drawn", m_name.c_str());
@@ -328,6 +362,99 @@ void Style::draw(RenderState& rs, const Marker& marker) {
 
 }
 
+void Style::draw(RenderState& rs, const std::vector<std::shared_ptr<Tile>>& _tiles) {
+
+    if (!m_batchLayout) {
+        for (const auto& tile : _tiles) {
+            if (tile->isVisible(*this)) { draw(rs, *tile); }
+        }
+        return;
+    }
+
+    struct BatchedTile {
+        TileID group;
+        const Tile* tile;
+        RetainedMeshData mesh;
+    };
+    std::vector<BatchedTile> batched;
+
+    for (const auto& tile : _tiles) {
+        auto& styleMesh = tile->getMesh(*this);
+        if (!styleMesh) { continue; }
+
+        RetainedMeshData data;
+        if (styleMesh->retainedData(data)) {
+            TileID id = tile->getID();
+            TileID group(id.x >> m_batchGroupLevels, id.y >> m_batchGroupLevels, id.z, id.s, id.wrap);
+            batched.push_back({ group, tile.get(), data });
+        } else if (tile->isVisible(*this)) {
+            draw(rs, *tile);
+        }
+    }
+
+    // Order by group, then by tile, independent of the order of _tiles
+    std::sort(batched.begin(), batched.end(), [](const auto& a, const auto& b) {
+        if (a.group == b.group) { return a.tile->getID() < b.tile->getID(); }
+        return a.group < b.group;
+    });
+
+    decltype(m_batches) batches;
+    std::vector<RetainedMeshData> meshes;
+    UniformArray4f batchTiles;
+
+    for (size_t begin = 0; begin < batched.size();) {
+        size_t end = begin + 1;
+        while (end < batched.size() && batched[end].group == batched[begin].group) { end++; }
+
+        // A group holds at most m_batchTiles tiles
+        meshes.clear();
+        for (size_t j = begin; j < end; j++) { meshes.push_back(batched[j].mesh); }
+
+        // Merge the meshes again only when the tiles of this group have changed
+        auto& batch = batches[batched[begin].group];
+        auto it = m_batches.find(batched[begin].group);
+        if (it != m_batches.end() && it->second->holds(meshes.data(), meshes.size())) {
+            batch = std::move(it->second);
+        } else {
+            batch = std::make_unique<TileBatch>(m_batchLayout, m_drawMode, m_batchTiles);
+            for (auto& mesh : meshes) { batch->add(mesh); }
+            batch->compile();
+        }
+
+        // Batches are only culled as a whole to keep their tiles stable while panning
+        bool visible = false;
+        for (size_t j = begin; j < end; j++) {
+            if (batched[j].tile->isVisible(*this)) { visible = true; break; }
+        }
+
+        if (visible) {
+            batchTiles.clear();
+            for (size_t j = begin; j < end; j++) {
+                addBatchTile(batchTiles, *batched[j].tile);
+            }
+            m_shaderProgram->setUniformf(rs, m_uBatchTiles, batchTiles);
+
+            if (!batch->draw(rs, *m_shaderProgram)) {
+                LOGN("Tile batch of style %s cannot be drawn", m_name.c_str());
+            }
+        }
+
+        begin = end;
+    }
+
+    // Drop the batches of groups without tiles in this frame
+    m_batches.swap(batches);
+}
+
+void Style::addBatchTile(UniformArray4f& _batchTiles, const Tile& _tile) {
+    // Tile model matrices only scale uniformly and translate in the xy plane
+    auto& model = _tile.getModelMatrix();
+    TileID tileID = _tile.getID();
+
+    _batchTiles.emplace_back(model[3][0], model[3][1], model[0][0], _tile.isProxy() ? 1.f : 0.f);
+    _batchTiles.emplace_back(_tile.getOrigin().x, _tile.getOrigin().y, tileID.s, tileID.z);
+}
+
 bool StyleBuilder::checkRule(const DrawRule& _rule) const {
 
     uint32_t checkColor;
@@ -379,6 +506,9 @@ StyleBuilder::StyleBuilder(const Style& _style) {
         blocks.find("raster") != blocks.end()) {
         m_hasColorShaderBlock = true;
     }
+    // Vertices may be displaced in the shader, their bounds are unknown
+    m_hasPositionShaderBlock = (blocks.find("position") != blocks.end() ||
+                                blocks.find("width") != blocks.end());
 }
 
 void StyleBuilder::addPoint(const Point& _point, const Properties& _props, const DrawRule& _rule) {
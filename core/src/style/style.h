@@ -3,8 +3,11 @@
 #include "gl.h"
 #include "gl/uniform.h"
 #include "util/fastmap.h"
+#include "util/geom.h"
 #include "data/tileData.h"
+#include "tile/tileID.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +31,7 @@ class ShaderProgram;
 class Style;
 class DataSource;
 class RenderState;
+class TileBatch;
 
 enum class LightingType : char {
     none,
@@ -50,10 +54,31 @@ enum class RasterType {
     custom
 };
 
+/* Compiled geometry of a mesh that is kept on the client side to be merged
+ * into a <TileBatch>; pointers stay valid as long as the mesh is alive
+ */
+struct RetainedMeshData {
+    uint32_t id = 0;
+    const GLbyte* vertices = nullptr;
+    size_t nVertices = 0;
+    const GLushort* indices = nullptr;
+    size_t nIndices = 0;
+    const std::vector<std::pair<uint32_t, uint32_t>>* offsets = nullptr;
+};
+
 struct StyledMesh {
     virtual bool draw(RenderState& rs, ShaderProgram& _shader) = 0;
     virtual size_t bufferSize() const = 0;
 
+    /* Bytes of compiled geometry that still wait to be sent to the GPU */
+    virtual size_t pendingUploadSize() const { return 0; }
+
+    /* Send compiled geometry to the GPU ahead of the first draw() */
+    virtual void uploadPending(RenderState& rs) {}
+
+    /* Fill _data with the retained geometry, returns false when the mesh can not be batched */
+    virtual bool retainedData(RetainedMeshData& _data) const { return false; }
+
     virtual ~StyledMesh() {}
 };
 
@@ -86,10 +111,21 @@ public:
 
     virtual void addLayoutItems(LabelCollider& _layout) {}
 
+    /* Set the hash of the name of the Layer of the following features */
+    virtual void setLayer(size_t _layer) { m_layer = _layer; }
+
     virtual const Style& style() const = 0;
 
+    /* Bounds of the geometry built since the last setup() in tile units, empty when unknown */
+    const BoundingBox3& bounds() const { return m_bounds; }
+
 protected:
     bool m_hasColorShaderBlock = false;
+    bool m_hasPositionShaderBlock = false;
+
+    BoundingBox3 m_bounds;
+
+    size_t m_layer = 0;
 };
 
 /* Means of constructing and rendering map geometry
@@ -136,10 +172,29 @@ protected:
     /* Whether the style should generate texture coordinates */
     bool m_texCoordsGeneration = false;
 
+    /* Whether tile meshes of this style are merged into shared buffers for drawing */
+    bool m_batching = false;
+
+    /* <VertexLayout> of the merged buffers, extends m_vertexLayout with the tile index */
+    std::shared_ptr<VertexLayout> m_batchLayout;
+
+    /* Tiles per batch, limited by the vertex uniforms of the hardware */
+    size_t m_batchTiles = 0;
+
+    /* Tiles are batched with the tiles sharing their ancestor this many levels up, so
+     * that adding or removing a tile only merges the batch of its own group again */
+    int m_batchGroupLevels = 0;
+
+    /* Batches by the ancestor of their tiles, see m_batchGroupLevels */
+    std::map<TileID, std::unique_ptr<TileBatch>> m_batches;
+
     /* Set uniform values when @_updateUniforms is true,
      */
     void setupShaderUniforms(RenderState& rs, Scene& _scene);
 
+    /* Append the transform and origin of _tile to the u_batch_tiles uniform array */
+    void addBatchTile(UniformArray4f& _batchTiles, const Tile& _tile);
+
     UniformLocation m_uTime{"u_time"};
     // View uniforms
     UniformLocation m_uDevicePixelRatio{"u_device_pixel_ratio"};
@@ -154,6 +209,7 @@ protected:
     UniformLocation m_uModel{"u_model"};
     UniformLocation m_uTileOrigin{"u_tile_origin"};
     UniformLocation m_uProxyDepth{"u_proxy_depth"};
+    UniformLocation m_uBatchTiles{"u_batch_tiles"};
     UniformLocation m_uRasters{"u_rasters"};
     UniformLocation m_uRasterSizes{"u_raster_sizes"};
     UniformLocation m_uRasterOffsets{"u_raster_offsets"};
@@ -245,6 +301,9 @@ public:
     /* Draws the geometry associated with this <Style> */
     virtual void draw(RenderState& rs, const Tile& _tile);
 
+    /* Draws the geometry of all _tiles, merging tile meshes into a few draw calls when batching */
+    virtual void draw(RenderState& rs, const std::vector<std::shared_ptr<Tile>>& _tiles);
+
     virtual void draw(RenderState& rs, const Marker& _marker);
 
     virtual void setLightingType(LightingType _lType);
@@ -261,6 +320,14 @@ public:
 
     bool genTexCoords() const { return m_texCoordsGeneration; }
 
+    void setBatching(bool _batching) { m_batching = _batching; }
+
+    /* Whether the shaders of this style can read per-tile transforms from a batch */
+    virtual bool supportsBatching() const { return false; }
+
+    /* Whether builders should retain tile geometry for batched drawing, valid after build() */
+    bool isBatching() const { return bool(m_batchLayout); }
+
     void setID(uint32_t _id) { m_id = _id; }
 
     std::shared_ptr<Material> getMaterial() { return m_material.material; }
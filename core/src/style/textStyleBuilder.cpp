@@ -15,6 +15,7 @@
 #include "tangram.h"
 
 #include <cmath>
+#include <limits>
 #include <locale>
 #include <mutex>
 #include <algorithm>
@@ -39,7 +40,10 @@ void TextStyleBuilder::setup(const Tile& _tile){
 
     m_atlasRefs.reset();
 
+    // Labels left from the last build are released before their storage
+    m_labels.clear();
     m_textLabels = std::make_unique<TextLabels>(m_style);
+    m_buildsTile = true;
 }
 
 void TextStyleBuilder::setup(const Marker& marker, int zoom) {
@@ -56,7 +60,9 @@ void TextStyleBuilder::setup(const Marker& marker, int zoom) {
 
     m_atlasRefs.reset();
 
+    m_labels.clear();
     m_textLabels = std::make_unique<TextLabels>(m_style);
+    m_buildsTile = false;
 }
 
 void TextStyleBuilder::addLayoutItems(LabelCollider& _layout) {
@@ -164,6 +170,8 @@ std::unique_ptr<StyledMesh> TextStyleBuilder::build() {
 
 bool TextStyleBuilder::addFeatureCommon(const Feature& _feat, const DrawRule& _rule, bool _iconText) {
     TextStyle::Parameters params = applyRule(_rule, _feat.props, _iconText);
+    params.labelOptions.featureId = _feat.id;
+    params.labelOptions.featureLayer = m_layer;
 
     Label::Type labelType;
     if (_feat.geometryType == GeometryType::lines) {
@@ -173,6 +181,11 @@ bool TextStyleBuilder::addFeatureCommon(const Feature& _feat, const DrawRule& _r
         labelType = Label::Type::point;
     }
 
+    // All labels of the feature would be dropped by the LabelCollider, skip shaping the text
+    if (m_buildsTile && params.labelOptions.collide && !hasOwnedAnchor(_feat, _iconText)) {
+        return true;
+    }
+
     // Keep start position of new quads
     size_t quadsStart = m_quads.size();
     size_t numLabels = m_labels.size();
@@ -221,6 +234,49 @@ bool TextStyleBuilder::addFeatureCommon(const Feature& _feat, const DrawRule& _r
     return true;
 }
 
+bool TextStyleBuilder::hasOwnedAnchor(const Feature& _feat, bool _iconText) const {
+
+    auto anyOwned = [](const Line& _points) {
+        for (auto& point : _points) {
+            if (LabelCollider::isOwnedByTile(glm::vec2(point))) { return true; }
+        }
+        return false;
+    };
+
+    if (_feat.geometryType == GeometryType::points) {
+        return anyOwned(_feat.points);
+
+    } else if (_feat.geometryType == GeometryType::polygons) {
+        for (auto& polygon : _feat.polygons) {
+            if (_iconText) {
+                if (LabelCollider::isOwnedByTile(centroid(polygon))) { return true; }
+            } else {
+                for (auto& line : polygon) {
+                    if (anyOwned(line)) { return true; }
+                }
+            }
+        }
+
+    } else if (_feat.geometryType == GeometryType::lines) {
+        for (auto& line : _feat.lines) {
+            if (_iconText) {
+                if (anyOwned(line)) { return true; }
+                continue;
+            }
+            // Line labels are anchored on segments between the points of the line
+            glm::vec2 min(std::numeric_limits<float>::max());
+            glm::vec2 max(std::numeric_limits<float>::lowest());
+            for (auto& point : line) {
+                min = glm::min(min, glm::vec2(point));
+                max = glm::max(max, glm::vec2(point));
+            }
+            if (min.x < 1.f && max.x >= 0.f && min.y < 1.f && max.y >= 0.f) { return true; }
+        }
+    }
+
+    return false;
+}
+
 void TextStyleBuilder::addLineTextLabels(const Feature& _feat, const TextStyle::Parameters& _params) {
     float pixelScale = 1.0/m_tileSize;
     float minLength = m_attributes.width * pixelScale;
@@ -528,11 +584,11 @@ bool TextStyleBuilder::prepareLabel(TextStyle::Parameters& _params, Label::Type
 void TextStyleBuilder::addLabel(const TextStyle::Parameters& _params, Label::Type _type,
                                 Label::Transform _transform) {
 
-    m_labels.emplace_back(new TextLabel(_transform, _type, _params.labelOptions,
-                                        {m_attributes.fill, m_attributes.stroke, m_attributes.fontScale},
-                                        {m_attributes.width, m_attributes.height},
-                                        *m_textLabels, m_attributes.textRanges,
-                                        _params.align));
+    m_labels.emplace_back(new (m_textLabels->arena()) TextLabel(_transform, _type, _params.labelOptions,
+                                                               {m_attributes.fill, m_attributes.stroke, m_attributes.fontScale},
+                                                               {m_attributes.width, m_attributes.height},
+                                                               *m_textLabels, m_attributes.textRanges,
+                                                               _params.align));
 }
 
 }
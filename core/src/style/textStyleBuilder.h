@@ -41,6 +41,11 @@ public:
 
     void addLineTextLabels(const Feature& _feature, const TextStyle::Parameters& _params);
 
+    /* Whether a label of _feature may be anchored within the tile, see
+     * LabelCollider::isOwnedByTile. Lines are tested by their bounds, as the
+     * anchors of line labels depend on the width of the shaped text. */
+    bool hasOwnedAnchor(const Feature& _feature, bool _iconText) const;
+
     std::string applyTextTransform(const TextStyle::Parameters& _params, const std::string& _string);
 
     std::string resolveTextSource(const std::string& textSource, const Properties& props) const;
@@ -58,6 +63,9 @@ protected:
     // Result: TextLabel container
     std::unique_ptr<TextLabels> m_textLabels;
 
+    // Whether a tile is built, for which the LabelCollider drops the labels anchored outside
+    bool m_buildsTile = false;
+
     // Buffers to hold data for TextLabels until build()
     std::vector<GlyphQuad> m_quads;
     std::bitset<FontContext::max_textures> m_atlasRefs;
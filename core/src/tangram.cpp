@@ -9,6 +9,7 @@
 #include "text/fontContext.h"
 #include "tile/tileManager.h"
 #include "tile/tile.h"
+#include "tile/featureIndex.h"
 #include "gl/error.h"
 #include "gl/shaderProgram.h"
 #include "gl/renderState.h"
@@ -28,13 +29,19 @@
 #include "debug/textDisplay.h"
 #include "debug/frameInfo.h"
 
+#include <algorithm>
 #include <cmath>
 #include <bitset>
+#include <map>
+#include <tuple>
 
 namespace Tangram {
 
 const static size_t MAX_WORKERS = 2;
 
+// Seconds of camera motion to look ahead when prefetching tiles
+const static float PREFETCH_LOOKAHEAD = 0.3f;
+
 enum class EaseField { position, zoom, rotation, tilt };
 
 class Map::Impl {
@@ -43,6 +50,11 @@ public:
 
     void setScene(std::shared_ptr<Scene>& _scene);
 
+    void setupFontContext(Scene& _scene);
+
+    // Add the indexed tile features within _radius pixels of _meters to pickResults
+    void pickTileFeatures(const glm::dvec2& _meters, float _radius, const glm::vec2& _screenPosition);
+
     void setEase(EaseField _f, Ease _e);
     void clearEase(EaseField _f);
 
@@ -53,6 +65,10 @@ public:
 
     void setPixelScale(float _pixelsPerPoint);
 
+    // Collect the tiles that will be visible after _seconds of the current
+    // eases and fling, returns false when the view is at rest
+    bool predictVisibleTiles(float _seconds, std::set<TileID>& _tiles);
+
     std::mutex tilesMutex;
     std::mutex sceneMutex;
 
@@ -69,11 +85,25 @@ public:
     std::vector<SceneUpdate> sceneUpdates;
     std::array<Ease, 4> eases;
 
+    // Targets of the position (in meters) and zoom eases
+    glm::dvec2 positionEaseTarget;
+    float zoomEaseTarget = 0;
+
     std::shared_ptr<Scene> scene = std::make_shared<Scene>();
     std::shared_ptr<Scene> nextScene = nullptr;
 
     bool cacheGlState;
 
+    bool frontToBackOrdering = false;
+
+    std::vector<TouchItem> pickResults;
+
+    std::string glyphCacheDirectory;
+    std::string glyphWarmupLocale;
+
+    // Visible tiles ordered by their distance to the camera
+    std::vector<std::shared_ptr<Tile>> orderedTiles;
+
 };
 
 void Map::Impl::setEase(EaseField _f, Ease _e) {
@@ -85,6 +115,42 @@ void Map::Impl::clearEase(EaseField _f) {
     eases[static_cast<size_t>(_f)] = none;
 }
 
+bool Map::Impl::predictVisibleTiles(float _seconds, std::set<TileID>& _tiles) {
+
+    auto& position = eases[static_cast<size_t>(EaseField::position)];
+    auto& zoom = eases[static_cast<size_t>(EaseField::zoom)];
+
+    View predicted(view);
+    bool moving = inputHandler.predictFling(_seconds, predicted);
+
+    // Share of the remaining ease that will be done after _seconds,
+    // assuming a linear progress
+    auto progress = [&](const Ease& _ease) {
+        float remaining = _ease.d - std::fmax(_ease.t, 0.f);
+        return remaining > _seconds ? _seconds / remaining : 1.f;
+    };
+
+    if (!position.finished()) {
+        float f = progress(position);
+        auto pos = predicted.getPosition();
+        predicted.setPosition(pos.x + (positionEaseTarget.x - pos.x) * f,
+                              pos.y + (positionEaseTarget.y - pos.y) * f);
+        moving = true;
+    }
+    if (!zoom.finished()) {
+        float f = progress(zoom);
+        float z = predicted.getZoom();
+        predicted.setZoom(z + (zoomEaseTarget - z) * f);
+        moving = true;
+    }
+
+    if (!moving) { return false; }
+
+    predicted.update();
+    _tiles = predicted.getVisibleTiles();
+    return true;
+}
+
 static std::bitset<8> g_flags = 0;
 
 Map::Map() {
@@ -157,12 +223,24 @@ void Map::Impl::setScene(std::shared_ptr<Scene>& _scene) {
     }
 }
 
+void Map::Impl::setupFontContext(Scene& _scene) {
+    auto& fontContext = _scene.fontContext();
+
+    if (!glyphCacheDirectory.empty()) {
+        fontContext->setGlyphCacheFile(glyphCacheDirectory + "/glyphs.bin");
+    }
+    if (!glyphWarmupLocale.empty()) {
+        fontContext->setWarmupRanges(FontContext::warmupRanges(glyphWarmupLocale));
+    }
+}
+
 void Map::loadScene(const char* _scenePath, bool _useScenePosition) {
     LOG("Loading scene file: %s", _scenePath);
 
     // Copy old scene
     auto scene = std::make_shared<Scene>(_scenePath);
     scene->useScenePosition = _useScenePosition;
+    impl->setupFontContext(*scene);
 
     if (SceneLoader::loadScene(scene)) {
         impl->setScene(scene);
@@ -177,6 +255,7 @@ void Map::loadSceneAsync(const char* _scenePath, bool _useScenePosition, MapRead
         impl->sceneUpdates.clear();
         impl->nextScene = std::make_shared<Scene>(_scenePath);
         impl->nextScene->useScenePosition = _useScenePosition;
+        impl->setupFontContext(*impl->nextScene);
     }
 
     runAsyncTask([scene = impl->nextScene, _platformCallback, &jobQueue = impl->jobQueue, this](){
@@ -302,6 +381,10 @@ bool Map::update(float _dt) {
             impl->view.getZoom()
         };
 
+        std::set<TileID> prefetchTiles;
+        impl->predictVisibleTiles(PREFETCH_LOOKAHEAD, prefetchTiles);
+        impl->tileManager.setPrefetchTiles(std::move(prefetchTiles));
+
         impl->tileManager.updateTileSets(viewState, impl->view.getVisibleTiles());
 
         auto& tiles = impl->tileManager.getVisibleTiles();
@@ -312,12 +395,16 @@ bool Map::update(float _dt) {
             markersNeedUpdate |= marker->isEasing();
         }
 
-        if (impl->view.changedOnLastUpdate() ||
-            impl->tileManager.hasTileSetChanged()) {
+        bool viewOrTilesChanged = (impl->view.changedOnLastUpdate() ||
+                                   impl->tileManager.hasTileSetChanged());
 
+        if (viewOrTilesChanged) {
             for (const auto& tile : tiles) {
                 tile->update(_dt, impl->view);
             }
+        }
+
+        if (viewOrTilesChanged || impl->labels.needPlacement()) {
             impl->labels.updateLabelSet(impl->view, _dt, impl->scene->styles(), tiles, markers,
                                         *impl->tileManager.getTileCache());
         } else {
@@ -330,7 +417,7 @@ bool Map::update(float _dt) {
     bool viewChanged = impl->view.changedOnLastUpdate();
     bool tilesChanged = impl->tileManager.hasTileSetChanged();
     bool tilesLoading = impl->tileManager.hasLoadingTiles();
-    bool labelsNeedUpdate = impl->labels.needUpdate();
+    bool labelsNeedUpdate = impl->labels.needUpdate() || impl->labels.needPlacement();
     bool resourceLoading = (impl->scene->resourceLoad > 0);
     bool nextScene = bool(impl->nextScene);
 
@@ -356,6 +443,9 @@ void Map::render() {
     // Run render-thread tasks
     impl->renderState.jobQueue.runJobs();
 
+    // Start collecting this frame's label and sprite vertices
+    impl->renderState.quadStream().beginFrame();
+
     // Set up openGL for new frame
     impl->renderState.depthMask(GL_TRUE);
     auto& color = impl->scene->background();
@@ -369,15 +459,32 @@ void Map::render() {
     {
         std::lock_guard<std::mutex> lock(impl->tilesMutex);
 
+        // Upload meshes of newly built tiles within the frame budget
+        impl->tileManager.uploadTiles(impl->renderState);
+
+        const auto& visibleTiles = impl->tileManager.getVisibleTiles();
+
+        if (impl->frontToBackOrdering) {
+            // Draw near tiles first so that the depth test rejects the hidden
+            // fragments of tall geometry in tilted views early
+            impl->orderedTiles = visibleTiles;
+            std::sort(impl->orderedTiles.begin(), impl->orderedTiles.end(),
+                      [](const auto& a, const auto& b) {
+                          return a->getViewDepth() < b->getViewDepth();
+                      });
+        }
+
         // Loop over all styles
         for (const auto& style : impl->scene->styles()) {
 
             style->onBeginDrawFrame(impl->renderState, impl->view, *(impl->scene));
 
-            // Loop over all tiles in m_tileSet
-            for (const auto& tile : impl->tileManager.getVisibleTiles()) {
-                style->draw(impl->renderState, *tile);
-            }
+            // Draw all tiles in m_tileSet, ordering only matters for opaque styles
+            bool ordered = (impl->frontToBackOrdering &&
+                            style->blendMode() == Blending::opaque &&
+                            !style->isBatching());
+
+            style->draw(impl->renderState, ordered ? impl->orderedTiles : visibleTiles);
 
             for (const auto& marker : impl->markerManager.markers()) {
                 style->draw(impl->renderState, *marker);
@@ -385,11 +492,14 @@ void Map::render() {
 
             style->onEndDrawFrame();
         }
+
+        // Don't hold on to tiles beyond this frame
+        impl->orderedTiles.clear();
     }
 
     impl->labels.drawDebug(impl->renderState, impl->view);
 
-    FrameInfo::draw(impl->renderState, impl->view, impl->tileManager);
+    FrameInfo::draw(impl->renderState, impl->view, impl->tileManager, *impl->scene, impl->labels);
 }
 
 int Map::getViewportHeight() {
@@ -430,6 +540,7 @@ void Map::setPositionEased(double _lon, double _lat, float _duration, EaseType _
     getPosition(lon_start, lat_start);
     auto cb = [=](float t) { impl->setPositionNow(ease(lon_start, _lon, t, _e), ease(lat_start, _lat, t, _e)); };
     impl->setEase(EaseField::position, { _duration, cb });
+    impl->positionEaseTarget = impl->view.getMapProjection().LonLatToMeters({ _lon, _lat });
 
 }
 
@@ -462,6 +573,7 @@ void Map::setZoomEased(float _z, float _duration, EaseType _e) {
     float z_start = getZoom();
     auto cb = [=](float t) { impl->setZoomNow(ease(z_start, _z, t, _e)); };
     impl->setEase(EaseField::zoom, { _duration, cb });
+    impl->zoomEaseTarget = _z;
 
 }
 
@@ -728,10 +840,100 @@ void Map::useCachedGlState(bool _useCache) {
     impl->cacheGlState = _useCache;
 }
 
-const std::vector<TouchItem>& Map::pickFeaturesAt(float _x, float _y) {
-    return impl->labels.getFeaturesAtPoint(impl->view, 0, impl->scene->styles(),
-                                           impl->tileManager.getVisibleTiles(),
-                                           _x, _y);
+void Map::useFrontToBackOrdering(bool _use) {
+    impl->frontToBackOrdering = _use;
+}
+
+void Map::setGlyphCacheDirectory(const std::string& _path) {
+    impl->glyphCacheDirectory = _path;
+}
+
+void Map::setGlyphWarmupLocale(const std::string& _locale) {
+    impl->glyphWarmupLocale = _locale;
+}
+
+void Map::setShaderCacheDirectory(const std::string& _path) {
+    impl->renderState.shaderCache().setBinaryDirectory(_path);
+}
+
+void Map::setPrefetchNeighbours(bool _enabled) {
+    std::lock_guard<std::mutex> lock(impl->tilesMutex);
+    impl->tileManager.setPrefetchNeighbours(_enabled);
+}
+
+void Map::Impl::pickTileFeatures(const glm::dvec2& _meters, float _radius, const glm::vec2& _screenPosition) {
+
+    float metersPerPixel = 1.f / (view.pixelsPerMeter() * view.pixelScale());
+
+    std::vector<FeatureIndex::Hit> hits;
+
+    // Parts of a feature in several tiles are reported once, at the smallest distance.
+    // Feature ids are only unique within the layer of a source.
+    std::map<std::tuple<uint64_t, size_t, int32_t>, size_t> features;
+
+    for (const auto& tile : tileManager.getVisibleTiles()) {
+        auto* index = tile->featureIndex();
+        if (!index) { continue; }
+
+        // Query in tile units, relative to the south-west corner of the tile
+        double invScale = tile->getInverseScale();
+        glm::vec2 position((_meters - tile->getOrigin()) * invScale);
+
+        hits.clear();
+        index->query(position, _radius * metersPerPixel * invScale, hits);
+
+        for (auto& hit : hits) {
+            float distance = hit.distance * tile->getScale() / metersPerPixel;
+
+            if (hit.id != 0) {
+                auto it = features.emplace(std::make_tuple(hit.id, hit.layer, tile->sourceID()),
+                                           pickResults.size());
+                if (!it.second) {
+                    auto& result = pickResults[it.first->second];
+                    if (distance < result.distance) {
+                        result.properties = hit.properties;
+                        result.distance = distance;
+                    }
+                    continue;
+                }
+            }
+            pickResults.push_back({ hit.properties, { _screenPosition.x, _screenPosition.y }, distance });
+        }
+    }
+}
+
+const std::vector<TouchItem>& Map::pickFeaturesAt(float _x, float _y, float _radius) {
+
+    impl->pickResults = impl->labels.getFeaturesAtPoint(impl->view, 0, impl->scene->styles(),
+                                                        impl->tileManager.getVisibleTiles(),
+                                                        _x, _y);
+
+    double x = _x, y = _y;
+    impl->view.screenToGroundPlane(x, y);
+    glm::dvec3 eye = impl->view.getPosition();
+
+    impl->pickTileFeatures({ x + eye.x, y + eye.y }, _radius, { _x, _y });
+
+    std::stable_sort(impl->pickResults.begin(), impl->pickResults.end(),
+                     [](auto& a, auto& b){ return a.distance < b.distance; });
+
+    return impl->pickResults;
+}
+
+const std::vector<TouchItem>& Map::pickFeaturesAtLngLat(double _lng, double _lat, float _radius) {
+
+    impl->pickResults.clear();
+
+    bool clipped = false;
+    glm::vec2 screenPosition = impl->view.lonLatToScreenPosition(_lng, _lat, clipped);
+    glm::dvec2 meters = impl->view.getMapProjection().LonLatToMeters({ _lng, _lat });
+
+    impl->pickTileFeatures(meters, _radius, screenPosition);
+
+    std::sort(impl->pickResults.begin(), impl->pickResults.end(),
+              [](auto& a, auto& b){ return a.distance < b.distance; });
+
+    return impl->pickResults;
 }
 
 void Map::runAsyncTask(std::function<void()> _task) {
@@ -221,7 +221,33 @@ public:
     // efficiency, but can cause errors if your application code makes OpenGL calls (false by default)
     void useCachedGlState(bool _use);
 
-    const std::vector<TouchItem>& pickFeaturesAt(float _x, float _y);
+    // Set whether the tiles of opaque styles are drawn from near to far, so that hidden fragments
+    // are rejected early in tilted views with extruded geometry (false by default)
+    void useFrontToBackOrdering(bool _use);
+
+    // Set a writable directory where the distance fields of glyphs are stored between runs; an empty
+    // path disables this (the default). Applies to scenes loaded afterwards.
+    void setGlyphCacheDirectory(const std::string& _path);
+
+    // Set a locale, e.g. "en" or "ru", whose common glyphs are built while a scene is loaded rather
+    // than when labels first need them; an empty locale disables this (the default)
+    void setGlyphWarmupLocale(const std::string& _locale);
+
+    // Set a writable directory where linked shader programs are stored between runs, when the
+    // driver supports GL_OES_get_program_binary; an empty path disables this (the default)
+    void setShaderCacheDirectory(const std::string& _path);
+
+    // Set whether the neighbours of the visible tiles are fetched while the view is at rest;
+    // this costs downloads of tiles that may never be shown, disabled by default
+    void setPrefetchNeighbours(bool _enabled);
+
+    // Returns the interactive labels near the screen position _x, _y and the interactive lines
+    // and polygons within _radius pixels of it, sorted by their distance in pixels
+    const std::vector<TouchItem>& pickFeaturesAt(float _x, float _y, float _radius = 10.f);
+
+    // Returns the interactive lines and polygons of the current tiles within _radius pixels,
+    // at the current zoom, of the position _lng, _lat; sorted by their distance in pixels
+    const std::vector<TouchItem>& pickFeaturesAtLngLat(double _lng, double _lat, float _radius = 10.f);
 
     // Run this task asynchronously to Tangram's main update loop.
     void runAsyncTask(std::function<void()> _task);
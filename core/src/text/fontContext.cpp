@@ -5,8 +5,11 @@
 #define SDF_IMPLEMENTATION
 #include "sdf.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <regex>
+#include <sys/stat.h>
 
 #define DEFAULT "fonts/NotoSans-Regular.ttf"
 #define FONT_AR "fonts/NotoNaskh-Regular.ttf"
@@ -24,39 +27,150 @@
 
 namespace Tangram {
 
+constexpr size_t FontContext::max_shards;
+constexpr size_t FontContext::max_cached_layouts;
+
 FontContext::FontContext() :
     resourceLoad(0),
     m_sdfRadius(SDF_WIDTH),
-    m_atlas(*this, GlyphTexture::size, m_sdfRadius),
-    m_batch(m_atlas, m_scratch) {}
+    m_layoutCache(max_cached_layouts) {
+
+    for (auto& shard : m_textureShard) { shard = -1; }
+    m_textureAtlas.fill(0);
+    for (auto& count : m_atlasRefCount) { count = 0; }
+
+    for (size_t i = 0; i < max_shards; i++) {
+        m_shards.push_back(std::make_unique<Shard>(*this, i));
+    }
+}
+
+FontContext::~FontContext() {
+    if (!m_glyphCacheFile.empty()) {
+        m_sdfCache.store(m_glyphCacheFile, m_sdfRadius);
+    }
+}
+
+FontContext::Shard::Shard(FontContext& _context, int _index) :
+    context(_context),
+    index(_index),
+    atlas(*this, GlyphTexture::size, _context.m_sdfRadius),
+    batch(atlas, *this) {}
+
+std::unique_lock<std::mutex> FontContext::lockShard(Shard*& _shard) {
+
+    static std::atomic<size_t> s_nextShard(0);
+    thread_local size_t shard = s_nextShard++;
+
+    // With more threads than shards, threads of the same shard wait on each other
+    _shard = m_shards[shard % m_shards.size()].get();
+    return std::unique_lock<std::mutex>(_shard->mutex);
+}
+
+std::shared_ptr<const FontContext::FaceSource> FontContext::FaceSource::fromPath(std::string _path) {
+    auto source = std::make_shared<FaceSource>();
+    source->id = SdfGlyphCache::hash(_path.data(), _path.size());
+
+    // A font file that is updated in place gets new keys, with its size and modification time
+    struct stat info;
+    if (stat(_path.c_str(), &info) == 0) {
+        uint64_t stamp[] = { uint64_t(info.st_size), uint64_t(info.st_mtime) };
+        source->id = SdfGlyphCache::hash(stamp, sizeof(stamp), source->id);
+    }
+    source->path = std::move(_path);
+    return source;
+}
+
+std::shared_ptr<const FontContext::FaceSource> FontContext::FaceSource::fromData(std::vector<char> _data) {
+    auto source = std::make_shared<FaceSource>();
+    source->id = SdfGlyphCache::hash(_data.data(), _data.size());
+    source->data = std::move(_data);
+    return source;
+}
+
+FontContext::Shard::ShardFont* FontContext::Shard::font(const alfons::Font& _font) {
+
+    auto& entry = fonts[&_font];
+
+    std::vector<std::shared_ptr<const FaceSource>> sources;
+    std::string alias;
+    {
+        std::lock_guard<std::mutex> lock(context.m_fontMutex);
+
+        auto it = context.m_fontFaces.find(&_font);
+        if (it != context.m_fontFaces.end() && it->second.sources.size() > entry.sources.size()) {
+            auto& faces = it->second;
+            sources.assign(faces.sources.begin() + entry.sources.size(), faces.sources.end());
+            alias = faces.alias;
+            entry.size = faces.size;
+        }
+    }
+
+    if (!sources.empty()) {
+        if (!entry.font) { entry.font = fontManager.getFont(alias, entry.size); }
+
+        // Load the faces outside of the font lock, they are only used by this shard
+        for (auto& source : sources) {
+            entry.font->addFace(fontManager.addFontFace(source->inputSource(), entry.size));
+            entry.sources.push_back(source);
+        }
+    }
+
+    return entry.font ? &entry : nullptr;
+}
+
+void FontContext::addFaceSource(const alfons::Font& _font, const std::string& _alias, float _size,
+                                std::shared_ptr<const FaceSource> _source) {
+    auto& faces = m_fontFaces[&_font];
+    faces.alias = _alias;
+    faces.size = _size;
+    faces.sources.push_back(std::move(_source));
+}
+
+void FontContext::addFaceSources(const alfons::Font& _font, const std::string& _alias, float _size,
+                                 const alfons::Font& _other) {
+    auto it = m_fontFaces.find(&_other);
+    if (it == m_fontFaces.end()) { return; }
+
+    // Copy first, _font and _other may be the same
+    auto sources = it->second.sources;
+    for (auto& source : sources) { addFaceSource(_font, _alias, _size, source); }
+}
 
 void FontContext::loadFonts() {
 
+    // Layouts of the default font change with its faces
+    clearLayoutCache();
+
+    std::lock_guard<std::mutex> lock(m_fontMutex);
+
     // Load default fonts
     {
         std::string systemFont = systemFontPath("sans-serif", std::to_string(DEFAULT_BOLDNESS), "normal");
 
+        std::shared_ptr<const FaceSource> source;
+
         if (!systemFont.empty()) {
             LOG("Adding default system font");
-
-            for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
-                m_font[i] = m_alfons.addFont("default", alfons::InputSource(systemFont), size);
-            }
+            source = FaceSource::fromPath(systemFont);
         } else {
             size_t dataSize;
             char* data = reinterpret_cast<char*>(bytesFromFile(DEFAULT, dataSize));
 
-                LOG("Loading default font file %s", DEFAULT);
+            LOG("Loading default font file %s", DEFAULT);
 
-                for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
-                    m_font[i] = m_alfons.addFont("default", alfons::InputSource(data, dataSize), size);
-                }
+            if (data) {
+                source = FaceSource::fromData(std::vector<char>(data, data + dataSize));
+                free(data);
+            } else {
+                LOGW("Default font %s not found", DEFAULT);
+                source = FaceSource::fromData({});
+            }
+        }
 
-                if (data) {
-                    free(data);
-                } else {
-                    LOGW("Default font %s not found", DEFAULT);
-                }
+        for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
+            m_font[i] = m_alfons.addFont("default", source->inputSource(), size);
+            m_fontFaces.erase(m_font[i].get());
+            addFaceSource(*m_font[i], "default", size, source);
         }
     }
 
@@ -76,11 +190,13 @@ void FontContext::loadFonts() {
                 if (data) {
                     LOG("Adding bundled font at path %s", path);
 
+                    auto source = FaceSource::fromData(std::vector<char>(data, data + dataSize));
+                    free(data);
+
                     for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
-                        m_font[i]->addFace(m_alfons.addFontFace(alfons::InputSource(data, dataSize), size));
+                        m_font[i]->addFace(m_alfons.addFontFace(source->inputSource(), size));
+                        addFaceSource(*m_font[i], "default", size, source);
                     }
-
-                    free(data);
                 } else {
                     LOGE("Bundle font %s not found", path);
                 }
@@ -95,8 +211,11 @@ void FontContext::loadFonts() {
             while (!fallback.empty()) {
                 LOG("Font fallback at path %s", fallback.c_str());
 
+                auto source = FaceSource::fromPath(fallback);
+
                 for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
-                    m_font[i]->addFace(m_alfons.addFontFace(alfons::InputSource(fallback), size));
+                    m_font[i]->addFace(m_alfons.addFontFace(source->inputSource(), size));
+                    addFaceSource(*m_font[i], "default", size, source);
                 }
 
                 fallback = systemFontFallbackPath(importance++, DEFAULT_BOLDNESS);
@@ -105,60 +224,127 @@ void FontContext::loadFonts() {
     }
 }
 
-// Synchronized on m_mutex in layoutText(), called on tile-worker threads
-void FontContext::addTexture(alfons::AtlasID id, uint16_t width, uint16_t height) {
-    if (m_textures.size() == max_textures) {
+// Called on tile-worker threads with the shard lock held
+void FontContext::Shard::addTexture(alfons::AtlasID id, uint16_t width, uint16_t height) {
+    std::lock_guard<std::mutex> lock(context.m_mutex);
+
+    if (textures.size() <= id) {
+        textures.resize(id + 1, -1);
+    }
+
+    if (index < 0) { return; }
+
+    if (context.m_textures.size() == max_textures) {
         LOGE("Way too many glyph textures!");
         return;
     }
-    m_textures.emplace_back();
-}
-
-// Synchronized on m_mutex in layoutText(), called on tile-worker threads
-void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_t gw, uint16_t gh,
-                           const unsigned char* src, uint16_t pad) {
 
-    if (id >= max_textures) { return; }
+    int texture = context.m_textures.size();
+    context.m_textures.emplace_back();
+    context.m_textureShard[texture] = index;
+    context.m_textureAtlas[texture] = id;
 
-    auto& texData = m_textures[id].texData;
-    auto& texture = m_textures[id].texture;
+    textures[id] = texture;
+}
 
-    size_t stride = GlyphTexture::size;
-    size_t width =  GlyphTexture::size;
+// Called on tile-worker threads with the shard lock held
+void FontContext::Shard::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_t gw, uint16_t gh,
+                                  const unsigned char* src, uint16_t pad) {
+
+    if (id >= textures.size() || (textures[id] < 0 && index >= 0)) { return; }
+
+    // Copy the glyph bitmap into a padded image for its distance field
+    PendingGlyph glyph;
+    glyph.texture = textures[id];
+    glyph.x = gx;
+    glyph.y = gy;
+    glyph.width = gw + pad * 2;
+    glyph.height = gh + pad * 2;
+    glyph.key = 0;
+
+    if (currentFont && currentLine) {
+        auto& shape = currentLine->shapes()[currentShape];
+        if (shape.face < currentFont->sources.size()) {
+            glyph.key = SdfGlyphCache::key(currentFont->sources[shape.face]->id, shape.codepoint,
+                                           currentFont->size);
+        }
+    }
+    glyph.data.assign(size_t(glyph.width) * glyph.height, 0);
 
-    unsigned char* dst = &texData[(gx + pad) + (gy + pad) * stride];
+    unsigned char* dst = &glyph.data[pad + pad * glyph.width];
 
     for (size_t y = 0, pos = 0; y < gh; y++, pos += gw) {
-        std::memcpy(dst + (y * stride), src + pos, gw);
+        std::memcpy(dst + (y * glyph.width), src + pos, gw);
     }
 
-    dst = &texData[size_t(gx) + (size_t(gy) * width)];
-    gw += pad * 2;
-    gh += pad * 2;
+    pendingGlyphs.push_back(std::move(glyph));
+}
+
+// Called on tile-worker threads with the shard lock held
+void FontContext::Shard::buildPendingGlyphs() {
+
+    if (pendingGlyphs.empty()) { return; }
+
+    for (auto& glyph : pendingGlyphs) {
+        unsigned char* data = glyph.data.data();
+
+        uint64_t key = glyph.key;
+        if (key && context.m_sdfCache.get(key, glyph.width, glyph.height, data)) { continue; }
+
+        size_t bytes = size_t(glyph.width) * size_t(glyph.height) * sizeof(float) * 3;
+        if (sdfBuffer.size() < bytes) {
+            sdfBuffer.resize(bytes);
+        }
 
-    size_t bytes = size_t(gw) * size_t(gh) * sizeof(float) * 3;
-    if (m_sdfBuffer.size() < bytes) {
-        m_sdfBuffer.resize(bytes);
+        sdfBuildDistanceFieldNoAlloc(data, glyph.width, context.m_sdfRadius,
+                                     data, glyph.width, glyph.height, glyph.width,
+                                     &sdfBuffer[0]);
+
+        if (key) { context.m_sdfCache.put(key, glyph.width, glyph.height, data); }
+    }
+
+    if (index < 0) {
+        pendingGlyphs.clear();
+        return;
     }
 
-    sdfBuildDistanceFieldNoAlloc(dst, width, m_sdfRadius,
-                                 dst, gw, gh, width,
-                                 &m_sdfBuffer[0]);
+    std::lock_guard<std::mutex> lock(context.m_mutex);
+
+    for (auto& glyph : pendingGlyphs) {
+        auto& gt = context.m_textures[glyph.texture];
+
+        size_t stride = GlyphTexture::size;
+        unsigned char* dst = &gt.texData[size_t(glyph.x) + size_t(glyph.y) * stride];
 
-    texture.setDirty(gy, gh);
-    m_textures[id].dirty = true;
+        for (size_t y = 0; y < glyph.height; y++) {
+            std::memcpy(dst + y * stride, &glyph.data[y * glyph.width], glyph.width);
+        }
+
+        gt.texture.setDirty(glyph.y, glyph.height);
+        gt.dirty = true;
+    }
+
+    pendingGlyphs.clear();
 }
 
 void FontContext::releaseAtlas(std::bitset<max_textures> _refs) {
     if (!_refs.any()) { return; }
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (size_t i = 0; i < m_textures.size(); i++) {
-        if (!_refs[i]) { continue; }
 
-        if (--m_atlasRefCount[i] == 0) {
-            LOGD("CLEAR ATLAS %d", i);
-            m_atlas.clear(i);
-            m_textures[i].texData.assign(GlyphTexture::size * GlyphTexture::size, 0);
+    for (auto& shard : m_shards) {
+        std::unique_lock<std::mutex> shardLock(shard->mutex, std::defer_lock);
+
+        for (size_t i = 0; i < max_textures; i++) {
+            if (!_refs[i] || m_textureShard[i] != shard->index) { continue; }
+
+            if (!shardLock.owns_lock()) { shardLock.lock(); }
+
+            if (--m_atlasRefCount[i] == 0) {
+                LOGD("CLEAR ATLAS %d", i);
+                shard->atlas.clear(m_textureAtlas[i]);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_textures[i].texData.assign(GlyphTexture::size * GlyphTexture::size, 0);
+            }
         }
     }
 }
@@ -185,9 +371,84 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const std::string&
                              std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
                              glm::vec2& _size, TextRange& _textRanges) {
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::array<bool, 3> alignments = {};
+    if (_params.align != TextLabelProperty::Align::none) {
+        alignments[int(_params.align)] = true;
+    }
 
-    alfons::LineLayout line = m_shaper.shape(_params.font, _text);
+    // Collect possible alignment from anchor fallbacks
+    for (int i = 0; i < _params.labelOptions.anchors.count; i++) {
+        auto anchor = _params.labelOptions.anchors[i];
+        TextLabelProperty::Align alignment = TextLabelProperty::alignFromAnchor(anchor);
+        if (alignment != TextLabelProperty::Align::none) {
+            alignments[int(alignment)] = true;
+        }
+    }
+
+    LayoutKey key{ _text, _params.font.get(), _params.fontScale, _params.lineSpacing,
+                   _params.maxLineWidth, _params.wordWrap, alignments };
+
+    size_t quadsStart = _quads.size();
+
+    bool cached = m_layoutCache.get(key, [&](const Layout& _layout) {
+        _quads.insert(_quads.end(), _layout.quads.begin(), _layout.quads.end());
+        _size = _layout.size;
+        for (size_t i = 0; i < 3; i++) {
+            _textRanges[i] = Range(_layout.ranges[i].start + quadsStart, _layout.ranges[i].length);
+        }
+        // The cache holds a reference, the textures can't be cleared meanwhile
+        for (size_t i = 0; i < max_textures; i++) {
+            if (_layout.refs[i] && !_refs[i]) {
+                _refs[i] = true;
+                m_atlasRefCount[i]++;
+            }
+        }
+    });
+
+    if (cached) { return true; }
+
+    {
+        Shard* shard = nullptr;
+        auto shardLock = lockShard(shard);
+
+        if (!layoutTextInShard(*shard, _params, _text, alignments, _quads, _refs, _size, _textRanges)) {
+            return false;
+        }
+    }
+
+    Layout layout;
+    layout.quads.assign(_quads.begin() + quadsStart, _quads.end());
+    layout.size = _size;
+    for (size_t i = 0; i < 3; i++) {
+        layout.ranges[i] = Range(_textRanges[i].start - quadsStart, _textRanges[i].length);
+    }
+    for (auto& quad : layout.quads) {
+        if (!layout.refs[quad.atlas]) {
+            layout.refs[quad.atlas] = true;
+            // The quads are referenced through _refs, the textures can't be cleared meanwhile
+            m_atlasRefCount[quad.atlas]++;
+        }
+    }
+
+    std::vector<Layout> evicted;
+    m_layoutCache.put(key, std::move(layout), evicted);
+
+    // Not holding a shard lock here, releaseAtlas may need any of them
+    for (auto& entry : evicted) { releaseAtlas(entry.refs); }
+
+    return true;
+}
+
+bool FontContext::layoutTextInShard(Shard& _shard, TextStyle::Parameters& _params, const std::string& _text,
+                                    const std::array<bool, 3>& _alignments,
+                                    std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
+                                    glm::vec2& _size, TextRange& _textRanges) {
+
+    auto font = _shard.font(*_params.font);
+    if (!font) { return false; }
+
+    // Shaped with the faces of the shard, no other thread uses them
+    alfons::LineLayout line = _shard.shaper.shape(font->font, _text);
 
     if (line.shapes().size() == 0) {
         LOGD("Empty text line");
@@ -196,44 +457,36 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const std::string&
 
     line.setScale(_params.fontScale);
 
-    // m_batch.drawShapeRange() calls FontContext's TextureCallback for new glyphs
+    // drawShapeRange() calls the shard's TextureCallback for new glyphs
     // and MeshCallback (drawGlyph) for vertex quads of each glyph in LineLayout.
 
-    m_scratch.quads = &_quads;
+    auto& textWrapper = _shard.textWrapper;
+    _shard.quads = &_quads;
+
+    // Glyphs added to the atlas while drawing a shape are cached by the face and glyph index of the shape
+    _shard.currentFont = font;
+    _shard.currentLine = &line;
+    auto beginShape = [&](size_t _shape) { _shard.currentShape = _shape; };
 
     size_t quadsStart = _quads.size();
     alfons::LineMetrics metrics;
 
-    std::array<bool, 3> alignments = {};
-    if (_params.align != TextLabelProperty::Align::none) {
-        alignments[int(_params.align)] = true;
-    }
-
-    // Collect possible alignment from anchor fallbacks
-    for (int i = 0; i < _params.labelOptions.anchors.count; i++) {
-        auto anchor = _params.labelOptions.anchors[i];
-        TextLabelProperty::Align alignment = TextLabelProperty::alignFromAnchor(anchor);
-        if (alignment != TextLabelProperty::Align::none) {
-            alignments[int(alignment)] = true;
-        }
-    }
-
     if (_params.wordWrap) {
-        m_textWrapper.clearWraps();
+        textWrapper.clearWraps();
 
-        float width = m_textWrapper.getShapeRangeWidth(line, MIN_LINE_WIDTH,
-                                                       _params.maxLineWidth);
+        float width = textWrapper.getShapeRangeWidth(line, MIN_LINE_WIDTH,
+                                                     _params.maxLineWidth);
 
         for (size_t i = 0; i < 3; i++) {
 
-            int rangeStart = m_scratch.quads->size();
-            if (!alignments[i]) {
+            int rangeStart = _quads.size();
+            if (!_alignments[i]) {
                 _textRanges[i] = Range(rangeStart, 0);
                 continue;
             }
-            int numLines = m_textWrapper.draw(m_batch, width, line, TextLabelProperty::Align(i),
-                                              _params.lineSpacing, metrics);
-            int rangeEnd = m_scratch.quads->size();
+            int numLines = textWrapper.draw(_shard.batch, width, line, TextLabelProperty::Align(i),
+                                            _params.lineSpacing, metrics, beginShape);
+            int rangeEnd = _quads.size();
 
             _textRanges[i] = Range(rangeStart, rangeEnd - rangeStart);
 
@@ -246,9 +499,9 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const std::string&
         }
     } else {
         glm::vec2 position(0);
-        int rangeStart = m_scratch.quads->size();
-        m_batch.drawShapeRange(line, 0, line.shapes().size(), position, metrics);
-        int rangeEnd = m_scratch.quads->size();
+        int rangeStart = _quads.size();
+        drawShapeRange(_shard.batch, line, 0, line.shapes().size(), position, metrics, beginShape);
+        int rangeEnd = _quads.size();
 
         _textRanges[0] = Range(rangeStart, rangeEnd - rangeStart);
 
@@ -256,6 +509,11 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const std::string&
         _textRanges[2] = Range(rangeEnd, 0);
     }
 
+    _shard.quads = nullptr;
+    _shard.currentFont = nullptr;
+    _shard.currentLine = nullptr;
+    _shard.buildPendingGlyphs();
+
     auto it = _quads.begin() + quadsStart;
     if (it == _quads.end()) {
         // No glyphs added
@@ -300,13 +558,19 @@ void FontContext::fetch(const FontDescription& _ft) {
             if (rawData.size() == 0) {
                 LOGE("Bad URL request for font %s at URL %s", _ft.alias.c_str(), _ft.uri.c_str());
             } else {
-                std::lock_guard<std::mutex> lock(m_mutex);
-                char* data = reinterpret_cast<char*>(rawData.data());
+                {
+                    auto source = FaceSource::fromData(std::move(rawData));
 
-                for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
-                    auto font = m_alfons.getFont(_ft.alias, size);
-                    font->addFace(m_alfons.addFontFace(alfons::InputSource(data, rawData.size()), size));
+                    std::lock_guard<std::mutex> lock(m_fontMutex);
+
+                    for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
+                        auto font = m_alfons.getFont(_ft.alias, size);
+                        font->addFace(m_alfons.addFontFace(source->inputSource(), size));
+                        addFaceSource(*font, _ft.alias, size, source);
+                    }
                 }
+                // Text may have been laid out with fallback faces
+                clearLayoutCache();
             }
 
             resourceLoad--;
@@ -317,12 +581,18 @@ void FontContext::fetch(const FontDescription& _ft) {
         unsigned char* data = nullptr;
 
         if (loadFontAlloc(_ft.bundleAlias, data, dataSize)) {
-            const char* rdata = reinterpret_cast<const char*>(data);
+            {
+                auto source = FaceSource::fromData(std::vector<char>(data, data + dataSize));
+
+                std::lock_guard<std::mutex> lock(m_fontMutex);
 
-            for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
-                auto font = m_alfons.getFont(_ft.alias, size);
-                font->addFace(m_alfons.addFontFace(alfons::InputSource(rdata, dataSize), size));
+                for (int i = 0, size = BASE_SIZE; i < MAX_STEPS; i++, size += STEP_SIZE) {
+                    auto font = m_alfons.getFont(_ft.alias, size);
+                    font->addFace(m_alfons.addFontFace(source->inputSource(), size));
+                    addFaceSource(*font, _ft.alias, size, source);
+                }
             }
+            clearLayoutCache();
 
             free(data);
         } else {
@@ -331,7 +601,113 @@ void FontContext::fetch(const FontDescription& _ft) {
     }
 }
 
-bool FontContext::loadFontAlloc(const std::string& _bundleFontPath, unsigned char* _data, size_t& _dataSize) {
+std::vector<FontContext::CodepointRange> FontContext::warmupRanges(const std::string& _locale) {
+
+    // Basic Latin and Latin-1 Supplement
+    std::vector<CodepointRange> ranges = { { 0x20, 0x7e }, { 0xa0, 0xff } };
+
+    std::string language = _locale.substr(0, _locale.find_first_of("-_"));
+
+    if (language == "cs" || language == "hu" || language == "pl" || language == "ro" ||
+        language == "tr" || language == "hr" || language == "sk" || language == "sl") {
+        // Latin Extended-A
+        ranges.push_back({ 0x100, 0x17f });
+    } else if (language == "vi") {
+        ranges.push_back({ 0x100, 0x17f });
+        // Latin Extended Additional
+        ranges.push_back({ 0x1ea0, 0x1ef9 });
+    } else if (language == "el") {
+        ranges.push_back({ 0x384, 0x3ce });
+    } else if (language == "ru" || language == "uk" || language == "bg" ||
+               language == "sr" || language == "be" || language == "mk") {
+        ranges.push_back({ 0x400, 0x45f });
+    } else if (language == "he") {
+        ranges.push_back({ 0x5d0, 0x5ea });
+    } else if (language == "ar" || language == "fa") {
+        ranges.push_back({ 0x621, 0x64a });
+    }
+
+    return ranges;
+}
+
+void FontContext::warmup() {
+
+    if (!m_glyphCacheFile.empty() && m_sdfCache.load(m_glyphCacheFile, m_sdfRadius)) {
+        LOG("Loaded %d glyphs from %s", m_sdfCache.size(), m_glyphCacheFile.c_str());
+    }
+
+    if (m_warmupRanges.empty()) { return; }
+
+    // Encode a range of code points as UTF-8
+    auto encode = [](uint32_t _first, uint32_t _last) {
+        std::string text;
+        for (uint32_t c = _first; c <= _last; c++) {
+            if (c < 0x80) {
+                text += char(c);
+            } else if (c < 0x800) {
+                text += char(0xc0 | (c >> 6));
+                text += char(0x80 | (c & 0x3f));
+            } else {
+                text += char(0xe0 | (c >> 12));
+                text += char(0x80 | ((c >> 6) & 0x3f));
+                text += char(0x80 | (c & 0x3f));
+            }
+        }
+        return text;
+    };
+
+    TextStyle::Parameters params;
+    params.wordWrap = false;
+
+    std::vector<GlyphQuad> quads;
+    std::bitset<max_textures> refs;
+    glm::vec2 size;
+    TextRange ranges;
+    std::array<bool, 3> alignments = {{ true, false, false }};
+
+    // The default fonts and those of the scene, at each of their sizes
+    std::vector<std::shared_ptr<alfons::Font>> fonts;
+    {
+        std::lock_guard<std::mutex> lock(m_fontMutex);
+
+        for (auto& font : m_font) {
+            if (font) { fonts.push_back(font); }
+        }
+        for (auto& entry : m_fontFaces) {
+            bool isDefault = std::any_of(m_font.begin(), m_font.end(),
+                                         [&](auto& font) { return font.get() == entry.first; });
+            if (isDefault) { continue; }
+
+            auto font = m_alfons.getFont(entry.second.alias, entry.second.size);
+            if (font->hasFaces()) { fonts.push_back(std::move(font)); }
+        }
+    }
+
+    // Gets no textures, the distance fields of its glyphs only go to m_sdfCache
+    Shard shard(*this, -1);
+
+    for (auto& font : fonts) {
+        params.font = font;
+
+        for (auto& range : m_warmupRanges) {
+            layoutTextInShard(shard, params, encode(range.first, range.second), alignments,
+                              quads, refs, size, ranges);
+        }
+    }
+
+    if (!m_glyphCacheFile.empty()) {
+        m_sdfCache.store(m_glyphCacheFile, m_sdfRadius);
+    }
+}
+
+void FontContext::clearLayoutCache() {
+    std::vector<Layout> evicted;
+    m_layoutCache.clear(evicted);
+
+    for (auto& entry : evicted) { releaseAtlas(entry.refs); }
+}
+
+bool FontContext::loadFontAlloc(const std::string& _bundleFontPath, unsigned char*& _data, size_t& _dataSize) {
 
     if (!m_sceneResourceRoot.empty()) {
         std::string resourceFontPath = m_sceneResourceRoot + _bundleFontPath;
@@ -351,13 +727,13 @@ bool FontContext::loadFontAlloc(const std::string& _bundleFontPath, unsigned cha
     return false;
 }
 
-void FontContext::ScratchBuffer::drawGlyph(const alfons::Rect& q, const alfons::AtlasGlyph& atlasGlyph) {
-    if (atlasGlyph.atlas >= max_textures) { return; }
+void FontContext::Shard::drawGlyph(const alfons::Rect& q, const alfons::AtlasGlyph& atlasGlyph) {
+    if (atlasGlyph.atlas >= textures.size() || textures[atlasGlyph.atlas] < 0) { return; }
 
     auto& g = *atlasGlyph.glyph;
 
     quads->push_back({
-            atlasGlyph.atlas,
+            size_t(textures[atlasGlyph.atlas]),
             {{glm::vec2{q.x1, q.y1} * TextVertex::position_scale, {g.u1, g.v1}},
              {glm::vec2{q.x1, q.y2} * TextVertex::position_scale, {g.u1, g.v2}},
              {glm::vec2{q.x2, q.y1} * TextVertex::position_scale, {g.u2, g.v1}},
@@ -378,9 +754,10 @@ std::shared_ptr<alfons::Font> FontContext::getFont(const std::string& _family, c
         fontSize += STEP_SIZE;
     }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::mutex> lock(m_fontMutex);
 
-    auto font =  m_alfons.getFont(FontDescription::Alias(_family, _style, _weight), fontSize);
+    std::string alias = FontDescription::Alias(_family, _style, _weight);
+    auto font =  m_alfons.getFont(alias, fontSize);
     if (font->hasFaces()) { return font; }
 
     size_t dataSize = 0;
@@ -400,16 +777,21 @@ std::shared_ptr<alfons::Font> FontContext::getFont(const std::string& _family, c
 
             // add fallbacks from default font
             font->addFaces(*m_font[sizeIndex]);
+            addFaceSources(*font, alias, fontSize, *m_font[sizeIndex]);
             return font;
         }
     }
 
-    font->addFace(m_alfons.addFontFace(alfons::InputSource(reinterpret_cast<char*>(data), dataSize), fontSize));
-
+    auto source = FaceSource::fromData(std::vector<char>(reinterpret_cast<char*>(data),
+                                                         reinterpret_cast<char*>(data) + dataSize));
     free(data);
 
+    font->addFace(m_alfons.addFontFace(source->inputSource(), fontSize));
+    addFaceSource(*font, alias, fontSize, source);
+
     // add fallbacks from default font
     font->addFaces(*m_font[sizeIndex]);
+    addFaceSources(*font, alias, fontSize, *m_font[sizeIndex]);
 
     return font;
 }
@@ -15,10 +15,14 @@
 #include "alfons/inputSource.h"
 
 #include "gl/texture.h"
+#include "text/sdfGlyphCache.h"
+#include "util/hash.h"
+#include "util/lruCache.h"
 
 #include <bitset>
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
 
 namespace Tangram {
 
@@ -64,32 +68,52 @@ struct FontDescription {
     }
 };
 
-class FontContext : public alfons::TextureCallback {
+/*
+ * FontContext - Fonts and glyph textures of a scene.
+ *
+ * Text is laid out on tile-worker threads. Each worker keeps one of several
+ * shards holding its own font faces, TextShaper, TextBatch and GlyphAtlas, so
+ * that workers don't wait on each other while shaping. The fonts of m_alfons
+ * identify fonts to the styles, shards create the same fonts from the recorded
+ * sources of their faces. The textures of all shard atlases are allocated from
+ * one list of GlyphTextures, which is synchronized on m_mutex together with the
+ * upload on the render thread.
+ */
+class FontContext {
 
 public:
 
     static constexpr int max_textures = 64;
 
+    static constexpr size_t max_shards = 4;
+
+    static constexpr size_t max_cached_layouts = 4096;
+
+    // Inclusive range of unicode code points
+    using CodepointRange = std::pair<uint32_t, uint32_t>;
+
     FontContext();
 
+    ~FontContext();
+
     void loadFonts();
 
-    /* Synchronized on m_mutex on tile-worker threads
-     * Called from alfons when a texture atlas needs to be created
-     * Triggered from TextStyleBuilder::prepareLabel
-     */
-    void addTexture(alfons::AtlasID id, uint16_t width, uint16_t height) override;
+    /* Set the file to load glyph distance fields from and to store them to */
+    void setGlyphCacheFile(const std::string& _path) { m_glyphCacheFile = _path; }
 
-    /* Synchronized on m_mutex, called tile-worker threads
-     * Called from alfons when a glyph needs to be added the the atlas identified by id
-     * Triggered from TextStyleBuilder::prepareLabel
-     */
-    void addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_t gw, uint16_t gh,
-                  const unsigned char* src, uint16_t pad) override;
+    /* Set the code points to rasterize in warmup() */
+    void setWarmupRanges(std::vector<CodepointRange> _ranges) { m_warmupRanges = std::move(_ranges); }
 
-    void releaseAtlas(std::bitset<max_textures> _refs);
+    /* Code points commonly used for _locale: Basic Latin and Latin-1 for all locales,
+     * and the main block of the script of the language, e.g. Cyrillic for "ru" */
+    static std::vector<CodepointRange> warmupRanges(const std::string& _locale);
+
+    /* Load the glyph cache file and build the distance fields of the warmup ranges for
+     * the default fonts and those loaded for the scene. Called at scene load, before
+     * tile workers lay out text. */
+    void warmup();
 
-    alfons::GlyphAtlas& atlas() { return m_atlas; }
+    void releaseAtlas(std::bitset<max_textures> _refs);
 
     /* Update all textures batches, uploads the data to the GPU */
     void updateTextures(RenderState& rs);
@@ -106,49 +130,211 @@ public:
 
     float maxStrokeWidth() { return m_sdfRadius; }
 
+    /* Called on tile-worker threads from TextStyleBuilder::prepareLabel */
     bool layoutText(TextStyle::Parameters& _params, const std::string& _text,
                     std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
                     glm::vec2& _bbox, TextRange& _textRanges);
 
-    struct ScratchBuffer : public alfons::MeshCallback {
-        void drawGlyph(const alfons::Quad& q, const alfons::AtlasGlyph& altasGlyph) override {}
-        void drawGlyph(const alfons::Rect& q, const alfons::AtlasGlyph& atlasGlyph) override;
-        std::vector<GlyphQuad>* quads;
-    };
-
     void setSceneResourceRoot(const std::string& sceneResourceRoot) { m_sceneResourceRoot = sceneResourceRoot; }
 
     void setBundlePath(const std::string& _bundlePath) { m_bundlePath = _bundlePath; }
 
     void fetch(const FontDescription& _ft);
 
+    /* Drop all cached text layouts, e.g. when the faces of a font changed */
+    void clearLayoutCache();
+
+    size_t layoutCacheHits() const { return m_layoutCache.hits(); }
+    size_t layoutCacheMisses() const { return m_layoutCache.misses(); }
+
     std::atomic_ushort resourceLoad;
 
 private:
 
-    bool loadFontAlloc(const std::string& _bundleFontPath, unsigned char* _data, size_t& _dataSize);
+    /* The parameters that determine the layout of a text */
+    struct LayoutKey {
+        std::string text;
+        const alfons::Font* font;
+        float fontScale;
+        float lineSpacing;
+        uint32_t maxLineWidth;
+        bool wordWrap;
+        std::array<bool, 3> alignments;
+
+        bool operator==(const LayoutKey& _other) const {
+            return text == _other.text && font == _other.font &&
+                fontScale == _other.fontScale && lineSpacing == _other.lineSpacing &&
+                maxLineWidth == _other.maxLineWidth && wordWrap == _other.wordWrap &&
+                alignments == _other.alignments;
+        }
+    };
+
+    struct LayoutKeyHash {
+        size_t operator()(const LayoutKey& _key) const {
+            size_t seed = std::hash<std::string>()(_key.text);
+            hash_combine(seed, _key.font);
+            hash_combine(seed, _key.fontScale);
+            hash_combine(seed, _key.maxLineWidth);
+            return seed;
+        }
+    };
+
+    /* Glyph quads centered around 0/0 and ranges relative to the first quad.
+     * The cache holds a reference on the atlas textures of the quads. */
+    struct Layout {
+        std::vector<GlyphQuad> quads;
+        glm::vec2 size;
+        TextRange ranges;
+        std::bitset<max_textures> refs;
+    };
+
+    struct Shard;
+
+    /* Lay out _text with the faces and atlas of _shard, which the caller has locked */
+    bool layoutTextInShard(Shard& _shard, TextStyle::Parameters& _params, const std::string& _text,
+                           const std::array<bool, 3>& _alignments,
+                           std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
+                           glm::vec2& _bbox, TextRange& _textRanges);
+
+    /* Font data that faces are created from, either a file path or the file contents */
+    struct FaceSource {
+        std::string path;
+        std::vector<char> data;
+
+        // Identifies the face across runs, for the keys of the glyph cache
+        uint64_t id = 0;
+
+        static std::shared_ptr<const FaceSource> fromPath(std::string _path);
+        static std::shared_ptr<const FaceSource> fromData(std::vector<char> _data);
+
+        alfons::InputSource inputSource() const {
+            return path.empty() ? alfons::InputSource(data.data(), data.size()) : alfons::InputSource(path);
+        }
+    };
+
+    /* The faces of a font of m_alfons in the order they were added */
+    struct FontFaces {
+        std::string alias;
+        float size;
+        std::vector<std::shared_ptr<const FaceSource>> sources;
+    };
+
+    /* Record that _font got a face from _source, called with m_fontMutex held */
+    void addFaceSource(const alfons::Font& _font, const std::string& _alias, float _size,
+                       std::shared_ptr<const FaceSource> _source);
+
+    /* Record that _font got the faces of _other, called with m_fontMutex held */
+    void addFaceSources(const alfons::Font& _font, const std::string& _alias, float _size,
+                        const alfons::Font& _other);
+
+    /* Text layout state of one tile-worker, synchronized on its mutex. A shard with a
+     * negative index gets no textures and only fills the glyph cache. */
+    struct Shard : public alfons::TextureCallback, public alfons::MeshCallback {
+
+        struct ShardFont {
+            std::shared_ptr<alfons::Font> font;
+            float size = 0;
+            // Sources of the faces of font, in order
+            std::vector<std::shared_ptr<const FaceSource>> sources;
+        };
+
+        Shard(FontContext& _context, int _index);
+
+        /* The font of this shard for _font of FontContext::m_alfons, with faces added
+         * since the last call. Returns nullptr for fonts without faces. */
+        ShardFont* font(const alfons::Font& _font);
+
+        /* Called from alfons when the atlas of this shard needs a new texture */
+        void addTexture(alfons::AtlasID id, uint16_t width, uint16_t height) override;
+
+        /* Called from alfons when a glyph was added to the atlas of this shard,
+         * the distance field of the glyph is built by buildPendingGlyphs() */
+        void addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_t gw, uint16_t gh,
+                      const unsigned char* src, uint16_t pad) override;
+
+        void drawGlyph(const alfons::Quad& q, const alfons::AtlasGlyph& altasGlyph) override {}
+        void drawGlyph(const alfons::Rect& q, const alfons::AtlasGlyph& atlasGlyph) override;
+
+        /* Build the distance fields of new glyphs and copy them to their textures */
+        void buildPendingGlyphs();
+
+        struct PendingGlyph {
+            int texture;
+            uint16_t x, y, width, height;
+            // Glyph cache key, zero when the glyph is not known
+            uint64_t key;
+            std::vector<unsigned char> data;
+        };
+
+        FontContext& context;
+        const int index;
+
+        std::mutex mutex;
+
+        // FreeType faces must not be used concurrently, each shard loads its own
+        alfons::FontManager fontManager;
+        std::unordered_map<const alfons::Font*, ShardFont> fonts;
+
+        // The font and shape being drawn, glyphs added to the atlas belong to it
+        const ShardFont* currentFont = nullptr;
+        const alfons::LineLayout* currentLine = nullptr;
+        size_t currentShape = 0;
+
+        alfons::GlyphAtlas atlas;
+
+        // TextShaper to create <LineLayout> for a given text and Font
+        alfons::TextShaper shaper;
+
+        // TextBatch to 'draw' <LineLayout>s, i.e. creating glyph textures and glyph quads.
+        // It is intialized with the TextureCallback and MeshCallback of this shard.
+        alfons::TextBatch batch;
+        TextWrapper textWrapper;
+
+        // Output of drawGlyph()
+        std::vector<GlyphQuad>* quads = nullptr;
+
+        // Index into FontContext::m_textures for each atlas of this shard, -1 when
+        // no more textures were available
+        std::vector<int> textures;
+
+        std::vector<PendingGlyph> pendingGlyphs;
+        std::vector<unsigned char> sdfBuffer;
+    };
+
+    /* Lock the shard of this thread. Threads are assigned to shards round robin and
+     * keep their shard, so that glyphs are not added to the atlases of other shards. */
+    std::unique_lock<std::mutex> lockShard(Shard*& _shard);
+
+    bool loadFontAlloc(const std::string& _bundleFontPath, unsigned char*& _data, size_t& _dataSize);
 
     float m_sdfRadius;
-    ScratchBuffer m_scratch;
-    std::vector<unsigned char> m_sdfBuffer;
 
+    std::vector<std::unique_ptr<Shard>> m_shards;
+
+    // Synchronizes m_textures
     std::mutex m_mutex;
-    std::array<int, max_textures> m_atlasRefCount = {{0}};
-    alfons::GlyphAtlas m_atlas;
+    std::vector<GlyphTexture> m_textures;
+
+    // Owning shard and its atlas id of each texture, these don't change once set.
+    // The atlas id is read under the lock of the owning shard. Reference counts
+    // drop to zero only under the lock of the owning shard.
+    std::array<std::atomic<int>, max_textures> m_textureShard;
+    std::array<alfons::AtlasID, max_textures> m_textureAtlas;
+    std::array<std::atomic<int>, max_textures> m_atlasRefCount;
 
+    // Synchronizes m_alfons and m_fontFaces. Text is never shaped with the faces
+    // of m_alfons, so this lock is only held to add fonts and faces.
+    std::mutex m_fontMutex;
     alfons::FontManager m_alfons;
     std::array<std::shared_ptr<alfons::Font>, 3> m_font;
+    std::unordered_map<const alfons::Font*, FontFaces> m_fontFaces;
 
-    std::vector<GlyphTexture> m_textures;
+    ConcurrentLruCache<LayoutKey, Layout, LayoutKeyHash> m_layoutCache;
 
-    // TextShaper to create <LineLayout> for a given text and Font
-    alfons::TextShaper m_shaper;
+    SdfGlyphCache m_sdfCache;
+    std::string m_glyphCacheFile;
+    std::vector<CodepointRange> m_warmupRanges;
 
-    // TextBatch to 'draw' <LineLayout>s, i.e. creating glyph textures and glyph quads.
-    // It is intialized with a TextureCallback implemented by FontContext for adding glyph
-    // textures and a MeshCallback implemented by TextStyleBuilder for adding glyph quads.
-    alfons::TextBatch m_batch;
-    TextWrapper m_textWrapper;
     std::string m_sceneResourceRoot = "";
 
     std::string m_bundlePath = "fonts/";
@@ -0,0 +1,148 @@
+#include "sdfGlyphCache.h"
+
+#include "platform.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace Tangram {
+
+constexpr size_t SdfGlyphCache::max_entries;
+
+struct SdfGlyphCacheHeader {
+    char magic[4];
+    uint32_t version;
+    float sdfRadius;
+    uint32_t count;
+};
+
+struct SdfGlyphCacheEntryHeader {
+    uint64_t key;
+    uint16_t width;
+    uint16_t height;
+};
+
+static const char sdf_cache_magic[4] = { 'T', 'G', 'S', 'D' };
+constexpr uint32_t sdf_cache_version = 2;
+
+uint64_t SdfGlyphCache::hash(const void* _data, size_t _size, uint64_t _seed) {
+    // 64 bit FNV-1a
+    uint64_t h = _seed;
+
+    auto bytes = static_cast<const unsigned char*>(_data);
+    for (size_t i = 0; i < _size; i++) {
+        h ^= bytes[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+uint64_t SdfGlyphCache::key(uint64_t _face, uint32_t _glyph, float _size) {
+    uint64_t h = hash(&_face, sizeof(_face));
+    h = hash(&_glyph, sizeof(_glyph), h);
+    return hash(&_size, sizeof(_size), h);
+}
+
+bool SdfGlyphCache::get(uint64_t _key, uint16_t _width, uint16_t _height, unsigned char* _dst) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(_key);
+    if (it == m_entries.end()) { return false; }
+
+    auto& entry = it->second;
+    if (entry.width != _width || entry.height != _height) { return false; }
+
+    std::memcpy(_dst, entry.data.data(), entry.data.size());
+    return true;
+}
+
+void SdfGlyphCache::put(uint64_t _key, uint16_t _width, uint16_t _height, const unsigned char* _sdf) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_entries.size() >= max_entries) { return; }
+
+    auto& entry = m_entries[_key];
+    entry.width = _width;
+    entry.height = _height;
+    entry.data.assign(_sdf, _sdf + size_t(_width) * _height);
+
+    m_dirty = true;
+}
+
+bool SdfGlyphCache::load(const std::string& _path, float _sdfRadius) {
+
+    std::ifstream file(_path, std::ios::binary);
+    if (!file.is_open()) { return false; }
+
+    SdfGlyphCacheHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, sdf_cache_magic, sizeof(header.magic)) != 0 ||
+        header.version != sdf_cache_version ||
+        header.sdfRadius != _sdfRadius) {
+        LOGD("Discarding glyph cache %s", _path.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (uint32_t i = 0; i < header.count && m_entries.size() < max_entries; i++) {
+        SdfGlyphCacheEntryHeader entryHeader;
+        if (!file.read(reinterpret_cast<char*>(&entryHeader), sizeof(entryHeader))) {
+            LOGW("Truncated glyph cache %s", _path.c_str());
+            return false;
+        }
+
+        Entry entry;
+        entry.width = entryHeader.width;
+        entry.height = entryHeader.height;
+        entry.data.resize(size_t(entry.width) * entry.height);
+
+        if (!file.read(reinterpret_cast<char*>(entry.data.data()), entry.data.size())) {
+            LOGW("Truncated glyph cache %s", _path.c_str());
+            return false;
+        }
+        m_entries.emplace(entryHeader.key, std::move(entry));
+    }
+
+    return true;
+}
+
+bool SdfGlyphCache::store(const std::string& _path, float _sdfRadius) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_dirty) { return true; }
+
+    std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOGW("Cannot write glyph cache to %s", _path.c_str());
+        return false;
+    }
+
+    SdfGlyphCacheHeader header;
+    std::memcpy(header.magic, sdf_cache_magic, sizeof(header.magic));
+    header.version = sdf_cache_version;
+    header.sdfRadius = _sdfRadius;
+    header.count = m_entries.size();
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (auto& it : m_entries) {
+        SdfGlyphCacheEntryHeader entryHeader;
+        entryHeader.key = it.first;
+        entryHeader.width = it.second.width;
+        entryHeader.height = it.second.height;
+
+        file.write(reinterpret_cast<const char*>(&entryHeader), sizeof(entryHeader));
+        file.write(reinterpret_cast<const char*>(it.second.data.data()), it.second.data.size());
+    }
+
+    m_dirty = false;
+    return bool(file);
+}
+
+size_t SdfGlyphCache::size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+}
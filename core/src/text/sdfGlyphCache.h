@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * SdfGlyphCache - Signed distance fields of glyphs keyed by their font face,
+ * glyph index and size, so that the distance field of a glyph is built once
+ * for all atlases and, when stored to a file, across runs.
+ */
+class SdfGlyphCache {
+
+public:
+
+    static constexpr size_t max_entries = 4096;
+
+    // Hash of _size bytes that is stable between runs, e.g. to identify a font file
+    static uint64_t hash(const void* _data, size_t _size, uint64_t _seed = 14695981039346656037ULL);
+
+    // Key of glyph _glyph of the face identified by _face at font size _size
+    static uint64_t key(uint64_t _face, uint32_t _glyph, float _size);
+
+    // Copy the distance field for _key to _dst, returns false when it's not cached
+    bool get(uint64_t _key, uint16_t _width, uint16_t _height, unsigned char* _dst);
+
+    void put(uint64_t _key, uint16_t _width, uint16_t _height, const unsigned char* _sdf);
+
+    // Read the entries of a file written by store() with the same SDF radius
+    bool load(const std::string& _path, float _sdfRadius);
+
+    // Write all entries to _path, if there are new ones since the last load() or store()
+    bool store(const std::string& _path, float _sdfRadius);
+
+    size_t size();
+
+private:
+
+    struct Entry {
+        uint16_t width;
+        uint16_t height;
+        std::vector<unsigned char> data;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    bool m_dirty = false;
+
+};
+
+}
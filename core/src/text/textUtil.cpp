@@ -4,6 +4,25 @@
 
 namespace Tangram {
 
+void drawShapeRange(alfons::TextBatch& _batch, const alfons::LineLayout& _line,
+                    size_t _start, size_t _end, glm::vec2 _position, alfons::LineMetrics& _metrics,
+                    const std::function<void(size_t)>& _beginShape) {
+
+    if (!_beginShape) {
+        _batch.drawShapeRange(_line, _start, _end, _position, _metrics);
+        return;
+    }
+
+    for (size_t i = _start; i < _end; i++) {
+        _beginShape(i);
+
+        glm::vec2 position = _position;
+        _batch.drawShapeRange(_line, i, i + 1, position, _metrics);
+
+        _position.x += _line.advance(_line.shapes()[i]);
+    }
+}
+
 float TextWrapper::getShapeRangeWidth(const alfons::LineLayout& _line,
                                       size_t _minLineChars, size_t _maxLineChars) {
     float maxWidth = 0;
@@ -69,7 +88,8 @@ void TextWrapper::clearWraps() {
 
 int TextWrapper::draw(alfons::TextBatch& _batch, float _maxWidth, const alfons::LineLayout& _line,
                       TextLabelProperty::Align _alignment, float _lineSpacing,
-                      alfons::LineMetrics& _layoutMetrics) {
+                      alfons::LineMetrics& _layoutMetrics,
+                      const std::function<void(size_t)>& _beginShape) {
     size_t shapeStart = 0;
     glm::vec2 position;
 
@@ -91,7 +111,7 @@ int TextWrapper::draw(alfons::TextBatch& _batch, float _maxWidth, const alfons::
         size_t shapeEnd = wrap.first;
 
         // Draw line quads
-        _batch.drawShapeRange(_line, shapeStart, shapeEnd, position, lineMetrics);
+        drawShapeRange(_batch, _line, shapeStart, shapeEnd, position, lineMetrics, _beginShape);
 
         shapeStart = shapeEnd;
 
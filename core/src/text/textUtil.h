@@ -6,10 +6,18 @@
 #include "alfons/textBatch.h"
 #include "alfons/lineLayout.h"
 
+#include <functional>
 #include <vector>
 
 namespace Tangram {
 
+/* Draw the shapes _start to _end of _line to _batch like alfons::TextBatch::drawShapeRange.
+ * With _beginShape the shapes are drawn one by one and _beginShape is called with the
+ * index of each shape before it is drawn, so that new glyphs can be related to it. */
+void drawShapeRange(alfons::TextBatch& _batch, const alfons::LineLayout& _line,
+                    size_t _start, size_t _end, glm::vec2 _position, alfons::LineMetrics& _metrics,
+                    const std::function<void(size_t)>& _beginShape = nullptr);
+
 class TextWrapper {
 
 public:
@@ -30,10 +38,12 @@ public:
      * _alignment align text (center, left, right)
      * _lineSpacing
      * _metrics out: text extents
+     * _beginShape see drawShapeRange()
      */
     int draw(alfons::TextBatch& _batch, float _maxWidth, const alfons::LineLayout& _line,
              TextLabelProperty::Align _alignment, float _lineSpacing,
-             alfons::LineMetrics& _metrics);
+             alfons::LineMetrics& _metrics,
+             const std::function<void(size_t)>& _beginShape = nullptr);
 
 private:
     std::vector<std::pair<int,float>> m_lineWraps;
@@ -0,0 +1,309 @@
+#include "tile/featureIndex.h"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Tangram {
+
+constexpr size_t FeatureIndex::node_size;
+constexpr float FeatureIndex::resolution;
+
+// Position on a Hilbert curve of order 16, from the 'Flatbush' index by Vladimir Agafonkin,
+// based on public domain code by rawrunprotected
+static uint32_t hilbert(uint32_t x, uint32_t y) {
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ (x | y);
+    uint32_t d = x & (y ^ 0xFFFF);
+
+    uint32_t A = a | (b >> 1);
+    uint32_t B = (a >> 1) ^ a;
+    uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+    a = A; b = B; c = C; d = D;
+    A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+    B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+    C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+    D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+    a = A; b = B; c = C; d = D;
+    A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+    B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+    C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+    D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+    a = A; b = B; c = C; d = D;
+    C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+    D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+    i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+    i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+    i0 = (i0 | (i0 << 2)) & 0x33333333;
+    i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+    i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+    i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+    i1 = (i1 | (i1 << 2)) & 0x33333333;
+    i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+    return (i1 << 1) | i0;
+}
+
+static float segmentDistance2(const glm::vec2& _p, const glm::vec2& _a, const glm::vec2& _b) {
+    glm::vec2 ab = _b - _a;
+    float length2 = glm::dot(ab, ab);
+    float t = length2 > 0 ? glm::clamp(glm::dot(_p - _a, ab) / length2, 0.f, 1.f) : 0.f;
+    glm::vec2 d = _a + ab * t - _p;
+    return glm::dot(d, d);
+}
+
+void FeatureIndex::add(const Feature& _feature, size_t _layer) {
+
+    if (_feature.geometryType == GeometryType::lines) {
+        if (_feature.lines.empty()) { return; }
+
+        uint32_t feature = m_propertyOffsets.size();
+        addProperties(_feature, _layer);
+
+        for (auto& line : _feature.lines) {
+            addEntry(feature, { line }, false);
+        }
+    } else if (_feature.geometryType == GeometryType::polygons) {
+        if (_feature.polygons.empty()) { return; }
+
+        uint32_t feature = m_propertyOffsets.size();
+        addProperties(_feature, _layer);
+
+        for (auto& polygon : _feature.polygons) {
+            addEntry(feature, polygon, true);
+        }
+    }
+}
+
+void FeatureIndex::addProperties(const Feature& _feature, size_t _layer) {
+    m_featureIds.push_back(_feature.id);
+    m_featureLayers.push_back(_layer);
+    m_propertyOffsets.push_back(m_properties.size());
+    m_packer.pack(_feature.props, m_properties);
+}
+
+void FeatureIndex::addEntry(uint32_t _feature, const std::vector<Line>& _parts, bool _polygon) {
+
+    Box box { glm::vec2(std::numeric_limits<float>::max()),
+              glm::vec2(std::numeric_limits<float>::lowest()) };
+
+    Entry entry { _feature, uint32_t(m_parts.size()), 0, _polygon };
+
+    for (auto& part : _parts) {
+        if (part.empty()) { continue; }
+
+        uint32_t offset = m_geometry.size();
+        m_parts.emplace_back(offset, part.size());
+        entry.partCount++;
+
+        Compact::encodePoints(part.data(), part.size(), resolution, false, m_geometry);
+
+        // Bound the quantized points, as they are tested in queries
+        Compact::PointReader reader(&m_geometry[offset], resolution, false);
+        for (size_t i = 0; i < part.size(); i++) {
+            glm::vec2 point(reader.next());
+            box.min = glm::min(box.min, point);
+            box.max = glm::max(box.max, point);
+        }
+    }
+    if (entry.partCount == 0) { return; }
+
+    m_entries.push_back(entry);
+    m_boxes.push_back(box);
+}
+
+void FeatureIndex::build() {
+
+    size_t count = m_entries.size();
+    if (count == 0) { return; }
+
+    // Sort entries by the Hilbert value of their box centers
+    Box extent = m_boxes[0];
+    for (auto& box : m_boxes) {
+        extent.min = glm::min(extent.min, box.min);
+        extent.max = glm::max(extent.max, box.max);
+    }
+    glm::vec2 scale = glm::vec2(0xFFFF) / glm::max(extent.max - extent.min, glm::vec2(1e-6f));
+
+    std::vector<uint32_t> values(count);
+    for (size_t i = 0; i < count; i++) {
+        glm::vec2 center = ((m_boxes[i].min + m_boxes[i].max) * 0.5f - extent.min) * scale;
+        values[i] = hilbert(uint32_t(center.x), uint32_t(center.y));
+    }
+
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return values[a] < values[b]; });
+
+    std::vector<Box> boxes;
+    boxes.reserve(count + count / (node_size - 1) + 1);
+    m_indices.clear();
+
+    for (uint32_t i : order) {
+        boxes.push_back(m_boxes[i]);
+        m_indices.push_back(i);
+    }
+
+    // Group each level into the nodes of the next one, until there is a single root
+    m_levelBounds.clear();
+    m_levelBounds.push_back(count);
+
+    size_t pos = 0;
+    while (m_levelBounds.back() - pos > 1) {
+        size_t end = m_levelBounds.back();
+
+        while (pos < end) {
+            size_t first = pos;
+            Box node = boxes[pos];
+            for (size_t i = 0; i < node_size && pos < end; i++, pos++) {
+                node.min = glm::min(node.min, boxes[pos].min);
+                node.max = glm::max(node.max, boxes[pos].max);
+            }
+            boxes.push_back(node);
+            m_indices.push_back(first);
+        }
+        m_levelBounds.push_back(boxes.size());
+    }
+
+    m_boxes = std::move(boxes);
+    m_boxes.shrink_to_fit();
+    m_indices.shrink_to_fit();
+    m_entries.shrink_to_fit();
+    m_parts.shrink_to_fit();
+    m_geometry.shrink_to_fit();
+    m_propertyOffsets.shrink_to_fit();
+    m_properties.shrink_to_fit();
+}
+
+float FeatureIndex::distance(const Entry& _entry, const glm::vec2& _position,
+                              std::vector<glm::vec2>& _points) const {
+
+    float minDistance2 = std::numeric_limits<float>::max();
+    bool inside = false;
+
+    for (uint32_t part = _entry.firstPart; part < _entry.firstPart + _entry.partCount; part++) {
+        uint32_t count = m_parts[part].second;
+
+        Compact::PointReader reader(&m_geometry[m_parts[part].first], resolution, false);
+        _points.clear();
+        for (uint32_t i = 0; i < count; i++) {
+            _points.emplace_back(reader.next());
+        }
+        const glm::vec2* points = _points.data();
+
+        if (count == 1) {
+            glm::vec2 d = points[0] - _position;
+            minDistance2 = std::min(minDistance2, glm::dot(d, d));
+            continue;
+        }
+
+        // Polygon rings are closed implicitly
+        uint32_t segments = _entry.polygon ? count : count - 1;
+
+        for (uint32_t i = 0; i < segments; i++) {
+            const glm::vec2& a = points[i];
+            const glm::vec2& b = points[(i + 1) % count];
+
+            minDistance2 = std::min(minDistance2, segmentDistance2(_position, a, b));
+
+            // Even-odd rule over all rings, so that holes are excluded
+            if (_entry.polygon && ((a.y > _position.y) != (b.y > _position.y)) &&
+                (_position.x < (b.x - a.x) * (_position.y - a.y) / (b.y - a.y) + a.x)) {
+                inside = !inside;
+            }
+        }
+    }
+
+    return inside ? 0.f : std::sqrt(minDistance2);
+}
+
+void FeatureIndex::query(const glm::vec2& _position, float _radius, std::vector<Hit>& _hits) const {
+
+    if (m_boxes.empty()) { return; }
+
+    Box query { _position - _radius, _position + _radius };
+
+    // Closest distance of each feature found
+    std::vector<std::pair<uint32_t, float>> found;
+    std::vector<glm::vec2> points;
+
+    size_t leafCount = m_entries.size();
+
+    std::vector<uint32_t> stack;
+    uint32_t node = m_boxes.size() - 1;
+    size_t level = m_levelBounds.size() - 1;
+
+    // Children of the root start at its index, the root itself is a leaf when there is one entry
+    stack.push_back(leafCount == 1 ? 0 : m_indices[node]);
+    std::vector<size_t> levels { leafCount == 1 ? 0 : level - 1 };
+
+    while (!stack.empty()) {
+        size_t pos = stack.back();
+        level = levels.back();
+        stack.pop_back();
+        levels.pop_back();
+
+        size_t end = std::min<size_t>(pos + node_size, m_levelBounds[level]);
+
+        for (; pos < end; pos++) {
+            if (!m_boxes[pos].intersects(query)) { continue; }
+
+            if (level > 0) {
+                stack.push_back(m_indices[pos]);
+                levels.push_back(level - 1);
+                continue;
+            }
+
+            const Entry& entry = m_entries[m_indices[pos]];
+            float d = distance(entry, _position, points);
+            if (d > _radius) { continue; }
+
+            // Keep the closest part of each feature
+            auto it = std::find_if(found.begin(), found.end(), [&](auto& f) {
+                return f.first == entry.feature;
+            });
+            if (it == found.end()) {
+                found.emplace_back(entry.feature, d);
+            } else {
+                it->second = std::min(it->second, d);
+            }
+        }
+    }
+
+    for (auto& f : found) {
+        auto properties = std::make_shared<Properties>();
+        m_packer.unpack(&m_properties[m_propertyOffsets[f.first]], *properties);
+        _hits.push_back({ std::move(properties), m_featureIds[f.first], m_featureLayers[f.first], f.second });
+    }
+}
+
+size_t FeatureIndex::memoryUsage() const {
+    return m_featureIds.size() * sizeof(uint64_t) +
+        m_featureLayers.size() * sizeof(size_t) +
+        m_propertyOffsets.size() * sizeof(uint32_t) +
+        m_properties.size() +
+        m_packer.memoryUsage() +
+        m_entries.size() * sizeof(Entry) +
+        m_parts.size() * sizeof(m_parts[0]) +
+        m_geometry.size() +
+        m_boxes.size() * sizeof(Box) +
+        m_indices.size() * sizeof(uint32_t);
+}
+
+}
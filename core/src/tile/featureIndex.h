@@ -0,0 +1,109 @@
+#pragma once
+
+#include "data/tileData.h"
+#include "util/compactFeature.h"
+
+#include "glm/vec2.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * FeatureIndex - Spatial index of the interactive lines and polygons of a tile, to find
+ * the features at a position without drawing them. Built once on the tile worker as a
+ * packed Hilbert R-tree: the feature bounding boxes are sorted along a Hilbert curve and
+ * grouped into nodes of node_size entries, level by level up to the root.
+ * Coordinates are in tile units, see data/tileData.h. Geometry and properties are kept
+ * in the compact encoding of util/compactFeature.h and decoded only for the candidates
+ * of a query.
+ */
+class FeatureIndex {
+
+public:
+
+    struct Hit {
+        std::shared_ptr<Properties> properties;
+        // Feature::id, zero when the source has none
+        uint64_t id;
+        // Hash of the name of the Layer of the feature, ids are only unique within a layer
+        size_t layer;
+        // Distance from the query position in tile units, 0 when inside of a polygon
+        float distance;
+    };
+
+    static constexpr size_t node_size = 16;
+
+    // Exact for vector tiles with an extent of up to 65536
+    static constexpr float resolution = 1 << 16;
+
+    /* Add the lines or polygons of _feature from the Layer with name hash _layer,
+     * points are picked through their labels */
+    void add(const Feature& _feature, size_t _layer = 0);
+
+    /* Build the tree, the index can not be changed after that */
+    void build();
+
+    /* Collect the features within _radius of _position, each feature at most once */
+    void query(const glm::vec2& _position, float _radius, std::vector<Hit>& _hits) const;
+
+    bool empty() const { return m_entries.empty(); }
+
+    size_t size() const { return m_entries.size(); }
+
+    size_t memoryUsage() const;
+
+private:
+
+    struct Box {
+        glm::vec2 min;
+        glm::vec2 max;
+
+        bool intersects(const Box& _other) const {
+            return min.x <= _other.max.x && max.x >= _other.min.x &&
+                   min.y <= _other.max.y && max.y >= _other.min.y;
+        }
+    };
+
+    struct Entry {
+        uint32_t feature;
+        // Range in m_parts
+        uint32_t firstPart;
+        uint32_t partCount;
+        bool polygon;
+    };
+
+    void addEntry(uint32_t _feature, const std::vector<Line>& _parts, bool _polygon);
+
+    // _points is scratch space for decoding the parts of _entry
+    float distance(const Entry& _entry, const glm::vec2& _position,
+                   std::vector<glm::vec2>& _points) const;
+
+    void addProperties(const Feature& _feature, size_t _layer);
+
+    // Feature::id and layer of each feature
+    std::vector<uint64_t> m_featureIds;
+    std::vector<size_t> m_featureLayers;
+
+    // Offsets of the packed properties of each feature in m_properties
+    std::vector<uint32_t> m_propertyOffsets;
+    std::vector<uint8_t> m_properties;
+    Compact::PropertiesPacker m_packer;
+
+    std::vector<Entry> m_entries;
+
+    // Offset in m_geometry and point count of line strings or polygon rings
+    std::vector<std::pair<uint32_t, uint32_t>> m_parts;
+    std::vector<uint8_t> m_geometry;
+
+    // Boxes of the entries in Hilbert order followed by the boxes of each level of nodes
+    std::vector<Box> m_boxes;
+    // Entry of a leaf box or position of the first child of a node
+    std::vector<uint32_t> m_indices;
+    // End of each level in m_boxes, the last level holds the root
+    std::vector<uint32_t> m_levelBounds;
+};
+
+}
@@ -3,11 +3,14 @@
 #include "data/dataSource.h"
 #include "style/style.h"
 #include "view/view.h"
+#include "tile/featureIndex.h"
 #include "tile/tileID.h"
 #include "labels/labelSet.h"
 
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <algorithm>
+
 namespace Tangram {
 
 Tile::Tile(TileID _id, const MapProjection& _projection, const DataSource* _source) :
@@ -47,6 +50,10 @@ void Tile::updateTileOrigin(const int _wrap) {
     m_tileOrigin.x += (mapSpan * _wrap);
 }
 
+void Tile::setFeatureIndex(std::unique_ptr<FeatureIndex> _index) {
+    m_featureIndex = std::move(_index);
+}
+
 void Tile::initGeometry(uint32_t _size) {
     m_geometry.resize(_size);
 }
@@ -59,14 +66,29 @@ void Tile::update(float _dt, const View& _view) {
     m_modelMatrix[3][1] = m_tileOrigin.y - viewOrigin.y;
 
     m_mvp = _view.getViewProjectionMatrix() * m_modelMatrix;
+
+    // Cull meshes whose bounds lie outside of the view frustum
+    m_culled.assign(m_geometry.size(), false);
+    m_meshCount = 0;
+    m_culledMeshCount = 0;
+
+    for (size_t i = 0; i < m_geometry.size(); i++) {
+        if (!m_geometry[i]) { continue; }
+        m_meshCount++;
+
+        // Meshes without bounds are always drawn
+        if (i < m_bounds.size() && !m_bounds[i].isEmpty() && isOutsideFrustum(m_mvp, m_bounds[i])) {
+            m_culled[i] = true;
+            m_culledMeshCount++;
+        }
+    }
+
+    m_viewDepth = (m_mvp * glm::vec4(0.5f, 0.5f, 0.f, 1.f)).w;
 }
 
 void Tile::resetState() {
-    for (auto& entry : m_geometry) {
-        if (!entry) { continue; }
-        auto labelSet = dynamic_cast<LabelSet*>(entry.get());
-        if (!labelSet) { continue; }
-        labelSet->reset();
+    for (auto& entry : m_labelMeshes) {
+        entry.labelSet->reset();
     }
 }
 
@@ -75,9 +97,43 @@ void Tile::setMesh(const Style& _style, std::unique_ptr<StyledMesh> _mesh) {
     if (id >= m_geometry.size()) {
         m_geometry.resize(id+1);
     }
+
+    m_labelMeshes.erase(std::remove_if(m_labelMeshes.begin(), m_labelMeshes.end(),
+                                       [&](auto& entry) { return entry.styleId == id; }),
+                        m_labelMeshes.end());
+
+    if (auto labelSet = dynamic_cast<LabelSet*>(_mesh.get())) {
+        // Keep the order of style IDs
+        auto it = std::find_if(m_labelMeshes.begin(), m_labelMeshes.end(),
+                               [&](auto& entry) { return entry.styleId > id; });
+        m_labelMeshes.insert(it, { id, labelSet });
+    }
+
     m_geometry[_style.getID()] = std::move(_mesh);
 }
 
+LabelSet* Tile::getLabelSet(size_t _styleId) const {
+    for (auto& entry : m_labelMeshes) {
+        if (entry.styleId == _styleId) { return entry.labelSet; }
+    }
+    return nullptr;
+}
+
+void Tile::setBounds(const Style& _style, const BoundingBox3& _bounds) {
+    size_t id = _style.getID();
+    if (id >= m_bounds.size()) {
+        m_bounds.resize(id+1);
+    }
+    m_bounds[id] = _bounds;
+}
+
+bool Tile::isVisible(const Style& _style) const {
+    size_t id = _style.getID();
+    if (id >= m_culled.size()) { return true; }
+
+    return !m_culled[id];
+}
+
 const std::unique_ptr<StyledMesh>& Tile::getMesh(const Style& _style) const {
     static std::unique_ptr<StyledMesh> NONE = nullptr;
     if (_style.getID() >= m_geometry.size()) { return NONE; }
@@ -92,9 +148,31 @@ size_t Tile::getMemoryUsage() const {
                 m_memoryUsage += entry->bufferSize();
             }
         }
+        if (m_featureIndex) {
+            m_memoryUsage += m_featureIndex->memoryUsage();
+        }
     }
 
     return m_memoryUsage;
 }
 
+size_t Tile::getPendingUploadSize() const {
+    size_t size = 0;
+    for (auto& entry : m_geometry) {
+        if (entry) {
+            size += entry->pendingUploadSize();
+        }
+    }
+
+    return size;
+}
+
+void Tile::upload(RenderState& rs) {
+    for (auto& entry : m_geometry) {
+        if (entry) {
+            entry->uploadPending(rs);
+        }
+    }
+}
+
 }
@@ -4,6 +4,7 @@
 #include "glm/vec2.hpp"
 #include "gl/texture.h"
 #include "tileID.h"
+#include "util/geom.h"
 
 #include <map>
 #include <memory>
@@ -13,7 +14,10 @@
 namespace Tangram {
 
 class DataSource;
+class FeatureIndex;
+class LabelSet;
 class MapProjection;
+class RenderState;
 class Style;
 class View;
 struct StyledMesh;
@@ -68,6 +72,35 @@ public:
 
     void setMesh(const Style& _style, std::unique_ptr<StyledMesh> _mesh);
 
+    struct LabelMesh {
+        size_t styleId;
+        LabelSet* labelSet;
+    };
+
+    /* Returns the label meshes of this tile, registered by setMesh() */
+    const std::vector<LabelMesh>& getLabelMeshes() const { return m_labelMeshes; }
+
+    /* Returns the label mesh of the style with _styleId, or null */
+    LabelSet* getLabelSet(size_t _styleId) const;
+
+    /* Set the bounds of the mesh of _style in tile units, including extrusion heights */
+    void setBounds(const Style& _style, const BoundingBox3& _bounds);
+
+    /* Returns false when the mesh of _style was outside of the view frustum on the last update() */
+    bool isVisible(const Style& _style) const;
+
+    /* Number of meshes, and of meshes outside of the view frustum, on the last update() */
+    int getMeshCount() const { return m_meshCount; }
+    int getCulledMeshCount() const { return m_culledMeshCount; }
+
+    /* Distance of the tile center from the camera plane on the last update() */
+    float getViewDepth() const { return m_viewDepth; }
+
+    /* Index of the interactive lines and polygons, may be null */
+    const FeatureIndex* featureIndex() const { return m_featureIndex.get(); }
+
+    void setFeatureIndex(std::unique_ptr<FeatureIndex> _index);
+
     auto& rasters() { return m_rasters; }
     const auto& rasters() const { return m_rasters; }
 
@@ -82,6 +115,12 @@ public:
     /* Get the sum in bytes of static <Mesh>es */
     size_t getMemoryUsage() const;
 
+    /* Get the sum in bytes of mesh data that was not uploaded yet */
+    size_t getPendingUploadSize() const;
+
+    /* Upload all pending mesh data, must be called on the render thread */
+    void upload(RenderState& rs);
+
     int64_t sourceGeneration() const { return m_sourceGeneration; }
 
     int32_t sourceID() const { return m_sourceId; }
@@ -119,8 +158,20 @@ private:
 
     // Map of <Style>s and their associated <Mesh>es
     std::vector<std::unique_ptr<StyledMesh>> m_geometry;
+
+    // Meshes of m_geometry that hold labels, so that these are found without a type check per frame
+    std::vector<LabelMesh> m_labelMeshes;
+
+    // Bounds of the <Mesh>es in tile units and their visibility, by <Style> ID
+    std::vector<BoundingBox3> m_bounds;
+    std::vector<bool> m_culled;
+    int m_meshCount = 0;
+    int m_culledMeshCount = 0;
+    float m_viewDepth = 0;
     std::vector<Raster> m_rasters;
 
+    std::unique_ptr<FeatureIndex> m_featureIndex;
+
     mutable size_t m_memoryUsage = 0;
 };
 
@@ -39,6 +39,8 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
 
     m_styleContext.setKeywordZoom(_tileID.s);
 
+    m_featureIndex = std::make_unique<FeatureIndex>();
+
     for (auto& builder : m_styleBuilder) {
         if (builder.second)
             builder.second->setup(*tile);
@@ -58,6 +60,11 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
                 if (!layerContainsCollection) { continue; }
             }
 
+            m_layer = std::hash<std::string>()(collection.name);
+            for (auto& builder : m_styleBuilder) {
+                builder.second->setLayer(m_layer);
+            }
+
             for (const auto& feat : collection.features) {
                 m_ruleSet.apply(feat, datalayer, m_styleContext, *this);
             }
@@ -67,7 +74,7 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
     float tileSize = m_scene->mapProjection()->TileSize() * m_scene->pixelScale();
     float tileScale = pow(2, _tileID.s - _tileID.z);
 
-    m_labelLayout.setup(tileSize, tileScale);
+    m_labelLayout.setup(tileSize, tileScale, _tileID.z);
 
     for (auto& builder : m_styleBuilder) {
 
@@ -77,10 +84,21 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
     m_labelLayout.process();
 
     for (auto& builder : m_styleBuilder) {
-        tile->setMesh(builder.second->style(), builder.second->build());
+        const auto& style = builder.second->style();
+        tile->setMesh(style, builder.second->build());
+        tile->setBounds(style, builder.second->bounds());
+    }
+
+    if (!m_featureIndex->empty()) {
+        m_featureIndex->build();
+        tile->setFeatureIndex(std::move(m_featureIndex));
     }
 
     return tile;
 }
 
+void TileBuilder::addInteractiveFeature(const Feature& _feature) {
+    if (m_featureIndex) { m_featureIndex->add(_feature, m_layer); }
+}
+
 }
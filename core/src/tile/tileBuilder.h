@@ -4,6 +4,7 @@
 #include "scene/styleContext.h"
 #include "scene/drawRule.h"
 #include "labels/labelCollider.h"
+#include "tile/featureIndex.h"
 
 namespace Tangram {
 
@@ -27,6 +28,9 @@ public:
 
     const Scene& scene() const { return *m_scene; }
 
+    /* Add a feature with an interactive draw rule to the index of the current tile */
+    void addInteractiveFeature(const Feature& _feature);
+
 private:
     std::shared_ptr<Scene> m_scene;
 
@@ -35,6 +39,11 @@ private:
 
     LabelCollider m_labelLayout;
 
+    std::unique_ptr<FeatureIndex> m_featureIndex;
+
+    // Hash of the name of the Layer whose features are being built
+    size_t m_layer = 0;
+
     fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilder;
 };
 
@@ -9,6 +9,7 @@
 #include "glm/gtx/norm.hpp"
 
 #include <algorithm>
+#include <chrono>
 
 #define DBG(...) // LOGD(__VA_ARGS__)
 
@@ -31,15 +32,28 @@ TileManager::TileManager(TileTaskQueue& _tileWorker) : m_workers(_tileWorker) {
             task->cancel();
         }
     }};
+
+    m_prefetchCallback = TileTaskCb{[this](std::shared_ptr<TileTask>&& task) {
+        auto& source = task->source();
+        auto id = task->tileId().withMaxSourceZoom(source.maxZoom());
+        {
+            std::lock_guard<std::mutex> lock(m_prefetchMutex);
+            m_prefetchDone.emplace_back(source.id(), TileID(id.x, id.y, id.z));
+        }
+        // Continue with the next prefetch
+        requestRender();
+    }};
 }
 
 TileManager::~TileManager() {
+    cancelPrefetches();
     m_tileSets.clear();
 }
 
 void TileManager::setDataSources(const std::vector<std::shared_ptr<DataSource>>& _sources) {
 
     m_tileCache->clear();
+    cancelPrefetches();
 
     // remove sources that are not in new scene - there must be a better way..
     auto it = std::remove_if(
@@ -103,6 +117,7 @@ void TileManager::clearTileSets() {
     }
 
     m_tileCache->clear();
+    cancelPrefetches();
 }
 
 void TileManager::clearTileSet(int32_t _sourceId) {
@@ -112,15 +127,20 @@ void TileManager::clearTileSet(int32_t _sourceId) {
     }
 
     m_tileCache->clear();
+    cancelPrefetches();
     m_tileSetChanged = true;
 }
 
 void TileManager::updateTileSets(const ViewState& _view,
                                  const std::set<TileID>& _visibleTiles) {
     m_tiles.clear();
+    m_pendingUploads.clear();
     m_loadPending = 0;
     m_tilesInProgress = 0;
     m_tileSetChanged = false;
+    m_loadingMemory = {};
+
+    collectPrefetches();
 
     for (auto& tileSet : m_tileSets) {
         updateTileSet(tileSet, _view, _visibleTiles);
@@ -128,6 +148,8 @@ void TileManager::updateTileSets(const ViewState& _view,
 
     loadTiles();
 
+    prefetchTiles();
+
     // Make m_tiles an unique list of tiles for rendering sorted from
     // high to low zoom-levels.
     std::sort(m_tiles.begin(), m_tiles.end(), [](auto& a, auto& b){
@@ -158,6 +180,13 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
     for (auto& it : tiles) {
         auto& entry = it.second;
         if (entry.newData()) {
+            auto& tile = entry.task->tile();
+            if (tile->getPendingUploadSize() > 0) {
+                // Keep drawing proxies until the meshes are on the GPU
+                m_pendingUploads.emplace_back(entry.task->getPriority(), tile);
+                continue;
+            }
+
             clearProxyTiles(_tileSet, it.first, entry, removeTiles);
             entry.task->complete();
 
@@ -172,7 +201,7 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
     const auto* visibleTiles = &_visibleTiles;
 
     std::set<TileID> mappedTiles;
-    if (_view.zoom > _tileSet.source->maxZoom()) {
+    if (_view.zoom > _tileSet.source->maxZoom() && !_tileSet.source->slicesOverzoomedTiles()) {
         for (const auto& id : _visibleTiles) {
             auto tile = id.withMaxSourceZoom(_tileSet.source->maxZoom());
             // Replace tile with same coordinates and lower source zoom
@@ -195,8 +224,6 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
     auto curTilesIt = tiles.begin();
     auto visTilesIt = visibleTiles->begin();
 
-    auto generation = _tileSet.source->generation();
-
     while (visTilesIt != visibleTiles->end() || curTilesIt != tiles.end()) {
 
         auto& visTileId = visTilesIt == visibleTiles->end()
@@ -217,7 +244,7 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
                 m_tiles.push_back(entry.tile);
 
                 if (!entry.isLoading() &&
-                    (entry.tile->sourceGeneration() < generation)) {
+                    _tileSet.source->isOutdated(visTileId, entry.tile->sourceGeneration())) {
                     // Tile needs update - enqueue for loading
                     enqueueTask(_tileSet, visTileId, _view);
                 }
@@ -231,7 +258,8 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
                     m_tilesInProgress++;
                 } else if (!bool(entry.task) ||
                            (entry.rastersPending() > 0 && !entry.isCanceled()) ||
-                           (entry.isCanceled() && (entry.task->sourceGeneration() < generation))) {
+                           (entry.isCanceled() &&
+                            _tileSet.source->isOutdated(visTileId, entry.task->sourceGeneration()))) {
                     // Start loading when:
                     // no task is set,
                     // one of the raster for this task has not been loaded yet
@@ -298,9 +326,18 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
         }
     }
 
+    int64_t oldestGeneration = _tileSet.source->generation();
+
     for (auto& it : tiles) {
         auto& entry = it.second;
 
+        if (entry.tile) {
+            oldestGeneration = std::min(oldestGeneration, entry.tile->sourceGeneration());
+        }
+        if (entry.task) {
+            oldestGeneration = std::min(oldestGeneration, entry.task->sourceGeneration());
+        }
+
         size_t rasterLoading = 0;
         size_t rasterDone = 0;
 
@@ -342,6 +379,17 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             for (auto& subTask : task->subTasks()) {
                 if (!subTask->hasData()) { m_loadPending++; }
             }
+
+            // Account the memory held by the tile in progress
+            if (task->isReady()) {
+                m_loadingMemory.meshes += task->tile()->getPendingUploadSize();
+            } else {
+                m_loadingMemory.rawData += task->rawDataSize();
+                m_loadingMemory.tileData += task->parsedDataSize();
+            }
+            for (auto& subTask : task->subTasks()) {
+                if (!subTask->isReady()) { m_loadingMemory.rawData += subTask->rawDataSize(); }
+            }
         }
 
         if (entry.isReady()) {
@@ -349,6 +397,11 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             entry.tile->setProxyState(entry.getProxyCounter() > 0);
         }
     }
+
+    if (!tiles.empty() && oldestGeneration != _tileSet.oldestGeneration) {
+        _tileSet.oldestGeneration = oldestGeneration;
+        _tileSet.source->setOldestGeneration(oldestGeneration);
+    }
 }
 
 void TileManager::enqueueTask(TileSet& _tileSet, const TileID& _tileID,
@@ -412,8 +465,14 @@ void TileManager::loadSubTasks(std::vector<std::shared_ptr<DataSource>>& _subSou
     }
 }
 
+void TileManager::setLoadingMemoryBudget(size_t _bytes) {
+    m_loadingMemoryBudget = _bytes;
+}
+
 void TileManager::loadTiles() {
 
+    bool paused = isLoadingPaused();
+
     for (auto& loadTask : m_loadTasks) {
 
         auto tileId = std::get<2>(loadTask);
@@ -428,8 +487,15 @@ void TileManager::loadTiles() {
             continue;
         }
 
+        // Wait for the tiles in progress to free memory
+        if (paused) { continue; }
+
         auto task = tileSet.source->createTask(tileId);
 
+        if (takePrefetched(tileSet, tileId, task->hasData())) {
+            m_prefetchStats.hits++;
+        }
+
         if (task->hasData()) {
             // Note: Set implicit 'loading' state
             entry.task = task;
@@ -450,19 +516,189 @@ void TileManager::loadTiles() {
         }
     }
 
-    DBG("loading:%d pending:%d cache: %fMB",
+    DBG("loading:%d pending:%d cache: %fMB loading memory: %fMB",
         m_loadTasks.size(), m_loadPending,
-        (double(m_tileCache->getMemoryUsage()) / (1024 * 1024)));
+        (double(m_tileCache->getMemoryUsage()) / (1024 * 1024)),
+        (double(m_loadingMemory.total()) / (1024 * 1024)));
 
     m_loadTasks.clear();
 }
 
+TileManager::PrefetchKey TileManager::prefetchKey(const TileSet& _tileSet, const TileID& _tileID) {
+    // Overzoomed tiles share the data of their tile at the source zoom
+    auto id = _tileID.withMaxSourceZoom(_tileSet.source->maxZoom());
+    return { _tileSet.source->id(), TileID(id.x, id.y, id.z) };
+}
+
+void TileManager::addPrefetched(const PrefetchKey& _key) {
+    m_prefetched.push_back(_key);
+    if (m_prefetched.size() > MAX_PREFETCHED) { m_prefetched.pop_front(); }
+}
+
+void TileManager::collectPrefetches() {
+
+    std::vector<PrefetchKey> done;
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        std::swap(done, m_prefetchDone);
+    }
+
+    for (auto& key : done) {
+        // Not found when canceled or taken over by a visible tile meanwhile
+        if (m_prefetchTasks.erase(key)) {
+            m_prefetchStats.fetched++;
+            addPrefetched(key);
+        }
+    }
+
+    // Failed downloads do not call back, give up on them after a while
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto it = m_prefetchTasks.begin(); it != m_prefetchTasks.end();) {
+        if (now - it->second.start > std::chrono::seconds(PREFETCH_TIMEOUT)) {
+            addPrefetched(it->first);
+            cancelPrefetch(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TileManager::prefetchTiles() {
+
+    if (m_prefetchBudget == 0) {
+        cancelPrefetches();
+        return;
+    }
+
+    std::set<PrefetchKey> wanted;
+
+    for (auto& tileSet : m_tileSets) {
+        if (tileSet.clientDataSource) { continue; }
+
+        auto& source = *tileSet.source;
+
+        if (!m_prefetchTiles.empty()) {
+            for (auto id : m_prefetchTiles) {
+                if (id.z > source.maxZoom() && !source.slicesOverzoomedTiles()) {
+                    id = id.withMaxSourceZoom(source.maxZoom());
+                }
+                prefetchTile(tileSet, id, wanted);
+            }
+            continue;
+        }
+
+        if (!m_prefetchNeighbours) { continue; }
+
+        // At rest, fetch the neighbours of the visible tiles
+        std::set<TileID> neighbours;
+        for (auto& it : tileSet.tiles) {
+            if (!it.second.isVisible()) { continue; }
+
+            auto& id = it.first;
+            for (int dx = -1; dx <= 1; dx++) {
+                for (int dy = -1; dy <= 1; dy++) {
+                    neighbours.emplace(id.x + dx, id.y + dy, id.z, id.s, id.wrap);
+                }
+            }
+        }
+        for (auto& id : neighbours) {
+            prefetchTile(tileSet, id, wanted);
+        }
+    }
+
+    for (auto it = m_prefetchTasks.begin(); it != m_prefetchTasks.end();) {
+        if (wanted.count(it->first) == 0) {
+            cancelPrefetch(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TileManager::prefetchTile(TileSet& _tileSet, const TileID& _tileID,
+                               std::set<PrefetchKey>& _wanted) {
+
+    if (!_tileID.isValid()) { return; }
+
+    auto& source = *_tileSet.source;
+    auto key = prefetchKey(_tileSet, _tileID);
+
+    _wanted.insert(key);
+
+    if (_tileSet.tiles.find(_tileID) != _tileSet.tiles.end() ||
+        m_tileCache->contains(source.id(), _tileID)) {
+        return;
+    }
+
+    if (m_prefetchTasks.find(key) != m_prefetchTasks.end() ||
+        std::find(m_prefetched.begin(), m_prefetched.end(), key) != m_prefetched.end()) {
+        return;
+    }
+
+    // Visible tiles go first
+    if (m_prefetchTasks.size() >= m_prefetchBudget || m_loadPending >= MAX_DOWNLOADS ||
+        isLoadingPaused()) {
+        return;
+    }
+
+    auto task = source.createTask(_tileID);
+
+    // Already in the DataSource cache
+    if (task->hasData()) { return; }
+
+    if (source.loadTileData(std::shared_ptr<TileTask>(task), m_prefetchCallback)) {
+        m_prefetchTasks.emplace(key, PrefetchTask{ task, std::chrono::steady_clock::now() });
+        m_prefetchStats.requested++;
+    }
+}
+
+void TileManager::cancelPrefetch(std::map<PrefetchKey, PrefetchTask>::iterator& _it) {
+
+    auto& task = _it->second.task;
+    task->cancel();
+    // Keeps the request when a visible tile is waiting for it too
+    task->source().cancelLoadingTile(task->tileId());
+
+    m_prefetchStats.canceled++;
+    _it = m_prefetchTasks.erase(_it);
+}
+
+void TileManager::cancelPrefetches() {
+    for (auto it = m_prefetchTasks.begin(); it != m_prefetchTasks.end();) {
+        cancelPrefetch(it);
+    }
+    m_prefetched.clear();
+}
+
+bool TileManager::takePrefetched(const TileSet& _tileSet, const TileID& _tileID, bool _hasData) {
+
+    if (m_prefetchTasks.empty() && m_prefetched.empty()) { return false; }
+
+    auto key = prefetchKey(_tileSet, _tileID);
+
+    // Still downloading, the tile shares the running request from now on
+    if (m_prefetchTasks.erase(key)) { return true; }
+
+    auto it = std::find(m_prefetched.begin(), m_prefetched.end(), key);
+    if (it == m_prefetched.end()) { return false; }
+
+    m_prefetched.erase(it);
+
+    // Timed out prefetches have no data
+    return _hasData;
+}
+
+void TileManager::setPrefetchBudget(size_t _requests) {
+    m_prefetchBudget = _requests;
+}
+
 bool TileManager::addTile(TileSet& _tileSet, const TileID& _tileID) {
 
     auto tile = m_tileCache->get(_tileSet.source->id(), _tileID);
 
     if (tile) {
-        if (tile->sourceGeneration() == _tileSet.source->generation()) {
+        if (!_tileSet.source->isOutdated(_tileID, tile->sourceGeneration())) {
             m_tiles.push_back(tile);
 
             // Update tile origin based on wrap (set in the new tileID)
@@ -576,7 +812,11 @@ void TileManager::updateProxyTiles(TileSet& _tileSet, const TileID& _tileID, Til
         return;
     }
     // Try children
-    if (_tileSet.source->maxZoom() > _tileID.z) {
+    if (_tileSet.source->slicesOverzoomedTiles()) {
+        for (int i = 0; i < 4; i++) {
+            updateProxyTile(_tileSet, _tile, _tileID.getChild(i), static_cast<ProxyID>(1 << i));
+        }
+    } else if (_tileSet.source->maxZoom() > _tileID.z) {
         for (int i = 0; i < 4; i++) {
             auto childID = _tileID.getChild(i, _tileSet.source->maxZoom());
             updateProxyTile(_tileSet, _tile, childID, static_cast<ProxyID>(1 << i));
@@ -623,4 +863,45 @@ void TileManager::setCacheSize(size_t _cacheSize) {
     m_tileCache->limitCacheSize(_cacheSize);
 }
 
+void TileManager::setUploadBudget(size_t _bytes, float _milliseconds) {
+    m_uploadBudget = _bytes;
+    m_uploadTimeBudget = _milliseconds;
+}
+
+void TileManager::uploadTiles(RenderState& rs) {
+
+    if (m_pendingUploads.empty()) { return; }
+
+    std::sort(m_pendingUploads.begin(), m_pendingUploads.end(),
+              [](auto& a, auto& b) { return a.first < b.first; });
+
+    auto start = std::chrono::steady_clock::now();
+    size_t uploaded = 0;
+
+    auto it = m_pendingUploads.begin();
+    for (; it != m_pendingUploads.end(); ++it) {
+        auto& tile = it->second;
+        size_t size = tile->getPendingUploadSize();
+
+        if (uploaded > 0) {
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (uploaded + size > m_uploadBudget || elapsed.count() > m_uploadTimeBudget) {
+                break;
+            }
+        }
+
+        tile->upload(rs);
+        uploaded += size;
+    }
+
+    DBG("uploaded %d tiles, %d bytes - pending: %d",
+        std::distance(m_pendingUploads.begin(), it), uploaded,
+        std::distance(it, m_pendingUploads.end()));
+
+    m_pendingUploads.erase(m_pendingUploads.begin(), it);
+
+    // Uploaded tiles get swapped in on the next update
+    requestRender();
+}
+
 }
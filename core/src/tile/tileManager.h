@@ -7,6 +7,8 @@
 #include "tileTask.h"
 #include "util/fastmap.h"
 
+#include <chrono>
+#include <deque>
 #include <map>
 #include <vector>
 #include <memory>
@@ -18,6 +20,7 @@
 namespace Tangram {
 
 class DataSource;
+class RenderState;
 class TileCache;
 
 struct ViewState {
@@ -36,6 +39,11 @@ class TileManager {
 
     const static size_t DEFAULT_CACHE_SIZE = 32*1024*1024; // 32 MB
     const static int MAX_DOWNLOADS = 4;
+    const static size_t DEFAULT_UPLOAD_BUDGET = 2*1024*1024; // 2 MB per frame
+    const static size_t DEFAULT_PREFETCH_BUDGET = 4;
+    const static size_t MAX_PREFETCHED = 256;
+    const static int PREFETCH_TIMEOUT = 10; // seconds
+    const static size_t DEFAULT_LOADING_MEMORY_BUDGET = 32*1024*1024; // 32 MB
 
 public:
 
@@ -73,6 +81,63 @@ public:
      */
     void setCacheSize(size_t _cacheSize);
 
+    /* Uploads the meshes of newly built tiles, nearest tiles first, until
+     * the per-frame budget is spent. Must be called on the render thread.
+     * Tiles are only shown once uploaded, until then their proxies are drawn.
+     */
+    void uploadTiles(RenderState& rs);
+
+    /* @_bytes, @_milliseconds: Limits of mesh data uploaded per frame.
+     * At least one tile is uploaded per frame regardless of its size.
+     */
+    void setUploadBudget(size_t _bytes, float _milliseconds);
+
+    bool hasPendingUploads() const { return !m_pendingUploads.empty(); }
+
+    /* Sets the tiles that are expected to become visible soon, e.g. along the
+     * current camera motion. Their data is fetched into the DataSource caches
+     * while no visible tiles are waiting for downloads. Without such tiles the
+     * neighbours of the visible tiles are fetched instead, when enabled.
+     */
+    void setPrefetchTiles(std::set<TileID> _tiles) { m_prefetchTiles = std::move(_tiles); }
+
+    /* @_requests: Maximum number of prefetch downloads at a time, 0 disables prefetching.
+     * Prefetches that are no longer needed on an update are canceled.
+     */
+    void setPrefetchBudget(size_t _requests);
+
+    void setPrefetchNeighbours(bool _enabled) { m_prefetchNeighbours = _enabled; }
+
+    struct PrefetchStats {
+        size_t requested = 0;
+        size_t fetched = 0;
+        size_t canceled = 0;
+        // Tiles that were prefetched or being prefetched when they became visible
+        size_t hits = 0;
+    };
+
+    const PrefetchStats& getPrefetchStats() const { return m_prefetchStats; }
+
+    /* Memory held by the tiles in progress, as of the last update */
+    struct LoadingMemory {
+        // Downloaded data waiting to be built
+        size_t rawData = 0;
+        // Parsed TileData of the tiles being built
+        size_t tileData = 0;
+        // Meshes of built tiles waiting to be uploaded
+        size_t meshes = 0;
+
+        size_t total() const { return rawData + tileData + meshes; }
+    };
+
+    const LoadingMemory& getLoadingMemory() const { return m_loadingMemory; }
+
+    /* @_bytes: Limit of memory held by the tiles in progress. Above 3/4 of the
+     * budget no further tiles are fetched or built until the tiles in progress
+     * were uploaded and freed their memory. Work that was done is never dropped.
+     */
+    void setLoadingMemoryBudget(size_t _bytes);
+
 private:
 
     enum class ProxyID : uint8_t {
@@ -185,6 +250,8 @@ private:
         std::shared_ptr<DataSource> source;
         std::map<TileID, TileEntry> tiles;
         int64_t sourceGeneration = 0;
+        // Oldest source generation of the tiles, as last passed to DataSource::setOldestGeneration
+        int64_t oldestGeneration = 0;
         bool clientDataSource;
     };
 
@@ -193,9 +260,39 @@ private:
     void enqueueTask(TileSet& _tileSet, const TileID& _tileID, const ViewState& _view);
 
     void loadTiles();
+
+    /* Whether no tiles should be fetched or built for the loading memory budget */
+    bool isLoadingPaused() const {
+        return m_loadingMemory.total() > m_loadingMemoryBudget / 4 * 3;
+    }
+
     void loadSubTasks(std::vector<std::shared_ptr<DataSource>>& subSources, std::shared_ptr<TileTask>& tileTask,
                       const TileID& tileID);
 
+    /* Key of the data request of a tile: source id and the tile at its source zoom */
+    using PrefetchKey = std::pair<int32_t, TileID>;
+
+    struct PrefetchTask {
+        std::shared_ptr<TileTask> task;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    PrefetchKey prefetchKey(const TileSet& _tileSet, const TileID& _tileID);
+
+    /* Moves completed prefetches from m_prefetchDone to m_prefetched */
+    void collectPrefetches();
+    void addPrefetched(const PrefetchKey& _key);
+
+    /* Starts downloads of the prefetch tiles within the budget and
+     * cancels the prefetches that are no longer needed */
+    void prefetchTiles();
+    void prefetchTile(TileSet& _tileSet, const TileID& _tileID, std::set<PrefetchKey>& _wanted);
+    void cancelPrefetch(std::map<PrefetchKey, PrefetchTask>::iterator& _it);
+    void cancelPrefetches();
+
+    /* Returns whether the data of _tileID was prefetched and forgets about it */
+    bool takePrefetched(const TileSet& _tileSet, const TileID& _tileID, bool _hasData);
+
     /*
      * Constructs a future (async) to load data of a new visible tile this is
      *      also responsible for loading proxy tiles for the newly visible tiles
@@ -243,6 +340,32 @@ private:
     /* Temporary list of tiles that need to be loaded */
     std::vector<std::tuple<double, TileSet*, TileID>> m_loadTasks;
 
+    /* Built tiles waiting for their meshes to be uploaded, with load priority */
+    std::vector<std::pair<double, std::shared_ptr<Tile>>> m_pendingUploads;
+
+    size_t m_uploadBudget = DEFAULT_UPLOAD_BUDGET;
+    float m_uploadTimeBudget = 4.f;
+
+    std::set<TileID> m_prefetchTiles;
+
+    /* Running prefetch downloads */
+    std::map<PrefetchKey, PrefetchTask> m_prefetchTasks;
+
+    /* Completed or timed out prefetches, oldest first */
+    std::deque<PrefetchKey> m_prefetched;
+
+    /* Callback for DataSource: Collects the completed prefetches */
+    TileTaskCb m_prefetchCallback;
+    std::vector<PrefetchKey> m_prefetchDone;
+    std::mutex m_prefetchMutex;
+
+    LoadingMemory m_loadingMemory;
+    size_t m_loadingMemoryBudget = DEFAULT_LOADING_MEMORY_BUDGET;
+
+    size_t m_prefetchBudget = DEFAULT_PREFETCH_BUDGET;
+    bool m_prefetchNeighbours = false;
+    PrefetchStats m_prefetchStats;
+
 
 };
 
@@ -1,10 +1,14 @@
 #include "tileTask.h"
 #include "data/dataSource.h"
+#include "data/propertyItem.h"
+#include "data/tileData.h"
 #include "tile/tileBuilder.h"
 #include "scene/scene.h"
 #include "util/mapProjection.h"
 #include "tile/tile.h"
 
+#include <unordered_set>
+
 namespace Tangram {
 
 TileTask::TileTask(TileID& _tileId, std::shared_ptr<DataSource> _source, int _subTask) :
@@ -14,15 +18,68 @@ TileTask::TileTask(TileID& _tileId, std::shared_ptr<DataSource> _source, int _su
     m_sourceGeneration(_source->generation()),
     m_priority(0) {}
 
+static size_t tileDataSize(const TileData& _tileData) {
+    size_t size = 0;
+
+    // Dictionaries are shared by the features of a layer, count each once
+    std::unordered_set<const Properties::Dictionary*> dictionaries;
+
+    for (auto& layer : _tileData.layers) {
+        size += layer.features.size() * sizeof(Feature);
+
+        for (auto& feature : layer.features) {
+            size += feature.points.size() * sizeof(Point);
+            for (auto& line : feature.lines) {
+                size += sizeof(Line) + line.size() * sizeof(Point);
+            }
+            for (auto& polygon : feature.polygons) {
+                for (auto& ring : polygon) {
+                    size += sizeof(Line) + ring.size() * sizeof(Point);
+                }
+            }
+            size += feature.props.memoryUsage();
+
+            if (auto& dictionary = feature.props.dictionary()) {
+                if (dictionaries.insert(dictionary.get()).second) {
+                    size += dictionary->memoryUsage();
+                }
+            }
+        }
+    }
+    return size;
+}
+
+void TileTask::buildTile(TileBuilder& _tileBuilder, const TileData* _tileData) {
+
+    if (!_tileData) {
+        cancel();
+        return;
+    }
+
+    m_parsedDataSize = tileDataSize(*_tileData);
+
+    m_tile = _tileBuilder.build(m_tileId, *_tileData, *m_source);
+
+    m_parsedDataSize = 0;
+}
+
 void TileTask::process(TileBuilder& _tileBuilder) {
 
     auto tileData = m_source->parse(*this, *_tileBuilder.scene().mapProjection());
 
-    if (tileData) {
-        m_tile = _tileBuilder.build(m_tileId, *tileData, *m_source);
-    } else {
-        cancel();
+    buildTile(_tileBuilder, tileData.get());
+}
+
+void DownloadTileTask::process(TileBuilder& _tileBuilder) {
+
+    if (m_tileId.z <= m_source->maxZoom()) {
+        TileTask::process(_tileBuilder);
+        return;
     }
+
+    auto tileData = m_source->parseOverzoomed(*this, *_tileBuilder.scene().mapProjection());
+
+    buildTile(_tileBuilder, tileData.get());
 }
 
 void TileTask::complete() {
@@ -33,6 +33,12 @@ public:
 
     virtual bool isReady() const { return bool(m_tile); }
 
+    // Size of the downloaded data waiting to be processed, that only this task holds
+    virtual size_t rawDataSize() const { return 0; }
+
+    // Approximate size of the parsed TileData while the tile is being built
+    size_t parsedDataSize() const { return m_parsedDataSize; }
+
     std::shared_ptr<Tile>& tile() { return m_tile; }
 
     DataSource& source() { return *m_source; }
@@ -69,6 +75,9 @@ public:
 
 protected:
 
+    // Build m_tile from _tileData, or cancel the task when there is none
+    void buildTile(TileBuilder& _tileBuilder, const TileData* _tileData);
+
     const TileID m_tileId;
 
     const int m_subTaskId;
@@ -88,6 +97,8 @@ protected:
 
     std::atomic<double> m_priority;
     bool m_proxyState = false;
+
+    std::atomic<size_t> m_parsedDataSize{0};
 };
 
 class DownloadTileTask : public TileTask {
@@ -98,6 +109,15 @@ public:
     virtual bool hasData() const override {
         return rawTileData && !rawTileData->empty();
     }
+
+    virtual size_t rawDataSize() const override {
+        // Data shared with the RawCache or the tasks of other tiles is not freed with this task
+        return rawTileData && rawTileData.use_count() == 1 ? rawTileData->size() : 0;
+    }
+
+    // Overzoomed tiles are clipped from the data of their parent tile
+    virtual void process(TileBuilder& _tileBuilder) override;
+
     // Raw tile data that will be processed by DataSource.
     std::shared_ptr<std::vector<char>> rawTileData;
 };
@@ -0,0 +1,263 @@
+#include "compactFeature.h"
+
+#include "data/propertyItem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Tangram {
+
+constexpr float CompactFeature::default_resolution;
+
+namespace Compact {
+
+enum ValueType : uint8_t { none = 0, number = 1, string = 2 };
+
+void writeVarint(uint64_t _value, std::vector<uint8_t>& _out) {
+    while (_value >= 0x80) {
+        _out.push_back(uint8_t(_value) | 0x80);
+        _value >>= 7;
+    }
+    _out.push_back(uint8_t(_value));
+}
+
+uint64_t readVarint(const uint8_t*& _pos) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (*_pos & 0x80) {
+        value |= uint64_t(*_pos++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= uint64_t(*_pos++) << shift;
+    return value;
+}
+
+static void writeString(const std::string& _string, std::vector<uint8_t>& _out) {
+    writeVarint(_string.size(), _out);
+    _out.insert(_out.end(), _string.begin(), _string.end());
+}
+
+static std::string readString(const uint8_t*& _pos) {
+    size_t size = readVarint(_pos);
+    std::string string(reinterpret_cast<const char*>(_pos), size);
+    _pos += size;
+    return string;
+}
+
+void encodePoints(const Point* _points, size_t _count, float _resolution, bool _withZ,
+                  std::vector<uint8_t>& _out) {
+
+    int64_t x = 0, y = 0, z = 0;
+
+    for (size_t i = 0; i < _count; i++) {
+        auto& p = _points[i];
+
+        int64_t qx = std::llround(double(p.x) * _resolution);
+        int64_t qy = std::llround(double(p.y) * _resolution);
+        writeVarint(zigzag(qx - x), _out);
+        writeVarint(zigzag(qy - y), _out);
+        x = qx;
+        y = qy;
+
+        if (_withZ) {
+            int64_t qz = std::llround(double(p.z) * _resolution);
+            writeVarint(zigzag(qz - z), _out);
+            z = qz;
+        }
+    }
+}
+
+Point PointReader::next() {
+    m_x += unzigzag(readVarint(m_pos));
+    m_y += unzigzag(readVarint(m_pos));
+    if (m_withZ) {
+        m_z += unzigzag(readVarint(m_pos));
+    }
+    return Point(float(m_x * m_scale), float(m_y * m_scale), float(m_z * m_scale));
+}
+
+void PropertiesPacker::pack(const Properties& _props, std::vector<uint8_t>& _out) {
+
+    writeVarint(zigzag(_props.sourceId), _out);
+
+    if (_props.isShared()) {
+        auto& dictionary = _props.dictionary();
+        auto it = std::find(m_dictionaries.begin(), m_dictionaries.end(), dictionary);
+        if (it == m_dictionaries.end()) {
+            it = m_dictionaries.insert(it, dictionary);
+        }
+
+        // Dictionary index + 1, zero for owned properties
+        writeVarint(std::distance(m_dictionaries.begin(), it) + 1, _out);
+        writeVarint(_props.tags().size(), _out);
+        for (auto& tag : _props.tags()) {
+            writeVarint(tag.key, _out);
+            writeVarint(tag.value, _out);
+        }
+        return;
+    }
+
+    writeVarint(0, _out);
+    writeVarint(_props.size(), _out);
+
+    _props.forEach([&](const std::string& _key, const Value& _value) {
+        writeString(_key, _out);
+
+        if (_value.is<double>()) {
+            double number = _value.get<double>();
+            _out.push_back(ValueType::number);
+            auto bytes = reinterpret_cast<const uint8_t*>(&number);
+            _out.insert(_out.end(), bytes, bytes + sizeof(double));
+        } else if (_value.is<std::string>()) {
+            _out.push_back(ValueType::string);
+            writeString(_value.get<std::string>(), _out);
+        } else {
+            _out.push_back(ValueType::none);
+        }
+    });
+}
+
+void PropertiesPacker::unpack(const uint8_t* _data, Properties& _props) const {
+
+    const uint8_t* pos = _data;
+
+    int32_t sourceId = unzigzag(readVarint(pos));
+    size_t dictionary = readVarint(pos);
+    size_t count = readVarint(pos);
+
+    if (dictionary > 0) {
+        std::vector<Properties::Tag> tags;
+        tags.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t key = readVarint(pos);
+            uint32_t value = readVarint(pos);
+            tags.push_back({ key, value });
+        }
+        _props.setShared(m_dictionaries[dictionary - 1], std::move(tags));
+        _props.sourceId = sourceId;
+        return;
+    }
+
+    std::vector<Properties::Item> items;
+    items.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+        std::string key = readString(pos);
+
+        switch (*pos++) {
+        case ValueType::number: {
+            double number;
+            std::memcpy(&number, pos, sizeof(double));
+            pos += sizeof(double);
+            items.emplace_back(std::move(key), number);
+            break;
+        }
+        case ValueType::string:
+            items.emplace_back(std::move(key), readString(pos));
+            break;
+        default:
+            items.emplace_back(std::move(key), none_type{});
+            break;
+        }
+    }
+
+    // Packed in key order
+    _props.setSorted(std::move(items));
+    _props.sourceId = sourceId;
+}
+
+size_t PropertiesPacker::memoryUsage() const {
+    return m_dictionaries.capacity() * sizeof(m_dictionaries[0]);
+}
+
+}
+
+CompactFeature::CompactFeature(const Feature& _feature, float _resolution)
+    : m_id(_feature.id),
+      m_resolution(_resolution),
+      m_geometryType(_feature.geometryType) {
+
+    auto writeLine = [&](const Line& _line) {
+        Compact::writeVarint(_line.size(), m_geometry);
+        Compact::encodePoints(_line.data(), _line.size(), m_resolution, true, m_geometry);
+    };
+
+    switch (m_geometryType) {
+    case GeometryType::points:
+        writeLine(_feature.points);
+        break;
+    case GeometryType::lines:
+        Compact::writeVarint(_feature.lines.size(), m_geometry);
+        for (auto& line : _feature.lines) { writeLine(line); }
+        break;
+    case GeometryType::polygons:
+        Compact::writeVarint(_feature.polygons.size(), m_geometry);
+        for (auto& polygon : _feature.polygons) {
+            Compact::writeVarint(polygon.size(), m_geometry);
+            for (auto& ring : polygon) { writeLine(ring); }
+        }
+        break;
+    default:
+        break;
+    }
+
+    m_packer.pack(_feature.props, m_properties);
+
+    m_geometry.shrink_to_fit();
+    m_properties.shrink_to_fit();
+}
+
+Feature CompactFeature::feature() const {
+
+    Feature feature;
+    feature.geometryType = m_geometryType;
+    feature.id = m_id;
+    feature.props = properties();
+
+    const uint8_t* pos = m_geometry.data();
+
+    auto readLine = [&](Line& _line) {
+        size_t count = Compact::readVarint(pos);
+        _line.reserve(count);
+
+        Compact::PointReader reader(pos, m_resolution, true);
+        for (size_t i = 0; i < count; i++) {
+            _line.push_back(reader.next());
+        }
+        pos = reader.position();
+    };
+
+    switch (m_geometryType) {
+    case GeometryType::points:
+        readLine(feature.points);
+        break;
+    case GeometryType::lines:
+        feature.lines.resize(Compact::readVarint(pos));
+        for (auto& line : feature.lines) { readLine(line); }
+        break;
+    case GeometryType::polygons:
+        feature.polygons.resize(Compact::readVarint(pos));
+        for (auto& polygon : feature.polygons) {
+            polygon.resize(Compact::readVarint(pos));
+            for (auto& ring : polygon) { readLine(ring); }
+        }
+        break;
+    default:
+        break;
+    }
+
+    return feature;
+}
+
+Properties CompactFeature::properties() const {
+    Properties props;
+    m_packer.unpack(m_properties.data(), props);
+    return props;
+}
+
+size_t CompactFeature::memoryUsage() const {
+    return sizeof(*this) + m_geometry.capacity() + m_properties.capacity() + m_packer.memoryUsage();
+}
+
+}
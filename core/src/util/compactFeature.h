@@ -0,0 +1,107 @@
+#pragma once
+
+#include "data/tileData.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * Compact encoding of feature data that is retained after building, like the
+ * features of a FeatureIndex or the geometry of a Marker:
+ * - Coordinates are quantized to 1/resolution units and stored as zig-zag
+ *   encoded varint deltas to the previous point.
+ * - Properties are packed into a blob. Properties referencing a shared
+ *   dictionary are packed as their key and value indices.
+ * Both are only decoded on access.
+ */
+namespace Compact {
+
+void writeVarint(uint64_t _value, std::vector<uint8_t>& _out);
+uint64_t readVarint(const uint8_t*& _pos);
+
+inline uint64_t zigzag(int64_t _value) {
+    return (uint64_t(_value) << 1) ^ uint64_t(_value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t _value) {
+    return int64_t(_value >> 1) ^ -int64_t(_value & 1);
+}
+
+/* Append _count points to _out, the z coordinates only when _withZ */
+void encodePoints(const Point* _points, size_t _count, float _resolution, bool _withZ,
+                  std::vector<uint8_t>& _out);
+
+/* Reads the points of one encodePoints() call */
+class PointReader {
+
+public:
+
+    PointReader(const uint8_t* _data, float _resolution, bool _withZ)
+        : m_pos(_data), m_scale(1.0 / _resolution), m_withZ(_withZ) {}
+
+    Point next();
+
+    const uint8_t* position() const { return m_pos; }
+
+private:
+
+    const uint8_t* m_pos;
+    double m_scale;
+    bool m_withZ;
+
+    int64_t m_x = 0;
+    int64_t m_y = 0;
+    int64_t m_z = 0;
+};
+
+/* Packs Properties into blobs, keeping a reference to the dictionaries of shared Properties */
+class PropertiesPacker {
+
+public:
+
+    void pack(const Properties& _props, std::vector<uint8_t>& _out);
+
+    // Unpack the Properties packed at _data
+    void unpack(const uint8_t* _data, Properties& _props) const;
+
+    size_t memoryUsage() const;
+
+private:
+
+    std::vector<std::shared_ptr<const PropertyDictionary>> m_dictionaries;
+};
+
+}
+
+/* A Feature in compact form, materialized on access */
+class CompactFeature {
+
+public:
+
+    static constexpr float default_resolution = 1 << 20;
+
+    CompactFeature(const Feature& _feature, float _resolution = default_resolution);
+
+    GeometryType geometryType() const { return m_geometryType; }
+
+    Feature feature() const;
+
+    Properties properties() const;
+
+    size_t memoryUsage() const;
+
+private:
+
+    std::vector<uint8_t> m_geometry;
+    std::vector<uint8_t> m_properties;
+    Compact::PropertiesPacker m_packer;
+
+    uint64_t m_id = 0;
+    float m_resolution;
+    GeometryType m_geometryType;
+};
+
+}
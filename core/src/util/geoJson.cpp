@@ -2,10 +2,25 @@
 
 #include "platform.h"
 #include "data/propertyItem.h"
+#include "tile/tileID.h"
 #include "glm/glm.hpp"
+#include "rapidjson/encodedstream.h"
+#include "rapidjson/error/en.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
+
+#include <cstring>
 
 namespace Tangram {
 
+GeoJson::TileProjection::TileProjection(const MapProjection& _projection, const TileID& _tileID)
+    : projection(_projection) {
+
+    BoundingBox tileBounds(_projection.TileBounds(_tileID));
+    tileOrigin = {tileBounds.min.x, tileBounds.max.y*-1.0};
+    tileInverseScale = 1.0 / tileBounds.width();
+}
+
 bool GeoJson::isFeatureCollection(const JsonValue& _in) {
 
     // A FeatureCollection must have a "type" of "FeatureCollection"
@@ -87,6 +102,12 @@ Feature GeoJson::getFeature(const JsonValue& _in, const Transform& _proj, int32_
         feature.props = getProperties(properties->value, _sourceId);
     }
 
+    // Only numeric ids can identify the feature across tiles
+    auto id = _in.FindMember("id");
+    if (id != _in.MemberEnd() && id->value.IsUint64()) {
+        feature.id = id->value.GetUint64();
+    }
+
     // Copy geometry into tile data
     const JsonValue& geometry = _in["geometry"];
     const JsonValue& coords = geometry["coordinates"];
@@ -153,4 +174,361 @@ Layer GeoJson::getLayer(const JsonValue& _in, const Transform& _proj, int32_t _s
 
 }
 
+namespace {
+
+// Handler for the events of rapidjson's Reader that adds the features of each
+// FeatureCollection to a Layer as they are read. Members that are not needed
+// for TileData are skipped.
+class TileDataHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, TileDataHandler> {
+
+public:
+
+    TileDataHandler(const GeoJson::TileProjection& _proj, int32_t _sourceId, TileData& _tileData)
+        : m_proj(_proj), m_sourceId(_sourceId), m_tileData(_tileData) {}
+
+    bool Default() { return true; }
+
+    bool Int(int _i) { return number(_i, false, 0); }
+    bool Uint(unsigned _u) { return number(_u, true, _u); }
+    bool Int64(int64_t _i) { return number(double(_i), false, 0); }
+    bool Uint64(uint64_t _u) { return number(double(_u), true, _u); }
+    bool Double(double _d) { return number(_d, false, 0); }
+
+    bool Key(const char* _str, rapidjson::SizeType _length, bool) {
+        if (m_skip == 0) { m_key.assign(_str, _length); }
+        return true;
+    }
+
+    bool String(const char* _str, rapidjson::SizeType _length, bool) {
+        if (m_skip > 0 || m_stack.empty()) { return true; }
+
+        switch (m_stack.back()) {
+        case Context::collection:
+            if (m_key == "type") {
+                m_collections.back().isFeatureCollection =
+                    (_length == 17 && std::strncmp(_str, "FeatureCollection", _length) == 0);
+            }
+            break;
+        case Context::properties:
+            m_items.emplace_back(m_key, std::string(_str, _length));
+            break;
+        case Context::geometry:
+            if (m_key == "type") { m_geometryType.assign(_str, _length); }
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool StartObject() {
+        if (m_skip > 0) {
+            m_skip++;
+            return true;
+        }
+
+        if (m_stack.empty()) {
+            pushCollection("");
+            return true;
+        }
+
+        switch (m_stack.back()) {
+        case Context::collection:
+            // Named FeatureCollections are members of the root object
+            if (m_stack.size() == 1) {
+                pushCollection(m_key);
+                return true;
+            }
+            break;
+        case Context::features:
+            m_feature = Feature(m_sourceId);
+            m_stack.push_back(Context::feature);
+            return true;
+        case Context::feature:
+            if (m_key == "properties") {
+                m_items.clear();
+                m_stack.push_back(Context::properties);
+                return true;
+            }
+            if (m_key == "geometry") {
+                m_geometryType.clear();
+                m_positions.clear();
+                m_lineEnds.clear();
+                m_polygonEnds.clear();
+                m_positionLevel = 0;
+                m_stack.push_back(Context::geometry);
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+
+        m_skip = 1;
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        if (m_skip > 0) {
+            m_skip--;
+            return true;
+        }
+
+        auto context = m_stack.back();
+        m_stack.pop_back();
+
+        switch (context) {
+        case Context::collection: {
+            auto& collection = m_collections.back();
+            if (collection.isFeatureCollection && collection.hasFeatures) {
+                m_tileData.layers.push_back(std::move(collection.layer));
+            }
+            m_collections.pop_back();
+            break;
+        }
+        case Context::feature:
+            m_collections.back().layer.features.push_back(std::move(m_feature));
+            break;
+        case Context::properties:
+            m_feature.props.setSorted(std::move(m_items));
+            m_feature.props.sort();
+            m_items.clear();
+            break;
+        case Context::geometry:
+            buildGeometry();
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool StartArray() {
+        if (m_skip > 0) {
+            m_skip++;
+            return true;
+        }
+
+        if (!m_stack.empty()) {
+            switch (m_stack.back()) {
+            case Context::collection:
+                if (m_key == "features") {
+                    m_collections.back().hasFeatures = true;
+                    m_stack.push_back(Context::features);
+                    return true;
+                }
+                break;
+            case Context::geometry:
+                if (m_key == "coordinates") {
+                    m_level = 1;
+                    m_coordCount = 0;
+                    m_stack.push_back(Context::coordinates);
+                    return true;
+                }
+                break;
+            case Context::coordinates:
+                m_level++;
+                m_coordCount = 0;
+                return true;
+            default:
+                break;
+            }
+        }
+
+        m_skip = 1;
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        if (m_skip > 0) {
+            m_skip--;
+            return true;
+        }
+
+        if (m_stack.back() == Context::coordinates) {
+            if (m_coordCount >= 2) {
+                // The innermost arrays are positions
+                m_positionLevel = m_level;
+                m_positions.push_back(m_proj(glm::dvec2(m_coord[0], m_coord[1])));
+                m_coordCount = 0;
+            } else if (m_level == m_positionLevel - 1) {
+                m_lineEnds.push_back(m_positions.size());
+            } else if (m_level == m_positionLevel - 2) {
+                m_polygonEnds.push_back(m_lineEnds.size());
+            }
+
+            if (--m_level > 0) { return true; }
+        }
+
+        m_stack.pop_back();
+        return true;
+    }
+
+private:
+
+    enum class Context {
+        collection,
+        features,
+        feature,
+        properties,
+        geometry,
+        coordinates,
+    };
+
+    struct Collection {
+        Collection(const std::string& _name) : layer(_name) {}
+
+        Layer layer;
+        bool isFeatureCollection = false;
+        bool hasFeatures = false;
+    };
+
+    bool number(double _value, bool _isUnsigned, uint64_t _unsigned) {
+        if (m_skip > 0 || m_stack.empty()) { return true; }
+
+        switch (m_stack.back()) {
+        case Context::coordinates:
+            if (m_coordCount < 2) { m_coord[m_coordCount] = _value; }
+            m_coordCount++;
+            break;
+        case Context::properties:
+            m_items.emplace_back(m_key, _value);
+            break;
+        case Context::feature:
+            // Only numeric ids can identify the feature across tiles
+            if (_isUnsigned && m_key == "id") { m_feature.id = _unsigned; }
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    void pushCollection(const std::string& _name) {
+        m_collections.emplace_back(_name);
+        m_stack.push_back(Context::collection);
+    }
+
+    Line line(size_t _begin, size_t _end) const {
+        return Line(m_positions.begin() + _begin, m_positions.begin() + _end);
+    }
+
+    Polygon polygon(size_t _beginRing, size_t _endRing) const {
+        Polygon polygon;
+        size_t begin = _beginRing > 0 ? m_lineEnds[_beginRing - 1] : 0;
+        for (size_t ring = _beginRing; ring < _endRing; ring++) {
+            polygon.push_back(line(begin, m_lineEnds[ring]));
+            begin = m_lineEnds[ring];
+        }
+        return polygon;
+    }
+
+    void buildGeometry() {
+        auto& feature = m_feature;
+        const auto& type = m_geometryType;
+
+        if (type == "Point" || type == "MultiPoint") {
+
+            feature.geometryType = GeometryType::points;
+            feature.points = m_positions;
+
+        } else if (type == "LineString") {
+
+            feature.geometryType = GeometryType::lines;
+            feature.lines.push_back(line(0, m_positions.size()));
+
+        } else if (type == "MultiLineString") {
+
+            feature.geometryType = GeometryType::lines;
+            size_t begin = 0;
+            for (size_t end : m_lineEnds) {
+                feature.lines.push_back(line(begin, end));
+                begin = end;
+            }
+
+        } else if (type == "Polygon") {
+
+            feature.geometryType = GeometryType::polygons;
+            feature.polygons.push_back(polygon(0, m_lineEnds.size()));
+
+        } else if (type == "MultiPolygon") {
+
+            feature.geometryType = GeometryType::polygons;
+            size_t begin = 0;
+            for (size_t end : m_polygonEnds) {
+                feature.polygons.push_back(polygon(begin, end));
+                begin = end;
+            }
+        }
+    }
+
+    const GeoJson::TileProjection& m_proj;
+    int32_t m_sourceId;
+    TileData& m_tileData;
+
+    std::vector<Context> m_stack;
+    // Depth within a skipped value
+    int m_skip = 0;
+    std::string m_key;
+
+    std::vector<Collection> m_collections;
+
+    Feature m_feature;
+    std::vector<PropertyItem> m_items;
+
+    // Geometry of m_feature: its positions, the end of each line or ring in
+    // m_positions and the end of each polygon in m_lineEnds
+    std::string m_geometryType;
+    std::vector<Point> m_positions;
+    std::vector<size_t> m_lineEnds;
+    std::vector<size_t> m_polygonEnds;
+
+    // Nesting level within 'coordinates' and that of the positions
+    int m_level = 0;
+    int m_positionLevel = 0;
+
+    double m_coord[2] = { 0, 0 };
+    int m_coordCount = 0;
+};
+
+template<unsigned parseFlags, class Stream>
+bool parseTileDataStream(Stream& _stream, const GeoJson::TileProjection& _proj, int32_t _sourceId,
+                         TileData& _tileData, const char** _error, size_t* _errorOffset) {
+
+    TileDataHandler handler(_proj, _sourceId, _tileData);
+    rapidjson::Reader reader;
+    auto result = reader.Parse<parseFlags>(_stream, handler);
+
+    *_error = nullptr;
+    *_errorOffset = 0;
+    if (result.IsError()) {
+        *_error = rapidjson::GetParseError_En(result.Code());
+        *_errorOffset = result.Offset();
+        _tileData.layers.clear();
+        return false;
+    }
+    return true;
+}
+
+}
+
+bool GeoJson::parseTileData(const char* _bytes, size_t _length, const TileProjection& _proj,
+                            int32_t _sourceId, TileData& _tileData, const char** _error, size_t* _errorOffset) {
+
+    rapidjson::MemoryStream mstream(_bytes, _length);
+    rapidjson::EncodedInputStream<rapidjson::UTF8<char>, rapidjson::MemoryStream> istream(mstream);
+
+    return parseTileDataStream<rapidjson::kParseDefaultFlags>(istream, _proj, _sourceId,
+                                                              _tileData, _error, _errorOffset);
+}
+
+bool GeoJson::parseTileDataInsitu(char* _bytes, const TileProjection& _proj, int32_t _sourceId,
+                                  TileData& _tileData, const char** _error, size_t* _errorOffset) {
+
+    rapidjson::InsituStringStream stream(_bytes);
+
+    return parseTileDataStream<rapidjson::kParseInsituFlag>(stream, _proj, _sourceId,
+                                                            _tileData, _error, _errorOffset);
+}
+
 }
@@ -2,15 +2,48 @@
 
 #include "data/tileData.h"
 #include "util/json.h"
+#include "util/mapProjection.h"
 
 #include <functional>
 
 namespace Tangram {
 
+struct TileID;
+
 namespace GeoJson {
 
 using Transform = std::function<Point(glm::dvec2 _lonLat)>;
 
+/* Projection from longitude and latitude into the coordinates of one tile */
+struct TileProjection {
+
+    TileProjection(const MapProjection& _projection, const TileID& _tileID);
+
+    Point operator()(glm::dvec2 _lonLat) const {
+        glm::dvec2 meters = projection.LonLatToMeters(_lonLat);
+        return Point {
+            (meters.x - tileOrigin.x) * tileInverseScale,
+            (meters.y - tileOrigin.y) * tileInverseScale,
+             0
+        };
+    }
+
+    const MapProjection& projection;
+    glm::dvec2 tileOrigin;
+    double tileInverseScale;
+};
+
+/* Parse a FeatureCollection, or an object of named FeatureCollections, as layers
+ * of _tileData with rapidjson's streaming Reader, without building a document.
+ * On syntax errors no layers are added and _error and _errorOffset are set. */
+bool parseTileData(const char* _bytes, size_t _length, const TileProjection& _proj,
+                   int32_t _sourceId, TileData& _tileData, const char** _error, size_t* _errorOffset);
+
+/* Like parseTileData(), decoding the strings in place: _bytes must be null-terminated
+ * and is overwritten */
+bool parseTileDataInsitu(char* _bytes, const TileProjection& _proj, int32_t _sourceId,
+                         TileData& _tileData, const char** _error, size_t* _errorOffset);
+
 bool isFeatureCollection(const JsonValue& _in);
 
 Point getPoint(const JsonValue& _in, const Transform& _proj);
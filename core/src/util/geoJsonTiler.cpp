@@ -0,0 +1,610 @@
+#include "geoJsonTiler.h"
+
+#include "platform.h"
+#include "data/propertyItem.h"
+#include "tile/tileID.h"
+#include "util/geoJson.h"
+#include "util/geom.h"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Tangram {
+namespace GeoJsonTiler {
+
+using Ring = std::vector<glm::dvec2>;
+
+constexpr int Index::grid_zoom;
+constexpr size_t Index::max_feature_cells;
+
+void ProjectedFeature::setProperties(const Properties& _props) {
+
+    auto dictionary = std::make_shared<PropertyDictionary>();
+    tags.clear();
+
+    _props.forEach([&](const std::string& _key, const Value& _value) {
+        uint32_t index = dictionary->keys.size();
+        dictionary->keys.push_back(_key);
+        dictionary->values.push_back(_value);
+        tags.push_back({ index, index });
+    });
+
+    // Tags are looked up by key like the items of Properties
+    std::sort(tags.begin(), tags.end(), [&](const Properties::Tag& a, const Properties::Tag& b) {
+        return Properties::keyComparator(dictionary->keys[a.key], dictionary->keys[b.key]);
+    });
+
+    properties = std::move(dictionary);
+}
+
+void ProjectedFeature::updateBounds() {
+
+    min = glm::dvec2(std::numeric_limits<double>::max());
+    max = glm::dvec2(std::numeric_limits<double>::lowest());
+
+    for (auto& part : parts) {
+        for (auto& p : part) {
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+        }
+    }
+}
+
+// Lowest zoom whose tolerance, one unit of the tile extent, is below _distance
+static uint8_t zoomForDistance(double _distance) {
+    if (_distance <= 0) { return never_kept; }
+
+    double zoom = std::floor(std::log2(1.0 / (extent * _distance))) + 1;
+    return uint8_t(glm::clamp(zoom, 0.0, double(never_kept - 1)));
+}
+
+static double segmentDistance(const glm::dvec2& _p, const glm::dvec2& _a, const glm::dvec2& _b) {
+    glm::dvec2 ab = _b - _a;
+    double length2 = glm::dot(ab, ab);
+    if (length2 == 0) { return glm::distance(_p, _a); }
+
+    double t = glm::clamp(glm::dot(_p - _a, ab) / length2, 0.0, 1.0);
+    return glm::distance(_p, _a + ab * t);
+}
+
+static void simplifyPart(const Ring& _part, std::vector<uint8_t>& _zooms) {
+
+    _zooms.assign(_part.size(), never_kept);
+    if (_part.empty()) { return; }
+
+    _zooms.front() = 0;
+    _zooms.back() = 0;
+
+    struct Range { size_t first, last; uint8_t zoom; };
+    std::vector<Range> ranges;
+    ranges.push_back({ 0, _part.size() - 1, 0 });
+
+    while (!ranges.empty()) {
+        Range range = ranges.back();
+        ranges.pop_back();
+
+        if (range.last - range.first < 2) { continue; }
+
+        size_t farthest = range.first;
+        double maxDistance = 0;
+        for (size_t i = range.first + 1; i < range.last; i++) {
+            double d = segmentDistance(_part[i], _part[range.first], _part[range.last]);
+            if (d > maxDistance) {
+                maxDistance = d;
+                farthest = i;
+            }
+        }
+        // Vertices of a range that is dropped stay never_kept
+        if (maxDistance <= 0) { continue; }
+
+        // A vertex is only kept with the vertex that split off its range
+        uint8_t zoom = std::max(zoomForDistance(maxDistance), range.zoom);
+        if (zoom == never_kept) { continue; }
+
+        _zooms[farthest] = zoom;
+        ranges.push_back({ range.first, farthest, zoom });
+        ranges.push_back({ farthest, range.last, zoom });
+    }
+}
+
+void ProjectedFeature::simplify() {
+
+    vertexZooms.clear();
+    if (geometryType != GeometryType::lines && geometryType != GeometryType::polygons) {
+        return;
+    }
+
+    vertexZooms.resize(parts.size());
+    for (size_t i = 0; i < parts.size(); i++) {
+        simplifyPart(parts[i], vertexZooms[i]);
+    }
+}
+
+glm::dvec2 project(const LngLat& _lngLat) {
+    double sinLat = std::sin(_lngLat.latitude * PI / 180);
+    double y = 0.5 - 0.25 * std::log((1 + sinLat) / (1 - sinLat)) / PI;
+    return { _lngLat.longitude / 360 + 0.5, glm::clamp(y, 0.0, 1.0) };
+}
+
+static Ring getCoordinates(const JsonValue& _in) {
+
+    Ring ring;
+    if (!_in.IsArray()) { return ring; }
+
+    ring.reserve(_in.Size());
+    for (auto it = _in.Begin(); it != _in.End(); ++it) {
+        if (it->IsArray() && it->Size() >= 2 && (*it)[0].IsNumber() && (*it)[1].IsNumber()) {
+            ring.push_back(project(LngLat((*it)[0].GetDouble(), (*it)[1].GetDouble())));
+        }
+    }
+    return ring;
+}
+
+static void addPolygon(const JsonValue& _in, ProjectedFeature& _feature) {
+
+    if (!_in.IsArray()) { return; }
+
+    uint32_t rings = 0;
+    for (auto it = _in.Begin(); it != _in.End(); ++it) {
+        Ring ring = getCoordinates(*it);
+        if (ring.empty()) { continue; }
+        _feature.parts.push_back(std::move(ring));
+        rings++;
+    }
+    if (rings > 0) { _feature.ringCounts.push_back(rings); }
+}
+
+static bool getGeometry(const JsonValue& _in, ProjectedFeature& _feature) {
+
+    auto type = _in.FindMember("type");
+    auto coords = _in.FindMember("coordinates");
+    if (type == _in.MemberEnd() || !type->value.IsString() ||
+        coords == _in.MemberEnd() || !coords->value.IsArray()) {
+        return false;
+    }
+
+    const char* geometryType = type->value.GetString();
+    const JsonValue& coordinates = coords->value;
+
+    if (std::strcmp(geometryType, "Point") == 0) {
+
+        _feature.geometryType = GeometryType::points;
+        if (coordinates.Size() >= 2 && coordinates[0].IsNumber() && coordinates[1].IsNumber()) {
+            _feature.parts.push_back({ project(LngLat(coordinates[0].GetDouble(),
+                                                      coordinates[1].GetDouble())) });
+        }
+
+    } else if (std::strcmp(geometryType, "MultiPoint") == 0) {
+
+        _feature.geometryType = GeometryType::points;
+        _feature.parts.push_back(getCoordinates(coordinates));
+
+    } else if (std::strcmp(geometryType, "LineString") == 0) {
+
+        _feature.geometryType = GeometryType::lines;
+        _feature.parts.push_back(getCoordinates(coordinates));
+
+    } else if (std::strcmp(geometryType, "MultiLineString") == 0) {
+
+        _feature.geometryType = GeometryType::lines;
+        for (auto it = coordinates.Begin(); it != coordinates.End(); ++it) {
+            _feature.parts.push_back(getCoordinates(*it));
+        }
+
+    } else if (std::strcmp(geometryType, "Polygon") == 0) {
+
+        _feature.geometryType = GeometryType::polygons;
+        addPolygon(coordinates, _feature);
+
+    } else if (std::strcmp(geometryType, "MultiPolygon") == 0) {
+
+        _feature.geometryType = GeometryType::polygons;
+        for (auto it = coordinates.Begin(); it != coordinates.End(); ++it) {
+            addPolygon(*it, _feature);
+        }
+
+    } else {
+        return false;
+    }
+
+    _feature.parts.erase(std::remove_if(_feature.parts.begin(), _feature.parts.end(),
+                                        [](auto& part) { return part.empty(); }),
+                         _feature.parts.end());
+    if (_feature.parts.empty()) { return false; }
+
+    _feature.updateBounds();
+    _feature.simplify();
+    return true;
+}
+
+bool parseFeatures(const std::string& _data, std::vector<ProjectedFeature>& _features) {
+
+    const char* error = nullptr;
+    size_t offset = 0;
+    auto document = JsonParseBytes(_data.c_str(), _data.length(), &error, &offset);
+
+    if (error) {
+        LOGE("Json parsing failed on client data: %s (%u)", error, offset);
+        return false;
+    }
+    if (!document.IsObject()) { return true; }
+
+    auto addFeature = [&](const JsonValue& _in) {
+        if (!_in.IsObject()) { return; }
+
+        auto geometry = _in.FindMember("geometry");
+        if (geometry == _in.MemberEnd() || !geometry->value.IsObject()) { return; }
+
+        ProjectedFeature feature;
+        if (!getGeometry(geometry->value, feature)) { return; }
+
+        auto properties = _in.FindMember("properties");
+        if (properties != _in.MemberEnd() && properties->value.IsObject()) {
+            feature.setProperties(GeoJson::getProperties(properties->value, 0));
+        } else {
+            feature.setProperties(Properties());
+        }
+        _features.push_back(std::move(feature));
+    };
+
+    if (GeoJson::isFeatureCollection(document)) {
+        auto& features = document["features"];
+        for (auto it = features.Begin(); it != features.End(); ++it) {
+            addFeature(*it);
+        }
+        return true;
+    }
+
+    auto type = document.FindMember("type");
+    if (type != document.MemberEnd() && type->value.IsString() &&
+        std::strcmp(type->value.GetString(), "Feature") == 0) {
+        addFeature(document);
+        return true;
+    }
+
+    // A bare geometry
+    ProjectedFeature feature;
+    if (getGeometry(document, feature)) {
+        feature.setProperties(Properties());
+        _features.push_back(std::move(feature));
+    }
+    return true;
+}
+
+namespace {
+
+// From projected coordinates into those of a tile, flipping y to go up
+struct TileTransform {
+
+    TileTransform(const TileID& _tileID) {
+        double size = 1.0 / (1 << _tileID.z);
+        origin = glm::dvec2(_tileID.x, _tileID.y) * size;
+        scale = 1.0 / size;
+    }
+
+    glm::dvec2 operator()(const glm::dvec2& _p) const {
+        return { (_p.x - origin.x) * scale, 1 - (_p.y - origin.y) * scale };
+    }
+
+    glm::dvec2 origin;
+    double scale;
+};
+
+}
+
+// Sutherland-Hodgman step, keep the part of the open ring _in on one side of _value
+static void clipRingSide(const Ring& _in, Ring& _out, int _axis, double _value, bool _keepBelow) {
+    _out.clear();
+    if (_in.empty()) { return; }
+
+    auto inside = [&](const glm::dvec2& p) {
+        return _keepBelow ? p[_axis] <= _value : p[_axis] >= _value;
+    };
+
+    const glm::dvec2* prev = &_in.back();
+    bool prevInside = inside(*prev);
+
+    for (auto& curr : _in) {
+        bool currInside = inside(curr);
+        if (currInside != prevInside) {
+            double t = (_value - (*prev)[_axis]) / (curr[_axis] - (*prev)[_axis]);
+            _out.push_back(*prev + (curr - *prev) * t);
+        }
+        if (currInside) { _out.push_back(curr); }
+
+        prev = &curr;
+        prevInside = currInside;
+    }
+}
+
+// Clip _ring to the square [_min, _max], returns false when less than a triangle remains
+static bool clipRing(const Ring& _ring, double _min, double _max, Ring& _out) {
+    if (_ring.size() < 3) { return false; }
+
+    bool closed = _ring.front() == _ring.back();
+
+    Ring a(_ring.begin(), closed ? _ring.end() - 1 : _ring.end());
+    Ring b;
+
+    clipRingSide(a, b, 0, _min, false);
+    clipRingSide(b, a, 0, _max, true);
+    clipRingSide(a, b, 1, _min, false);
+    clipRingSide(b, a, 1, _max, true);
+
+    if (a.size() < 3) { return false; }
+
+    if (closed) { a.push_back(a.front()); }
+    _out = std::move(a);
+
+    return true;
+}
+
+// Liang-Barsky, narrow [_t0, _t1] to the part of the segment _a-_b within the square
+static bool clipSegment(const glm::dvec2& _a, const glm::dvec2& _b, double _min, double _max,
+                        double& _t0, double& _t1) {
+
+    for (int axis = 0; axis < 2; axis++) {
+        double d = _b[axis] - _a[axis];
+        double p[] = { -d, d };
+        double q[] = { _a[axis] - _min, _max - _a[axis] };
+
+        for (int k = 0; k < 2; k++) {
+            if (p[k] == 0) {
+                if (q[k] < 0) { return false; }
+                continue;
+            }
+            double r = q[k] / p[k];
+            if (p[k] < 0) {
+                _t0 = std::max(_t0, r);
+            } else {
+                _t1 = std::min(_t1, r);
+            }
+        }
+    }
+    return _t0 < _t1;
+}
+
+// Append the parts of _line within the square [_min, _max] to _out
+static void clipLine(const Ring& _line, double _min, double _max, std::vector<Ring>& _out) {
+    Ring part;
+
+    auto flush = [&]() {
+        if (part.size() > 1) { _out.push_back(std::move(part)); }
+        part.clear();
+    };
+
+    for (size_t i = 1; i < _line.size(); i++) {
+        const glm::dvec2& a = _line[i-1];
+        const glm::dvec2& b = _line[i];
+
+        double t0 = 0, t1 = 1;
+        if (!clipSegment(a, b, _min, _max, t0, t1)) {
+            flush();
+            continue;
+        }
+        if (part.empty() || t0 > 0) {
+            flush();
+            part.push_back(a + (b - a) * t0);
+        }
+        part.push_back(a + (b - a) * t1);
+
+        // Leaving the square
+        if (t1 < 1) { flush(); }
+    }
+    flush();
+}
+
+// Append the points of _in rounded to 1/extent, skipping those that fall onto the previous one
+static void appendRounded(const Ring& _in, Line& _out) {
+    for (auto& p : _in) {
+        Point point(float(std::round(p.x * extent) / extent),
+                    float(std::round(p.y * extent) / extent), 0.f);
+        if (_out.empty() || point != _out.back()) {
+            _out.push_back(point);
+        }
+    }
+}
+
+bool cutFeature(const ProjectedFeature& _feature, const TileID& _tileID, Feature& _out) {
+
+    TileTransform transform(_tileID);
+
+    double min = -buffer;
+    double max = 1 + buffer;
+
+    // Bounds in tile coordinates, y is flipped
+    glm::dvec2 boundsMin = transform({ _feature.min.x, _feature.max.y });
+    glm::dvec2 boundsMax = transform({ _feature.max.x, _feature.min.y });
+
+    if (boundsMax.x < min || boundsMax.y < min || boundsMin.x > max || boundsMin.y > max) {
+        return false;
+    }
+    bool partial = boundsMin.x < min || boundsMin.y < min || boundsMax.x > max || boundsMax.y > max;
+
+    int zoom = _tileID.z;
+
+    // Vertices of part _index kept at the zoom of the tile, in tile coordinates
+    auto toTile = [&](size_t _index) {
+        const Ring& part = _feature.parts[_index];
+        const uint8_t* zooms = _feature.vertexZooms.empty() ?
+            nullptr : _feature.vertexZooms[_index].data();
+
+        Ring ring;
+        ring.reserve(part.size());
+        for (size_t i = 0; i < part.size(); i++) {
+            if (zooms && zooms[i] > zoom) { continue; }
+            ring.push_back(transform(part[i]));
+        }
+        return ring;
+    };
+
+    _out.geometryType = _feature.geometryType;
+    _out.id = _feature.id;
+
+    switch (_feature.geometryType) {
+    case GeometryType::points:
+        for (auto& part : _feature.parts) {
+            for (auto& p : part) {
+                glm::dvec2 t = transform(p);
+                // Points belong to the tile itself, y goes up from its bottom edge
+                if (t.x >= 0 && t.x < 1 && t.y > 0 && t.y <= 1) {
+                    _out.points.emplace_back(float(t.x), float(t.y), 0.f);
+                }
+            }
+        }
+        if (_out.points.empty()) { return false; }
+        break;
+
+    case GeometryType::lines:
+        for (size_t i = 0; i < _feature.parts.size(); i++) {
+            std::vector<Ring> pieces;
+            if (partial) {
+                clipLine(toTile(i), min, max, pieces);
+            } else {
+                pieces.push_back(toTile(i));
+            }
+
+            for (auto& piece : pieces) {
+                Line line;
+                appendRounded(piece, line);
+                if (line.size() > 1) { _out.lines.push_back(std::move(line)); }
+            }
+        }
+        if (_out.lines.empty()) { return false; }
+        break;
+
+    case GeometryType::polygons: {
+        size_t first = 0;
+        for (uint32_t count : _feature.ringCounts) {
+            Polygon polygon;
+
+            for (size_t r = first; r < first + count; r++) {
+                Ring ring = toTile(r);
+
+                Ring clipped;
+                if (partial && !clipRing(ring, min, max, clipped)) {
+                    // The outer ring is outside, so are its holes
+                    if (polygon.empty()) { break; }
+                    continue;
+                }
+
+                Line line;
+                appendRounded(partial ? clipped : ring, line);
+
+                bool closed = line.size() > 1 && line.front() == line.back();
+                if (line.size() < (closed ? 4 : 3)) {
+                    if (polygon.empty()) { break; }
+                    continue;
+                }
+                polygon.push_back(std::move(line));
+            }
+            first += count;
+
+            if (!polygon.empty()) { _out.polygons.push_back(std::move(polygon)); }
+        }
+        if (_out.polygons.empty()) { return false; }
+        break;
+    }
+    default:
+        return false;
+    }
+
+    _out.props.setShared(_feature.properties, std::vector<Properties::Tag>(_feature.tags));
+    return true;
+}
+
+// Range of grid cells covered by the area from _min to _max
+static void cellRange(const glm::dvec2& _min, const glm::dvec2& _max,
+                      glm::ivec2& _cellMin, glm::ivec2& _cellMax) {
+
+    const int cells = 1 << Index::grid_zoom;
+
+    auto cell = [&](double _value) {
+        return glm::clamp(int(std::floor(glm::clamp(_value, 0.0, 1.0) * cells)), 0, cells - 1);
+    };
+    _cellMin = { cell(_min.x), cell(_min.y) };
+    _cellMax = { cell(_max.x), cell(_max.y) };
+}
+
+Index::Index(Features _features) : m_features(std::move(_features)) {
+
+    const int cells = 1 << grid_zoom;
+    m_cellOffsets.assign(cells * cells + 1, 0);
+
+    // Count the features of each cell, then fill them in by their offsets
+    for (int pass = 0; pass < 2; pass++) {
+        std::vector<uint32_t> positions;
+        if (pass == 1) {
+            for (size_t i = 1; i < m_cellOffsets.size(); i++) {
+                m_cellOffsets[i] += m_cellOffsets[i - 1];
+            }
+            m_cellFeatures.resize(m_cellOffsets.back());
+            positions.assign(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+        }
+
+        for (uint32_t i = 0; i < m_features.size(); i++) {
+            glm::ivec2 cellMin, cellMax;
+            cellRange(m_features[i]->min, m_features[i]->max, cellMin, cellMax);
+
+            size_t area = size_t(cellMax.x - cellMin.x + 1) * (cellMax.y - cellMin.y + 1);
+            if (area > max_feature_cells) {
+                if (pass == 0) { m_largeFeatures.push_back(i); }
+                continue;
+            }
+
+            for (int y = cellMin.y; y <= cellMax.y; y++) {
+                for (int x = cellMin.x; x <= cellMax.x; x++) {
+                    size_t cell = y * cells + x;
+                    if (pass == 0) {
+                        m_cellOffsets[cell + 1]++;
+                    } else {
+                        m_cellFeatures[positions[cell]++] = i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Index::query(const TileID& _tileID, std::vector<const ProjectedFeature*>& _out) const {
+
+    if (m_features.empty()) { return; }
+
+    double size = 1.0 / (1 << _tileID.z);
+    glm::dvec2 min = glm::dvec2(_tileID.x, _tileID.y) * size - buffer * size;
+    glm::dvec2 max = glm::dvec2(_tileID.x + 1, _tileID.y + 1) * size + buffer * size;
+
+    glm::ivec2 cellMin, cellMax;
+    cellRange(min, max, cellMin, cellMax);
+
+    const int cells = 1 << grid_zoom;
+
+    std::vector<uint32_t> candidates(m_largeFeatures);
+    for (int y = cellMin.y; y <= cellMax.y; y++) {
+        for (int x = cellMin.x; x <= cellMax.x; x++) {
+            size_t cell = y * cells + x;
+            candidates.insert(candidates.end(),
+                              m_cellFeatures.begin() + m_cellOffsets[cell],
+                              m_cellFeatures.begin() + m_cellOffsets[cell + 1]);
+        }
+    }
+
+    // Features spanning several cells are listed in each
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (uint32_t i : candidates) {
+        auto& feature = *m_features[i];
+        if (feature.min.x <= max.x && feature.max.x >= min.x &&
+            feature.min.y <= max.y && feature.max.y >= min.y) {
+            _out.push_back(&feature);
+        }
+    }
+}
+
+}
+}
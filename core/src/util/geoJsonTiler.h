@@ -0,0 +1,108 @@
+#pragma once
+
+#include "data/properties.h"
+#include "data/tileData.h"
+#include "util/types.h"
+
+#include "glm/vec2.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Tangram {
+
+struct TileID;
+struct PropertyDictionary;
+
+/*
+ * GeoJsonTiler - Cuts tiles from client-side features. Features are kept in projected
+ * coordinates, from 0 to 1 with y going down like TileIDs, in an Index that is not
+ * modified after it was built, so that any number of tile workers can query it and
+ * cut their tiles at the same time. Tiles are output as Tangram Features directly.
+ */
+namespace GeoJsonTiler {
+
+// Buffer around each tile, in tile units
+constexpr double buffer = 1.0 / 64;
+
+// Tile coordinates are rounded to 1/extent, collapsing vertices that fall together
+constexpr double extent = 4096;
+
+// Zoom of the vertices that no simplification keeps
+constexpr uint8_t never_kept = 255;
+
+struct ProjectedFeature {
+    uint64_t id = 0;
+    GeometryType geometryType = GeometryType::unknown;
+
+    // The points, the line strings or the rings of all polygons
+    std::vector<std::vector<glm::dvec2>> parts;
+    // Number of rings of each polygon, starting with its outer ring
+    std::vector<uint32_t> ringCounts;
+    // Lowest zoom at which each vertex of the parts is kept, empty to keep all of them
+    std::vector<std::vector<uint8_t>> vertexZooms;
+
+    // Properties of the feature, referenced by the Features of all its tiles
+    std::shared_ptr<const PropertyDictionary> properties;
+    std::vector<Properties::Tag> tags;
+
+    glm::dvec2 min;
+    glm::dvec2 max;
+
+    void setProperties(const Properties& _props);
+
+    // Update min and max from the parts
+    void updateBounds();
+
+    // Douglas-Peucker simplification of lines and rings at the tolerance of each zoom,
+    // one unit of the tile extent, into vertexZooms
+    void simplify();
+};
+
+glm::dvec2 project(const LngLat& _lngLat);
+
+/* Parse a FeatureCollection, a Feature or a geometry, returns false on syntax errors */
+bool parseFeatures(const std::string& _data, std::vector<ProjectedFeature>& _features);
+
+/* Cut the part of _feature within the buffered area of _tileID into _out, in the
+ * coordinates of the tile and simplified for its zoom. Returns false when nothing
+ * of it remains. */
+bool cutFeature(const ProjectedFeature& _feature, const TileID& _tileID, Feature& _out);
+
+/* Grid of the bounds of a set of features, read-only once built */
+class Index {
+
+public:
+
+    using Features = std::vector<std::shared_ptr<const ProjectedFeature>>;
+
+    // Cells of the grid are the tiles of this zoom level
+    static constexpr int grid_zoom = 6;
+    // Features spanning more cells are tested on each query instead
+    static constexpr size_t max_feature_cells = 64;
+
+    explicit Index(Features _features);
+
+    /* Append the features whose bounds intersect the buffered area of _tileID,
+     * in the order they were passed to the Index */
+    void query(const TileID& _tileID, std::vector<const ProjectedFeature*>& _out) const;
+
+    bool empty() const { return m_features.empty(); }
+
+    size_t size() const { return m_features.size(); }
+
+private:
+
+    Features m_features;
+
+    // Start of the features of each cell in m_cellFeatures, followed by the end of the last
+    std::vector<uint32_t> m_cellOffsets;
+    std::vector<uint32_t> m_cellFeatures;
+    std::vector<uint32_t> m_largeFeatures;
+};
+
+}
+
+}
@@ -72,6 +72,49 @@ glm::vec4 worldToClipSpace(const glm::mat4& _mvp, const glm::vec4& _worldPositio
     return _mvp * _worldPosition;
 }
 
+void worldToClipSpace(const glm::mat4& _mvp, const float* _x, const float* _y, size_t _count,
+                      float* _clipX, float* _clipY, float* _clipW) {
+
+    // Columns of the matrix that contribute to x, y and w when z = 0 and w = 1
+    const float m00 = _mvp[0][0], m10 = _mvp[1][0], m30 = _mvp[3][0];
+    const float m01 = _mvp[0][1], m11 = _mvp[1][1], m31 = _mvp[3][1];
+    const float m03 = _mvp[0][3], m13 = _mvp[1][3], m33 = _mvp[3][3];
+
+    for (size_t i = 0; i < _count; i++) {
+        float x = _x[i];
+        float y = _y[i];
+        _clipX[i] = m00 * x + m10 * y + m30;
+        _clipY[i] = m01 * x + m11 * y + m31;
+        _clipW[i] = m03 * x + m13 * y + m33;
+    }
+}
+
+bool isOutsideFrustum(const glm::mat4& _mvp, const BoundingBox3& _box) {
+
+    // Count the corners outside of each side plane: left, right, bottom, top. Near and far
+    // are not tested since styles may offset the depth of vertices in the shader.
+    int outside[4] = { 0 };
+
+    for (int i = 0; i < 8; i++) {
+        glm::vec4 corner((i & 1) ? _box.max.x : _box.min.x,
+                         (i & 2) ? _box.max.y : _box.min.y,
+                         (i & 4) ? _box.max.z : _box.min.z,
+                         1.f);
+
+        glm::vec4 clip = _mvp * corner;
+
+        if (clip.x < -clip.w) { outside[0]++; }
+        if (clip.x >  clip.w) { outside[1]++; }
+        if (clip.y < -clip.w) { outside[2]++; }
+        if (clip.y >  clip.w) { outside[3]++; }
+    }
+
+    for (int plane = 0; plane < 4; plane++) {
+        if (outside[plane] == 8) { return true; }
+    }
+    return false;
+}
+
 glm::vec2 clipToScreenSpace(const glm::vec4& _clipCoords, const glm::vec2& _screenSize) {
     glm::vec2 halfScreen = glm::vec2(_screenSize * 0.5f);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "glm/glm.hpp"
+#include <limits>
 #include <vector>
 
 #ifndef PI
@@ -72,6 +73,25 @@ struct BoundingBox {
     }
 };
 
+/* Axis-aligned box in 3D, empty until a point is added */
+struct BoundingBox3 {
+
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+    bool isEmpty() const { return min.x > max.x; }
+    void expand(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void inflate(const glm::vec3& d) {
+        if (isEmpty()) { return; }
+        min -= d;
+        max += d;
+    }
+    void clear() { *this = BoundingBox3(); }
+};
+
 template<class InputIt>
 float signedArea(InputIt _begin, InputIt _end) {
     if (_begin == _end) { return 0; }
@@ -97,6 +117,17 @@ float angleBetweenPoints(const glm::vec2& _p1, const glm::vec2& _p2);
 /* Computes the clip coordinates from position in world space and a model view matrix */
 glm::vec4 worldToClipSpace(const glm::mat4& _mvp, const glm::vec4& _worldPosition);
 
+/* Computes the clip coordinates x, y and w of _count positions on the plane z = 0, stored as
+ * separate arrays of x and y so that the compiler can vectorize the loop
+ */
+void worldToClipSpace(const glm::mat4& _mvp, const float* _x, const float* _y, size_t _count,
+                      float* _clipX, float* _clipY, float* _clipW);
+
+/* Returns true when the box transformed by _mvp lies completely outside of one of the
+ * frustum planes; boxes that pass may still be invisible (the test is conservative)
+ */
+bool isOutsideFrustum(const glm::mat4& _mvp, const BoundingBox3& _box);
+
 /* Computes the screen coordinates from a coordinate in clip space and a screen size */
 glm::vec2 clipToScreenSpace(const glm::vec4& _clipCoords, const glm::vec2& _screenSize);
 
@@ -27,14 +27,17 @@ namespace Tangram {
 
 InputHandler::InputHandler(View& _view) : m_view(_view) {}
 
-void InputHandler::update(float _dt) {
+bool InputHandler::isFlinging() const {
 
     auto velocityPanPixels = m_view.pixelsPerMeter() / m_view.pixelScale() * m_velocityPan;
 
-    bool isFlinging = glm::length(velocityPanPixels) > THRESHOLD_STOP_PAN ||
-                      std::abs(m_velocityZoom) > THRESHOLD_STOP_ZOOM;
+    return glm::length(velocityPanPixels) > THRESHOLD_STOP_PAN ||
+           std::abs(m_velocityZoom) > THRESHOLD_STOP_ZOOM;
+}
 
-    if (isFlinging) {
+void InputHandler::update(float _dt) {
+
+    if (isFlinging()) {
 
         m_velocityPan -= _dt * DAMPING_PAN * m_velocityPan;
         m_view.translate(_dt * m_velocityPan.x, _dt * m_velocityPan.y);
@@ -46,6 +49,20 @@ void InputHandler::update(float _dt) {
     }
 }
 
+bool InputHandler::predictFling(float _seconds, View& _view) const {
+
+    if (!isFlinging()) { return false; }
+
+    // Integral of the exponentially decaying velocity over _seconds
+    float pan = (1.f - std::exp(-DAMPING_PAN * _seconds)) / DAMPING_PAN;
+    float zoom = (1.f - std::exp(-DAMPING_ZOOM * _seconds)) / DAMPING_ZOOM;
+
+    _view.translate(pan * m_velocityPan.x, pan * m_velocityPan.y);
+    _view.zoom(zoom * m_velocityZoom);
+
+    return true;
+}
+
 void InputHandler::handleTapGesture(float _posX, float _posY) {
 
     onGesture();
@@ -23,12 +23,18 @@ public:
 
     void cancelFling();
 
+    /* Apply to _view the motion of the current fling over the next _seconds,
+     * returns false when not flinging */
+    bool predictFling(float _seconds, View& _view) const;
+
     void setView(View& _view) { m_view = _view; }
 
 private:
 
     void setVelocity(float _zoom, glm::vec2 _pan);
 
+    bool isFlinging() const;
+
     void onGesture();
 
     View& m_view;
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * ConcurrentLruCache - Least recently used cache that can be shared between threads.
+ * Entries are distributed over Stripes by their hash, each with its own lock and
+ * its share of the capacity, so that threads rarely wait on each other. The capacity
+ * is in units of the cost of the entries, by default one for each entry.
+ * Evicted values are handed back to the caller, to release resources they hold
+ * after the cache lock was released.
+ */
+template<class Key, class Value, class Hash = std::hash<Key>, size_t Stripes = 8>
+class ConcurrentLruCache {
+
+public:
+
+    ConcurrentLruCache(size_t _capacity)
+        : m_stripeCapacity(std::max(_capacity / Stripes, size_t(1))) {}
+
+    ConcurrentLruCache(const ConcurrentLruCache&) = delete;
+    ConcurrentLruCache& operator=(const ConcurrentLruCache&) = delete;
+
+    // Call _use with the cached value of _key while the entry is locked,
+    // returns false when there is none
+    template<class F>
+    bool get(const Key& _key, F _use) {
+        size_t hash = m_hash(_key);
+        auto& stripe = m_stripes[hash % Stripes];
+
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+
+        auto it = stripe.map.find(_key);
+        if (it == stripe.map.end()) {
+            m_misses++;
+            return false;
+        }
+
+        // Move to front
+        stripe.list.splice(stripe.list.begin(), stripe.list, it->second);
+        m_hits++;
+
+        _use(static_cast<const Value&>(it->second->value));
+        return true;
+    }
+
+    // Add _value for _key at _cost, a value that was already cached for _key or
+    // those least recently used beyond the capacity are moved to _evicted. The
+    // value just added is kept even when it alone exceeds the capacity.
+    void put(const Key& _key, Value _value, std::vector<Value>& _evicted, size_t _cost = 1) {
+        size_t hash = m_hash(_key);
+        auto& stripe = m_stripes[hash % Stripes];
+
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+
+        auto it = stripe.map.find(_key);
+        if (it != stripe.map.end()) {
+            stripe.cost -= it->second->cost;
+            _evicted.push_back(std::move(it->second->value));
+            stripe.list.erase(it->second);
+            stripe.map.erase(it);
+        }
+
+        stripe.list.push_front({ _key, std::move(_value), _cost });
+        stripe.map.emplace(_key, stripe.list.begin());
+        stripe.cost += _cost;
+
+        while (stripe.cost > m_stripeCapacity && stripe.list.size() > 1) {
+            auto& last = stripe.list.back();
+            stripe.cost -= last.cost;
+            _evicted.push_back(std::move(last.value));
+            stripe.map.erase(last.key);
+            stripe.list.pop_back();
+        }
+    }
+
+    // Move all values to _evicted
+    void clear(std::vector<Value>& _evicted) {
+        for (auto& stripe : m_stripes) {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            for (auto& entry : stripe.list) {
+                _evicted.push_back(std::move(entry.value));
+            }
+            stripe.list.clear();
+            stripe.map.clear();
+            stripe.cost = 0;
+        }
+    }
+
+    size_t size() {
+        size_t size = 0;
+        for (auto& stripe : m_stripes) {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            size += stripe.list.size();
+        }
+        return size;
+    }
+
+    // Sum of the costs of the cached values
+    size_t cost() {
+        size_t cost = 0;
+        for (auto& stripe : m_stripes) {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            cost += stripe.cost;
+        }
+        return cost;
+    }
+
+    size_t hits() const { return m_hits; }
+    size_t misses() const { return m_misses; }
+
+private:
+
+    struct Entry {
+        Key key;
+        Value value;
+        size_t cost;
+    };
+    using List = std::list<Entry>;
+
+    struct Stripe {
+        std::mutex mutex;
+        List list;
+        std::unordered_map<Key, typename List::iterator, Hash> map;
+        size_t cost = 0;
+    };
+
+    const size_t m_stripeCapacity;
+    Hash m_hash;
+
+    std::array<Stripe, Stripes> m_stripes;
+
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+};
+
+}
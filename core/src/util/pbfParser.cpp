@@ -87,15 +87,19 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
 
     Feature feature(_ctx.sourceId);
 
+    auto& keys = _ctx.dictionary->keys;
+    auto& values = _ctx.dictionary->values;
+
     _ctx.featureTags.clear();
-    _ctx.featureTags.assign(_ctx.keys.size(), -1);
+    _ctx.featureTags.assign(keys.size(), -1);
+
+    size_t numTags = 0;
 
 
     while(_featureIn.next()) {
         switch(_featureIn.tag) {
             case FEATURE_ID:
-                // ignored for now, also not used in json parsing
-                _featureIn.skip();
+                feature.id = _featureIn.varint();
                 break;
 
             case FEATURE_TAGS: {
@@ -104,7 +108,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
                 while(tagsMsg) {
                     auto tagKey = tagsMsg.varint();
 
-                    if(_ctx.keys.size() <= tagKey) {
+                    if(keys.size() <= tagKey) {
                         LOGE("accessing out of bound key");
                         return feature;
                     }
@@ -116,12 +120,13 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
 
                     auto valueKey = tagsMsg.varint();
 
-                    if( _ctx.values.size() <= valueKey ) {
+                    if( values.size() <= valueKey ) {
                         LOGE("accessing out of bound values");
                         return feature;
                     }
 
                     _ctx.featureTags[tagKey] = valueKey;
+                    numTags++;
                 }
                 break;
             }
@@ -139,16 +144,17 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
         }
     }
 
-    std::vector<Properties::Item> properties;
-    properties.reserve(_ctx.featureTags.size());
+    // Reference the layer keys and values instead of copying them
+    std::vector<Properties::Tag> tags;
+    tags.reserve(numTags);
 
     for (int tagKey : _ctx.orderedKeys) {
         int tagValue = _ctx.featureTags[tagKey];
         if (tagValue >= 0) {
-            properties.emplace_back(_ctx.keys[tagKey], _ctx.values[tagValue]);
+            tags.push_back({ uint32_t(tagKey), uint32_t(tagValue) });
         }
     }
-    feature.props.setSorted(std::move(properties));
+    feature.props.setShared(_ctx.dictionary, std::move(tags));
 
     switch(feature.geometryType) {
         case GeometryType::points:
@@ -217,10 +223,13 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
 
     Layer layer("");
 
-    _ctx.keys.clear();
-    _ctx.values.clear();
+    // Features of the previous layer keep their dictionary
+    _ctx.dictionary = std::make_shared<PropertyDictionary>();
     _ctx.featureMsgs.clear();
 
+    auto& keys = _ctx.dictionary->keys;
+    auto& values = _ctx.dictionary->values;
+
     bool lastWasFeature = false;
     size_t numFeatures = 0;
     protobuf::message featureItr;
@@ -243,7 +252,7 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
                 continue;
             }
             case LAYER_KEY: {
-                _ctx.keys.push_back(_layerIn.string());
+                keys.push_back(_layerIn.string());
                 break;
             }
             case LAYER_VALUE: {
@@ -252,28 +261,28 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
                 while (valueItr.next()) {
                     switch (valueItr.tag) {
                         case 1: // string value
-                            _ctx.values.push_back(valueItr.string());
+                            values.push_back(valueItr.string());
                             break;
                         case 2: // float value
-                            _ctx.values.push_back(valueItr.float32());
+                            values.push_back(valueItr.float32());
                             break;
                         case 3: // double value
-                            _ctx.values.push_back(valueItr.float64());
+                            values.push_back(valueItr.float64());
                             break;
                         case 4: // int value
-                            _ctx.values.push_back(valueItr.int64());
+                            values.push_back(valueItr.int64());
                             break;
                         case 5: // uint value
-                            _ctx.values.push_back(valueItr.varint());
+                            values.push_back(valueItr.varint());
                             break;
                         case 6: // sint value
-                            _ctx.values.push_back(valueItr.int64());
+                            values.push_back(valueItr.int64());
                             break;
                         case 7: // bool value
-                            _ctx.values.push_back(valueItr.boolean());
+                            values.push_back(valueItr.boolean());
                             break;
                         default:
-                            _ctx.values.push_back(none_type{});
+                            values.push_back(none_type{});
                             valueItr.skip();
                             break;
                     }
@@ -295,15 +304,15 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
 
     //// Assign ordering to keys for faster sorting
     _ctx.orderedKeys.clear();
-    _ctx.orderedKeys.reserve(_ctx.keys.size());
+    _ctx.orderedKeys.reserve(keys.size());
     // assign key ids
-    for (int i = 0, n = _ctx.keys.size(); i < n; i++) {
+    for (int i = 0, n = keys.size(); i < n; i++) {
         _ctx.orderedKeys.push_back(i);
     }
     // sort by Property key ordering
     std::sort(_ctx.orderedKeys.begin(), _ctx.orderedKeys.end(),
               [&](int a, int b) {
-                  return Properties::keyComparator(_ctx.keys[a], _ctx.keys[b]);
+                  return Properties::keyComparator(keys[a], keys[b]);
               });
 
     layer.features.reserve(numFeatures);
@@ -4,12 +4,14 @@
 #include "pbf/pbf.hpp"
 #include "util/variant.h"
 
+#include <memory>
 #include <vector>
 #include <string>
 
 namespace Tangram {
 
 class Tile;
+struct PropertyDictionary;
 
 namespace PbfParser {
 
@@ -22,8 +24,8 @@ namespace PbfParser {
         ParserContext(int32_t _sourceId) : sourceId(_sourceId){}
 
         int32_t sourceId;
-        std::vector<std::string> keys;
-        std::vector<Value> values;
+        // Keys and values of the current layer, shared by the Properties of its features
+        std::shared_ptr<PropertyDictionary> dictionary;
         std::vector<protobuf::message> featureMsgs;
         Geometry geometry;
         // Map Key ID -> Tag values
@@ -0,0 +1,232 @@
+#include "tileClip.h"
+
+#include "data/propertyItem.h"
+#include "tile/tileID.h"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace Tangram {
+namespace TileClip {
+
+Transform::Transform(const TileID& _tileID, const TileID& _descendantID) {
+    int32_t over = _descendantID.z - _tileID.z;
+
+    scale = float(1 << over);
+
+    // Position of the descendant within the tile, TileID y goes down from the top
+    offsetX = _descendantID.x - (_tileID.x << over);
+    offsetY = scale - 1 - (_descendantID.y - (_tileID.y << over));
+}
+
+static Point lerp(const Point& _a, const Point& _b, float _t) {
+    return _a + (_b - _a) * _t;
+}
+
+// Sutherland-Hodgman step, keep the part of the open ring _in on one side of _value
+static void clipRingSide(const Line& _in, Line& _out, int _axis, float _value, bool _keepBelow) {
+    _out.clear();
+    if (_in.empty()) { return; }
+
+    auto inside = [&](const Point& p) {
+        return _keepBelow ? p[_axis] <= _value : p[_axis] >= _value;
+    };
+
+    const Point* prev = &_in.back();
+    bool prevInside = inside(*prev);
+
+    for (auto& curr : _in) {
+        bool currInside = inside(curr);
+        if (currInside != prevInside) {
+            float t = (_value - (*prev)[_axis]) / (curr[_axis] - (*prev)[_axis]);
+            _out.push_back(lerp(*prev, curr, t));
+        }
+        if (currInside) { _out.push_back(curr); }
+
+        prev = &curr;
+        prevInside = currInside;
+    }
+}
+
+bool clipRing(const Line& _ring, float _min, float _max, Line& _out) {
+    if (_ring.size() < 3) { return false; }
+
+    bool closed = _ring.front() == _ring.back();
+
+    Line a(_ring.begin(), closed ? _ring.end() - 1 : _ring.end());
+    Line b;
+
+    clipRingSide(a, b, 0, _min, false);
+    clipRingSide(b, a, 0, _max, true);
+    clipRingSide(a, b, 1, _min, false);
+    clipRingSide(b, a, 1, _max, true);
+
+    if (a.size() < 3) { return false; }
+
+    if (closed) { a.push_back(a.front()); }
+    _out = std::move(a);
+
+    return true;
+}
+
+// Liang-Barsky, narrow [_t0, _t1] to the part of the segment _a-_b within the square
+static bool clipSegment(const Point& _a, const Point& _b, float _min, float _max,
+                        float& _t0, float& _t1) {
+
+    for (int axis = 0; axis < 2; axis++) {
+        float d = _b[axis] - _a[axis];
+        float p[] = { -d, d };
+        float q[] = { _a[axis] - _min, _max - _a[axis] };
+
+        for (int k = 0; k < 2; k++) {
+            if (p[k] == 0) {
+                if (q[k] < 0) { return false; }
+                continue;
+            }
+            float r = q[k] / p[k];
+            if (p[k] < 0) {
+                _t0 = std::max(_t0, r);
+            } else {
+                _t1 = std::min(_t1, r);
+            }
+        }
+    }
+    return _t0 < _t1;
+}
+
+void clipLine(const Line& _line, float _min, float _max, std::vector<Line>& _out) {
+    Line part;
+
+    auto flush = [&]() {
+        if (part.size() > 1) { _out.push_back(std::move(part)); }
+        part.clear();
+    };
+
+    for (size_t i = 1; i < _line.size(); i++) {
+        const Point& a = _line[i-1];
+        const Point& b = _line[i];
+
+        float t0 = 0, t1 = 1;
+        if (!clipSegment(a, b, _min, _max, t0, t1)) {
+            flush();
+            continue;
+        }
+        if (part.empty() || t0 > 0) {
+            flush();
+            part.push_back(lerp(a, b, t0));
+        }
+        part.push_back(lerp(a, b, t1));
+
+        // Leaving the square
+        if (t1 < 1) { flush(); }
+    }
+    flush();
+}
+
+// Transform _lines, returns false when all of them are outside the square
+// and true when all are inside. Otherwise _partial is set.
+static bool transformLines(std::vector<Line>& _lines, const Transform& _transform,
+                           float _min, float _max, bool& _partial) {
+
+    glm::vec2 min(std::numeric_limits<float>::max());
+    glm::vec2 max(std::numeric_limits<float>::lowest());
+
+    for (auto& line : _lines) {
+        for (auto& point : line) {
+            point = _transform(point);
+            min = glm::min(min, glm::vec2(point));
+            max = glm::max(max, glm::vec2(point));
+        }
+    }
+
+    if (max.x < _min || max.y < _min || min.x > _max || min.y > _max) {
+        return false;
+    }
+    _partial = min.x < _min || min.y < _min || max.x > _max || max.y > _max;
+    return true;
+}
+
+std::shared_ptr<TileData> clipToDescendant(const TileData& _tileData, const TileID& _tileID,
+                                           const TileID& _descendantID, float _lineBuffer) {
+
+    auto tileData = std::make_shared<TileData>();
+    Transform transform(_tileID, _descendantID);
+
+    float min = -_lineBuffer;
+    float max = 1 + _lineBuffer;
+
+    for (auto& layer : _tileData.layers) {
+        tileData->layers.emplace_back(layer.name);
+        auto& features = tileData->layers.back().features;
+
+        for (auto& feature : layer.features) {
+            Feature clipped;
+            clipped.geometryType = feature.geometryType;
+            clipped.id = feature.id;
+
+            switch (feature.geometryType) {
+            case GeometryType::points:
+                for (auto& point : feature.points) {
+                    Point p = transform(point);
+                    if (p.x >= 0 && p.x < 1 && p.y >= 0 && p.y < 1) {
+                        clipped.points.push_back(p);
+                    }
+                }
+                if (clipped.points.empty()) { continue; }
+                break;
+
+            case GeometryType::lines: {
+                std::vector<Line> lines = feature.lines;
+                bool partial = false;
+                if (!transformLines(lines, transform, min, max, partial)) { continue; }
+
+                if (partial) {
+                    for (auto& line : lines) { clipLine(line, min, max, clipped.lines); }
+                    if (clipped.lines.empty()) { continue; }
+                } else {
+                    clipped.lines = std::move(lines);
+                }
+                break;
+            }
+            case GeometryType::polygons:
+                for (auto& polygon : feature.polygons) {
+                    Polygon rings = polygon;
+                    bool partial = false;
+                    if (!transformLines(rings, transform, 0, 1, partial)) { continue; }
+
+                    if (!partial) {
+                        clipped.polygons.push_back(std::move(rings));
+                        continue;
+                    }
+
+                    Polygon out;
+                    for (auto& ring : rings) {
+                        Line clippedRing;
+                        if (clipRing(ring, 0, 1, clippedRing)) {
+                            out.push_back(std::move(clippedRing));
+                        } else if (out.empty()) {
+                            // The outer ring is outside, so are its holes
+                            break;
+                        }
+                    }
+                    if (!out.empty()) { clipped.polygons.push_back(std::move(out)); }
+                }
+                if (clipped.polygons.empty()) { continue; }
+                break;
+
+            default:
+                continue;
+            }
+
+            clipped.props = feature.props;
+            features.push_back(std::move(clipped));
+        }
+    }
+
+    return tileData;
+}
+
+}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "data/tileData.h"
+
+#include <memory>
+
+namespace Tangram {
+
+struct TileID;
+
+namespace TileClip {
+
+/* Transform from the coordinates of a tile into those of one of its descendants */
+struct Transform {
+
+    Transform(const TileID& _tileID, const TileID& _descendantID);
+
+    Point operator()(const Point& _p) const {
+        return { _p.x * scale - offsetX, _p.y * scale - offsetY, _p.z * scale };
+    }
+
+    float scale;
+    float offsetX;
+    float offsetY;
+};
+
+/* Clip the features of _tileData, parsed for _tileID, to the area of its descendant
+ * _descendantID and transform them into the tile coordinates of the descendant. Lines
+ * are clipped to the area extended by _lineBuffer. Polygons are clipped at the edges of
+ * the descendant, so that neighbouring tiles do not draw the same fill or extrude walls
+ * at the cuts. Points are only kept within the area of the descendant itself. */
+std::shared_ptr<TileData> clipToDescendant(const TileData& _tileData, const TileID& _tileID,
+                                           const TileID& _descendantID, float _lineBuffer);
+
+/* Clip the polygon ring _ring to the square [_min, _max], returns false when less
+ * than a triangle remains. The result is closed when _ring was closed. */
+bool clipRing(const Line& _ring, float _min, float _max, Line& _out);
+
+/* Append the parts of _line within the square [_min, _max] to _out */
+void clipLine(const Line& _line, float _min, float _max, std::vector<Line>& _out);
+
+}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * WorkerPool - Threads that run the iterations of a loop together with the calling
+ * thread. Meant for short data-parallel passes on the main thread, where the cost of
+ * queuing a task per iteration would outweigh the work.
+ */
+class WorkerPool {
+
+public:
+
+    WorkerPool(size_t _numWorkers) {
+        for (size_t i = 0; i < _numWorkers; i++) {
+            m_threads.emplace_back(&WorkerPool::run, this);
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+        m_condition.notify_all();
+        for (auto& thread : m_threads) { thread.join(); }
+    }
+
+    // Number of threads sharing the iterations, including the calling thread
+    size_t concurrency() const { return m_threads.size() + 1; }
+
+    // Call _fn for each index in [0, _count) and return when all calls completed.
+    // Calls for different indices may run concurrently.
+    void forEach(size_t _count, const std::function<void(size_t)>& _fn) {
+        if (m_threads.empty() || _count < 2) {
+            for (size_t i = 0; i < _count; i++) { _fn(i); }
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_fn = &_fn;
+            m_count = _count;
+            m_next = 0;
+            m_active = m_threads.size();
+            m_generation++;
+        }
+        m_condition.notify_all();
+
+        work();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait(lock, [&]{ return m_active == 0; });
+        m_fn = nullptr;
+    }
+
+private:
+
+    void work() {
+        size_t i;
+        while ((i = m_next++) < m_count) { (*m_fn)(i); }
+    }
+
+    void run() {
+        size_t generation = 0;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [&]{ return !m_running || m_generation != generation; });
+                if (!m_running) { break; }
+
+                generation = m_generation;
+            }
+
+            work();
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (--m_active == 0) { m_finished.notify_one(); }
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_finished;
+
+    bool m_running = true;
+    size_t m_generation = 0;
+    size_t m_active = 0;
+
+    const std::function<void(size_t)>* m_fn = nullptr;
+    size_t m_count = 0;
+    std::atomic<size_t> m_next{0};
+};
+
+}
@@ -1,4 +1,13 @@
 #include "gl.h"
+#include "gl_mock.h"
+
+namespace GLMock {
+
+Calls calls;
+
+static GLuint s_nextHandle = 1;
+
+}
 
 extern "C" {
 
@@ -33,33 +42,48 @@ extern "C" {
     void glViewport( GLint x, GLint y, GLsizei width, GLsizei height ){}
     void glLineWidth( GLfloat width ){}
 
-    void glDeleteProgram (GLuint program) {}
+    void glDeleteProgram (GLuint program) { GLMock::calls.deleteProgram++; }
     void glDeleteShader (GLuint shader) {}
 
-    GLuint glCreateShader (GLenum type) { return 0; }
-    GLuint glCreateProgram () { return 0; }
+    GLuint glCreateShader (GLenum type) { return GLMock::s_nextHandle++; }
+    GLuint glCreateProgram () {
+        GLMock::calls.createProgram++;
+        return GLMock::s_nextHandle++;
+    }
     void glShaderSource (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length){}
-    void glGetShaderiv (GLuint shader, GLenum pname, GLint *params){}
-    void glCompileShader (GLuint shader){}
+    void glGetShaderiv (GLuint shader, GLenum pname, GLint *params){
+        *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+    }
+    void glCompileShader (GLuint shader){ GLMock::calls.compileShader++; }
     void glAttachShader (GLuint program, GLuint shader){}
     void glLinkProgram (GLuint program){}
-    void glDrawArrays( GLenum mode, GLint first, GLsizei count ){}
+    void glDrawArrays( GLenum mode, GLint first, GLsizei count ){
+        GLMock::calls.drawArrays++;
+    }
     void glDrawElements( GLenum mode, GLsizei count,
-                         GLenum type, const GLvoid *indices ){}
+                         GLenum type, const GLvoid *indices ){
+        GLMock::calls.drawElements++;
+    }
 
     void glEnableVertexAttribArray (GLuint index){}
     void glDisableVertexAttribArray (GLuint index){}
     void glEnableVertexArrayAttrib (GLuint vaobj, GLuint index){}
     void glVertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer){}
 
-    void glGetProgramiv (GLuint program, GLenum pname, GLint *params){}
+    void glGetProgramiv (GLuint program, GLenum pname, GLint *params){
+        *params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+    }
     void glGetProgramInfoLog (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog){}
     void glGetShaderInfoLog (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog){}
     GLint glGetUniformLocation (GLuint program, const GLchar *name){ return 0; }
     GLint glGetAttribLocation (GLuint program, const GLchar *name){ return 0; }
 
-    void glBufferData (GLenum target, GLsizeiptr size, const void *data, GLenum usage) {}
-    void glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void *data){}
+    void glBufferData (GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+        if (target == GL_ARRAY_BUFFER) { GLMock::calls.bufferData++; }
+    }
+    void glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void *data){
+        if (target == GL_ARRAY_BUFFER) { GLMock::calls.bufferSubData++; }
+    }
 
     void glGetBooleanv( GLenum pname, GLboolean *params ){}
     void glGetDoublev( GLenum pname, GLdouble *params ){}
@@ -88,7 +112,9 @@ extern "C" {
 
     void glBindBuffer (GLenum target, GLuint buffer){}
     void glDeleteBuffers (GLsizei n, const GLuint *buffers){}
-    void glGenBuffers (GLsizei n, GLuint *buffers){}
+    void glGenBuffers (GLsizei n, GLuint *buffers){
+        for (GLsizei i = 0; i < n; i++) { buffers[i] = GLMock::s_nextHandle++; }
+    }
     void glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height,
                       GLenum format, GLenum type, GLvoid* pixels){}
 
@@ -151,7 +177,10 @@ extern "C" {
     void glFinish(void){}
 
     // mapbuffer
-    void* glMapBuffer(GLenum target, GLenum access){ return nullptr; }
+    void* glMapBuffer(GLenum target, GLenum access){
+        GLMock::calls.mapBuffer++;
+        return nullptr;
+    }
     GLboolean glUnmapBuffer(GLenum target){ return false; }
 
     // VAO
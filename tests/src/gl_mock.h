@@ -0,0 +1,22 @@
+#pragma once
+
+// Call counters of the mocked GL functions, tests can use them to check
+// how much GL work a code path issues.
+namespace GLMock {
+
+struct Calls {
+    int bufferData = 0;
+    int bufferSubData = 0;
+    int mapBuffer = 0;
+    int drawElements = 0;
+    int drawArrays = 0;
+    int createProgram = 0;
+    int compileShader = 0;
+    int deleteProgram = 0;
+};
+
+extern Calls calls;
+
+inline void reset() { calls = Calls(); }
+
+}
@@ -0,0 +1,140 @@
+#include "catch.hpp"
+
+#include "data/clientGeoJsonSource.h"
+#include "data/properties.h"
+#include "data/tileData.h"
+#include "tile/tileID.h"
+#include "tile/tileTask.h"
+#include "util/mapProjection.h"
+
+#include <memory>
+#include <vector>
+
+using namespace Tangram;
+
+struct TestClientSource : ClientGeoJsonSource {
+
+    TestClientSource() : ClientGeoJsonSource("test", "") {}
+
+    size_t featureCount(TileID _tileID) {
+        auto task = createTask(_tileID, 0);
+        MercatorProjection projection;
+        auto data = parse(*task, projection);
+        return data ? data->layers[0].features.size() : 0;
+    }
+};
+
+// At zoom 2: LngLat(100, 45) is in tile 3/1 and LngLat(-100, -45) in tile 0/2
+
+TEST_CASE("Changes only outdate the tiles they touch", "[Core][ClientGeoJsonSource]") {
+    ClientGeoJsonSource source("test", "");
+
+    int64_t loaded = source.generation();
+    source.addPoint(Properties{}, LngLat(100, 45));
+
+    REQUIRE(source.generation() > loaded);
+    REQUIRE(source.isOutdated(TileID(3, 1, 2), loaded));
+    REQUIRE(source.isOutdated(TileID(0, 0, 0), loaded));
+    REQUIRE(!source.isOutdated(TileID(0, 2, 2), loaded));
+    REQUIRE(!source.isOutdated(TileID(3, 1, 2), source.generation()));
+}
+
+TEST_CASE("Changes of a batch are applied on commit", "[Core][ClientGeoJsonSource]") {
+    ClientGeoJsonSource source("test", "");
+
+    int64_t loaded = source.generation();
+
+    source.beginUpdate();
+    for (int i = 0; i < 100; i++) {
+        source.addPoint(Properties{}, LngLat(-100 + i * 0.01, -45));
+    }
+    REQUIRE(source.generation() == loaded);
+
+    source.commitUpdate();
+    REQUIRE(source.generation() == loaded + 1);
+    REQUIRE(source.isOutdated(TileID(0, 2, 2), loaded));
+    REQUIRE(!source.isOutdated(TileID(3, 1, 2), loaded));
+}
+
+TEST_CASE("Features are updated and removed by id", "[Core][ClientGeoJsonSource]") {
+    ClientGeoJsonSource source("test", "");
+
+    auto a = source.addPoint(Properties{}, LngLat(100, 45));
+    auto b = source.addPoint(Properties{}, LngLat(100, 45));
+    REQUIRE(a != b);
+
+    // Moving a feature outdates the tiles of both positions
+    int64_t loaded = source.generation();
+    REQUIRE(source.updatePoint(a, Properties{}, LngLat(-100, -45)));
+    REQUIRE(source.isOutdated(TileID(3, 1, 2), loaded));
+    REQUIRE(source.isOutdated(TileID(0, 2, 2), loaded));
+
+    REQUIRE(source.removeFeature(a));
+    REQUIRE(!source.removeFeature(a));
+    REQUIRE(!source.updatePoint(a, Properties{}, LngLat(0, 0)));
+
+    source.clearData();
+    REQUIRE(!source.removeFeature(b));
+    REQUIRE(source.isOutdated(TileID(0, 2, 2), loaded));
+}
+
+TEST_CASE("Tiles are cut from the features of the last commit", "[Core][ClientGeoJsonSource]") {
+    auto source = std::make_shared<TestClientSource>();
+
+    source->addPoint(Properties{}, LngLat(100, 45));
+    REQUIRE(source->featureCount(TileID(3, 1, 2)) == 1);
+
+    source->beginUpdate();
+    source->addPoint(Properties{}, LngLat(100.1, 45));
+    REQUIRE(source->featureCount(TileID(3, 1, 2)) == 1);
+    source->commitUpdate();
+    REQUIRE(source->featureCount(TileID(3, 1, 2)) == 2);
+    REQUIRE(source->featureCount(TileID(0, 2, 2)) == 0);
+
+    // Enough features to be merged into the main index
+    std::vector<ClientGeoJsonSource::FeatureID> ids;
+    source->beginUpdate();
+    for (int i = 0; i < 300; i++) {
+        ids.push_back(source->addPoint(Properties{}, LngLat(-100 + i * 0.01, -45)));
+    }
+    source->commitUpdate();
+    REQUIRE(source->featureCount(TileID(0, 2, 2)) == 300);
+
+    REQUIRE(source->removeFeature(ids[0]));
+    REQUIRE(source->featureCount(TileID(0, 2, 2)) == 299);
+    REQUIRE(source->featureCount(TileID(3, 1, 2)) == 2);
+}
+
+TEST_CASE("Features added one at a time are indexed when tiles are cut", "[Core][ClientGeoJsonSource]") {
+    auto source = std::make_shared<TestClientSource>();
+
+    // Across the merge into the main index, without a tile in between
+    for (int i = 0; i < 300; i++) {
+        source->addPoint(Properties{}, LngLat(-100 + i * 0.01, -45));
+    }
+    REQUIRE(source->featureCount(TileID(0, 2, 2)) == 300);
+
+    source->addPoint(Properties{}, LngLat(100, 45));
+    REQUIRE(source->featureCount(TileID(3, 1, 2)) == 1);
+    REQUIRE(source->featureCount(TileID(0, 2, 2)) == 300);
+}
+
+TEST_CASE("Changes older than all loaded tiles are dropped", "[Core][ClientGeoJsonSource]") {
+    ClientGeoJsonSource source("test", "");
+
+    int64_t first = source.generation();
+    source.addPoint(Properties{}, LngLat(100, 45));
+
+    int64_t second = source.generation();
+    source.addPoint(Properties{}, LngLat(-100, -45));
+
+    source.setOldestGeneration(second);
+
+    // Tiles of the oldest generation still see the changes since
+    REQUIRE(source.isOutdated(TileID(0, 2, 2), second));
+    REQUIRE(!source.isOutdated(TileID(3, 1, 2), second));
+
+    // Older tiles can not be checked anymore
+    REQUIRE(source.isOutdated(TileID(3, 1, 2), first));
+    REQUIRE(source.isOutdated(TileID(1, 1, 2), first));
+}
@@ -0,0 +1,108 @@
+#include "catch.hpp"
+
+#include "data/propertyItem.h"
+#include "util/compactFeature.h"
+
+#include <cmath>
+#include <memory>
+
+using namespace Tangram;
+
+static bool near(const Point& a, const Point& b, float tolerance) {
+    return std::abs(a.x - b.x) <= tolerance &&
+        std::abs(a.y - b.y) <= tolerance &&
+        std::abs(a.z - b.z) <= tolerance;
+}
+
+TEST_CASE("Varints and zig-zag values round trip", "[Core][CompactFeature]") {
+    std::vector<uint8_t> data;
+    for (int64_t value : { 0ll, 1ll, -1ll, 63ll, -64ll, 300ll, -70000ll, 1ll << 40 }) {
+        Compact::writeVarint(Compact::zigzag(value), data);
+    }
+
+    // Small magnitudes take a single byte
+    REQUIRE(data[0] == 0);
+    REQUIRE(data[1] == 2);
+    REQUIRE(data[2] == 1);
+    REQUIRE(data.size() == 5 + 2 + 3 + 6);
+
+    const uint8_t* pos = data.data();
+    for (int64_t value : { 0ll, 1ll, -1ll, 63ll, -64ll, 300ll, -70000ll, 1ll << 40 }) {
+        REQUIRE(Compact::unzigzag(Compact::readVarint(pos)) == value);
+    }
+    REQUIRE(pos == data.data() + data.size());
+}
+
+TEST_CASE("Feature geometry is restored within the resolution", "[Core][CompactFeature]") {
+    Feature feature;
+    feature.geometryType = GeometryType::polygons;
+    feature.id = 42;
+    feature.polygons = { { { {0.1f, 0.2f, 0.f}, {0.9f, 0.2f, 0.5f}, {0.9f, 0.8f, 0.f}, {0.1f, 0.2f, 0.f} },
+                           { {0.4f, 0.4f, 0.f}, {-0.5f, 0.6f, 0.f}, {0.4f, 0.4f, 0.f} } } };
+
+    CompactFeature compact(feature);
+    REQUIRE(compact.geometryType() == GeometryType::polygons);
+
+    Feature restored = compact.feature();
+    REQUIRE(restored.id == 42);
+    REQUIRE(restored.polygons.size() == 1);
+    REQUIRE(restored.polygons[0].size() == 2);
+
+    float tolerance = 1.f / CompactFeature::default_resolution;
+    for (size_t r = 0; r < 2; r++) {
+        auto& ring = feature.polygons[0][r];
+        REQUIRE(restored.polygons[0][r].size() == ring.size());
+        for (size_t i = 0; i < ring.size(); i++) {
+            REQUIRE(near(restored.polygons[0][r][i], ring[i], tolerance));
+        }
+    }
+
+    // Much smaller than the points and their sizes as floats
+    REQUIRE(compact.memoryUsage() < sizeof(Feature) + 7 * sizeof(Point) + 3 * sizeof(Line));
+}
+
+TEST_CASE("Owned properties are packed and unpacked", "[Core][CompactFeature]") {
+    Feature feature;
+    feature.geometryType = GeometryType::points;
+    feature.points = { {0.5f, 0.5f, 0.f} };
+    feature.props.set("name", "a");
+    feature.props.set("height", 12.5);
+    feature.props.sourceId = 3;
+
+    CompactFeature compact(feature);
+
+    Properties props = compact.properties();
+    REQUIRE(!props.isShared());
+    REQUIRE(props.size() == 2);
+    REQUIRE(props.sourceId == 3);
+    REQUIRE(props.getString("name") == "a");
+    REQUIRE(props.getNumber("height") == 12.5);
+    REQUIRE(compact.feature().points.size() == 1);
+}
+
+TEST_CASE("Shared properties keep referencing their dictionary", "[Core][CompactFeature]") {
+    auto dictionary = std::make_shared<PropertyDictionary>();
+    dictionary->keys = { "kind", "height" };
+    dictionary->values = { std::string("residential"), 10.0 };
+
+    Properties shared;
+    shared.setShared(dictionary, { {1, 1}, {0, 0} });
+    shared.sort();
+
+    Compact::PropertiesPacker packer;
+    std::vector<uint8_t> blob;
+    packer.pack(shared, blob);
+    size_t second = blob.size();
+    packer.pack(shared, blob);
+
+    Properties props;
+    packer.unpack(&blob[second], props);
+    REQUIRE(props.isShared());
+    REQUIRE(props.dictionary() == shared.dictionary());
+    REQUIRE(props.getString("kind") == "residential");
+    REQUIRE(props.getNumber("height") == 10);
+
+    // Each dictionary is referenced once, each tag takes two bytes
+    REQUIRE(packer.memoryUsage() == sizeof(std::shared_ptr<const PropertyDictionary>));
+    REQUIRE(blob.size() == 2 * (3 + 4));
+}
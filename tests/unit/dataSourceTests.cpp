@@ -0,0 +1,80 @@
+#include "catch.hpp"
+
+#include "data/dataSource.h"
+#include "data/tileData.h"
+#include "tile/tileTask.h"
+
+#include <memory>
+#include <vector>
+
+using namespace Tangram;
+
+struct TestDataSource : DataSource {
+
+    TestDataSource() : DataSource("test", "http://tiles/{z}/{x}/{y}.mvt", 10) {}
+
+    std::shared_ptr<TileData> parse(const TileTask& _task,
+                                    const MapProjection& _projection) const override {
+        return std::make_shared<TileData>();
+    }
+
+    void respond(const TileID& _tileID, std::vector<char> _data) {
+        onRequestDone(constructURL(_tileID), std::move(_data));
+    }
+};
+
+TEST_CASE("Overzoomed tiles share the request of their parent", "[Core][DataSource]") {
+    auto source = std::make_shared<TestDataSource>();
+
+    std::vector<std::shared_ptr<TileTask>> loaded;
+    TileTaskCb cb{[&](std::shared_ptr<TileTask>&& _task) { loaded.push_back(std::move(_task)); }};
+
+    auto taskA = source->createTask(TileID(2048, 2048, 12));
+    auto taskB = source->createTask(TileID(2049, 2051, 12));
+    REQUIRE(source->loadTileData(std::shared_ptr<TileTask>(taskA), cb));
+    REQUIRE(source->loadTileData(std::shared_ptr<TileTask>(taskB), cb));
+
+    source->respond(TileID(512, 512, 10), { 'd', 'a', 't', 'a' });
+
+    REQUIRE(loaded.size() == 2);
+    auto& dataA = static_cast<DownloadTileTask&>(*taskA).rawTileData;
+    auto& dataB = static_cast<DownloadTileTask&>(*taskB).rawTileData;
+    REQUIRE(dataA);
+    REQUIRE(dataA == dataB);
+
+    // The request is done, later responses are dropped
+    loaded.clear();
+    source->respond(TileID(512, 512, 10), { 'd', 'a', 't', 'a' });
+    REQUIRE(loaded.empty());
+}
+
+TEST_CASE("Shared requests are kept until all of their tiles are canceled", "[Core][DataSource]") {
+    auto source = std::make_shared<TestDataSource>();
+
+    std::vector<std::shared_ptr<TileTask>> loaded;
+    TileTaskCb cb{[&](std::shared_ptr<TileTask>&& _task) { loaded.push_back(std::move(_task)); }};
+
+    TileID idA(2048, 2048, 12);
+    TileID idB(2049, 2048, 12);
+    auto taskA = source->createTask(idA);
+    auto taskB = source->createTask(idB);
+    source->loadTileData(std::shared_ptr<TileTask>(taskA), cb);
+    source->loadTileData(std::shared_ptr<TileTask>(taskB), cb);
+
+    taskA->cancel();
+    source->cancelLoadingTile(idA);
+
+    source->respond(TileID(512, 512, 10), { 'd', 'a', 't', 'a' });
+    REQUIRE(loaded.size() == 1);
+    REQUIRE(loaded[0] == taskB);
+
+    // Canceling the last tile drops the request
+    auto taskC = source->createTask(idA);
+    source->loadTileData(std::shared_ptr<TileTask>(taskC), cb);
+    taskC->cancel();
+    source->cancelLoadingTile(idA);
+
+    loaded.clear();
+    source->respond(TileID(512, 512, 10), { 'd', 'a', 't', 'a' });
+    REQUIRE(loaded.empty());
+}
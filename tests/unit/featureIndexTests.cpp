@@ -0,0 +1,137 @@
+#include "catch.hpp"
+
+#include "data/propertyItem.h"
+#include "tile/featureIndex.h"
+
+#include <string>
+
+using namespace Tangram;
+
+static Feature makeSquare(float x, float y, float size, const std::string& id) {
+    Feature feature;
+    feature.geometryType = GeometryType::polygons;
+    feature.polygons.push_back({{ {x, y, 0}, {x + size, y, 0}, {x + size, y + size, 0}, {x, y + size, 0} }});
+    feature.props.set("id", id);
+    return feature;
+}
+
+static Feature makeLine(float y, const std::string& id) {
+    Feature feature;
+    feature.geometryType = GeometryType::lines;
+    feature.lines.push_back({ {0, y, 0}, {1, y, 0} });
+    feature.props.set("id", id);
+    return feature;
+}
+
+TEST_CASE("Polygons are found at positions inside of them", "[Core][FeatureIndex]") {
+    FeatureIndex index;
+    index.add(makeSquare(0.1f, 0.1f, 0.2f, "a"));
+    index.add(makeSquare(0.6f, 0.6f, 0.2f, "b"));
+    index.build();
+
+    std::vector<FeatureIndex::Hit> hits;
+    index.query({0.2f, 0.2f}, 0.f, hits);
+    REQUIRE(hits.size() == 1);
+    REQUIRE(hits[0].properties->getString("id") == "a");
+    REQUIRE(hits[0].distance == 0.f);
+
+    hits.clear();
+    index.query({0.5f, 0.5f}, 0.01f, hits);
+    REQUIRE(hits.empty());
+
+    // Near the edge of 'b'
+    hits.clear();
+    index.query({0.55f, 0.7f}, 0.1f, hits);
+    REQUIRE(hits.size() == 1);
+    REQUIRE(hits[0].properties->getString("id") == "b");
+    REQUIRE(std::abs(hits[0].distance - 0.05f) < 1e-5f);
+}
+
+TEST_CASE("Holes are not part of a polygon", "[Core][FeatureIndex]") {
+    Feature feature = makeSquare(0.f, 0.f, 1.f, "a");
+    feature.polygons[0].push_back({ {0.4f, 0.4f, 0}, {0.6f, 0.4f, 0}, {0.6f, 0.6f, 0}, {0.4f, 0.6f, 0} });
+
+    FeatureIndex index;
+    index.add(feature);
+    index.build();
+
+    std::vector<FeatureIndex::Hit> hits;
+    index.query({0.5f, 0.5f}, 0.f, hits);
+    REQUIRE(hits.empty());
+
+    index.query({0.2f, 0.5f}, 0.f, hits);
+    REQUIRE(hits.size() == 1);
+}
+
+TEST_CASE("Many lines are found through the tree levels", "[Core][FeatureIndex]") {
+    FeatureIndex index;
+    // More than node_size^2 entries for three levels
+    for (int i = 0; i < 1000; i++) {
+        index.add(makeLine(i / 1000.f, std::to_string(i)));
+    }
+    index.add(makeLine(0.5f, "duplicate"));
+    index.build();
+    REQUIRE(index.size() == 1001);
+
+    std::vector<FeatureIndex::Hit> hits;
+    index.query({0.3f, 0.2503f}, 0.0005f, hits);
+    REQUIRE(hits.size() == 1);
+    REQUIRE(hits[0].properties->getString("id") == "250");
+
+    hits.clear();
+    index.query({0.3f, 0.5f}, 0.0001f, hits);
+    REQUIRE(hits.size() == 2);
+}
+
+TEST_CASE("Points are not indexed", "[Core][FeatureIndex]") {
+    Feature feature;
+    feature.geometryType = GeometryType::points;
+    feature.points.push_back({0.5f, 0.5f, 0});
+
+    FeatureIndex index;
+    index.add(feature);
+    index.build();
+    REQUIRE(index.empty());
+
+    std::vector<FeatureIndex::Hit> hits;
+    index.query({0.5f, 0.5f}, 1.f, hits);
+    REQUIRE(hits.empty());
+}
+
+TEST_CASE("Hits report the identifier of their feature", "[Core][FeatureIndex]") {
+    Feature feature = makeSquare(0.1f, 0.1f, 0.2f, "a");
+    feature.id = 42;
+
+    FeatureIndex index;
+    index.add(feature);
+    index.add(makeSquare(0.6f, 0.6f, 0.2f, "b"));
+    index.build();
+
+    std::vector<FeatureIndex::Hit> hits;
+    index.query({0.2f, 0.2f}, 0.f, hits);
+    REQUIRE(hits.size() == 1);
+    REQUIRE(hits[0].id == 42);
+
+    hits.clear();
+    index.query({0.7f, 0.7f}, 0.f, hits);
+    REQUIRE(hits.size() == 1);
+    REQUIRE(hits[0].id == 0);
+}
+
+TEST_CASE("Hits report the layer of their feature", "[Core][FeatureIndex]") {
+    Feature road = makeSquare(0.1f, 0.1f, 0.2f, "road");
+    road.id = 7;
+    Feature poi = makeSquare(0.1f, 0.1f, 0.2f, "poi");
+    poi.id = 7;
+
+    FeatureIndex index;
+    index.add(road, std::hash<std::string>()("roads"));
+    index.add(poi, std::hash<std::string>()("pois"));
+    index.build();
+
+    std::vector<FeatureIndex::Hit> hits;
+    index.query({0.2f, 0.2f}, 0.f, hits);
+    REQUIRE(hits.size() == 2);
+    REQUIRE(hits[0].id == hits[1].id);
+    REQUIRE(hits[0].layer != hits[1].layer);
+}
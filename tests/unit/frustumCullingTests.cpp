@@ -0,0 +1,63 @@
+#include "catch.hpp"
+
+#include "util/geom.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+using namespace Tangram;
+
+static BoundingBox3 makeBox(glm::vec3 min, glm::vec3 max) {
+    BoundingBox3 box;
+    box.expand(min);
+    box.expand(max);
+    return box;
+}
+
+TEST_CASE("Bounding boxes are empty until a point is added", "[Core][Culling]") {
+    BoundingBox3 box;
+    REQUIRE(box.isEmpty());
+
+    box.inflate(glm::vec3(1.f));
+    REQUIRE(box.isEmpty());
+
+    box.expand(glm::vec3(0.5f));
+    REQUIRE(!box.isEmpty());
+
+    box.inflate(glm::vec3(1.f, 1.f, 0.f));
+    REQUIRE(box.min == glm::vec3(-0.5f, -0.5f, 0.5f));
+    REQUIRE(box.max == glm::vec3(1.5f, 1.5f, 0.5f));
+
+    box.clear();
+    REQUIRE(box.isEmpty());
+}
+
+TEST_CASE("Boxes outside of the side planes of the frustum are culled", "[Core][Culling]") {
+    glm::mat4 mvp = glm::ortho(-1.f, 1.f, -1.f, 1.f, -1.f, 1.f);
+
+    REQUIRE(!isOutsideFrustum(mvp, makeBox({-0.5f, -0.5f, 0.f}, {0.5f, 0.5f, 0.f})));
+
+    // Partially inside
+    REQUIRE(!isOutsideFrustum(mvp, makeBox({0.5f, 0.5f, 0.f}, {1.5f, 1.5f, 0.f})));
+
+    // Containing the frustum
+    REQUIRE(!isOutsideFrustum(mvp, makeBox({-2.f, -2.f, 0.f}, {2.f, 2.f, 0.f})));
+
+    REQUIRE(isOutsideFrustum(mvp, makeBox({1.5f, -0.5f, 0.f}, {2.5f, 0.5f, 0.f})));
+    REQUIRE(isOutsideFrustum(mvp, makeBox({-2.5f, -0.5f, 0.f}, {-1.5f, 0.5f, 0.f})));
+    REQUIRE(isOutsideFrustum(mvp, makeBox({-0.5f, 1.5f, 0.f}, {0.5f, 2.5f, 0.f})));
+    REQUIRE(isOutsideFrustum(mvp, makeBox({-0.5f, -2.5f, 0.f}, {0.5f, -1.5f, 0.f})));
+}
+
+TEST_CASE("Extrusion heights bring boxes into a tilted view", "[Core][Culling]") {
+    glm::mat4 proj = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f);
+    // Looking at the origin from 45 degrees, the bottom edge of the view meets the ground at y = -7.32
+    glm::mat4 view = glm::lookAt(glm::vec3(0.f, -10.f, 10.f), glm::vec3(0.f), glm::vec3(0.f, 0.f, 1.f));
+    glm::mat4 mvp = proj * view;
+
+    REQUIRE(!isOutsideFrustum(mvp, makeBox({-1.f, -1.f, 0.f}, {1.f, 1.f, 0.f})));
+
+    // Flat geometry below the bottom edge is culled, but not when extruded
+    REQUIRE(isOutsideFrustum(mvp, makeBox({-1.f, -8.f, 0.f}, {1.f, -7.5f, 0.f})));
+    REQUIRE(!isOutsideFrustum(mvp, makeBox({-1.f, -8.f, 0.f}, {1.f, -7.5f, 5.f})));
+}
@@ -0,0 +1,103 @@
+#include "catch.hpp"
+
+#include "data/tileData.h"
+#include "tile/tileID.h"
+#include "util/geoJson.h"
+#include "util/json.h"
+#include "util/mapProjection.h"
+
+#include <string>
+#include <vector>
+
+using namespace Tangram;
+
+static const std::string collection = R"({
+    "type": "FeatureCollection",
+    "bbox": [-10, -10, 10, 10],
+    "features": [
+        { "type": "Feature", "id": 42,
+          "geometry": { "type": "Point", "coordinates": [1.5, 2.5, 100] },
+          "properties": { "name": "a", "height": 10, "nested": { "ignored": [1, 2] }, "flag": true } },
+        { "type": "Feature",
+          "properties": { "kind": "road" },
+          "geometry": { "coordinates": [[0, 0], [1, 1], [2, 0]], "type": "LineString" } },
+        { "type": "Feature", "id": "not numeric",
+          "geometry": { "type": "MultiPolygon", "coordinates": [
+              [[[0, 0], [1, 0], [1, 1], [0, 0]], [[0.2, 0.2], [0.8, 0.2], [0.8, 0.8], [0.2, 0.2]]],
+              [[[2, 2], [3, 2], [3, 3], [2, 2]]]
+          ] } }
+    ]
+})";
+
+static void requireSameLayer(const Layer& _a, const Layer& _b) {
+    REQUIRE(_a.name == _b.name);
+    REQUIRE(_a.features.size() == _b.features.size());
+
+    for (size_t i = 0; i < _a.features.size(); i++) {
+        auto& fa = _a.features[i];
+        auto& fb = _b.features[i];
+        REQUIRE(fa.geometryType == fb.geometryType);
+        REQUIRE(fa.id == fb.id);
+        REQUIRE(fa.points == fb.points);
+        REQUIRE(fa.lines == fb.lines);
+        REQUIRE(fa.polygons == fb.polygons);
+        REQUIRE(fa.props.size() == fb.props.size());
+    }
+}
+
+TEST_CASE("Streamed GeoJSON matches the document based parsing", "[Core][GeoJson]") {
+    MercatorProjection projection;
+    TileID tileID(0, 0, 0);
+    GeoJson::TileProjection proj(projection, tileID);
+
+    const char* error;
+    size_t offset;
+    auto document = JsonParseBytes(collection.data(), collection.size(), &error, &offset);
+    REQUIRE(error == nullptr);
+    Layer expected = GeoJson::getLayer(document, proj, 1);
+
+    TileData tileData;
+    REQUIRE(GeoJson::parseTileData(collection.data(), collection.size(), proj, 1, tileData, &error, &offset));
+    REQUIRE(tileData.layers.size() == 1);
+    requireSameLayer(tileData.layers[0], expected);
+
+    auto& features = tileData.layers[0].features;
+    REQUIRE(features[0].id == 42);
+    REQUIRE(features[0].props.getString("name") == "a");
+    REQUIRE(features[0].props.getNumber("height") == 10);
+    REQUIRE(features[2].polygons.size() == 2);
+    REQUIRE(features[2].polygons[0].size() == 2);
+
+    std::vector<char> buffer(collection.begin(), collection.end());
+    buffer.push_back('\0');
+
+    TileData insitu;
+    REQUIRE(GeoJson::parseTileDataInsitu(buffer.data(), proj, 1, insitu, &error, &offset));
+    REQUIRE(insitu.layers.size() == 1);
+    requireSameLayer(insitu.layers[0], expected);
+}
+
+TEST_CASE("Streamed GeoJSON reads named collections as layers", "[Core][GeoJson]") {
+    MercatorProjection projection;
+    GeoJson::TileProjection proj(projection, TileID(0, 0, 0));
+
+    std::string layers = "{ \"roads\": " + collection + ", \"other\": { \"features\": [] }, " +
+                         "\"water\": { \"type\": \"FeatureCollection\", \"features\": [] } }";
+
+    const char* error;
+    size_t offset;
+    TileData tileData;
+    REQUIRE(GeoJson::parseTileData(layers.data(), layers.size(), proj, 1, tileData, &error, &offset));
+
+    REQUIRE(tileData.layers.size() == 2);
+    REQUIRE(tileData.layers[0].name == "roads");
+    REQUIRE(tileData.layers[0].features.size() == 3);
+    REQUIRE(tileData.layers[1].name == "water");
+    REQUIRE(tileData.layers[1].features.empty());
+
+    std::string broken = collection.substr(0, collection.size() / 2);
+    TileData empty;
+    REQUIRE(!GeoJson::parseTileData(broken.data(), broken.size(), proj, 1, empty, &error, &offset));
+    REQUIRE(error != nullptr);
+    REQUIRE(empty.layers.empty());
+}
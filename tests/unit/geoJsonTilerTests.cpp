@@ -0,0 +1,165 @@
+#include "catch.hpp"
+
+#include "data/propertyItem.h"
+#include "tile/tileID.h"
+#include "util/geoJsonTiler.h"
+
+#include <cmath>
+#include <memory>
+
+using namespace Tangram;
+using namespace Tangram::GeoJsonTiler;
+
+static ProjectedFeature makeFeature(GeometryType _type, std::vector<std::vector<glm::dvec2>> _parts) {
+    ProjectedFeature feature;
+    feature.geometryType = _type;
+    feature.parts = std::move(_parts);
+    if (_type == GeometryType::polygons) {
+        feature.ringCounts = { uint32_t(feature.parts.size()) };
+    }
+    Properties props;
+    props.set("name", "a");
+    feature.setProperties(props);
+    feature.updateBounds();
+    feature.simplify();
+    return feature;
+}
+
+TEST_CASE("GeoJSON features are parsed into projected coordinates", "[Core][GeoJsonTiler]") {
+    std::string data = R"({ "type": "FeatureCollection", "features": [
+        { "type": "Feature", "properties": { "name": "a", "height": 10 },
+          "geometry": { "type": "Point", "coordinates": [0, 0] } },
+        { "type": "Feature",
+          "geometry": { "type": "MultiPolygon", "coordinates": [
+            [[[0, 0], [10, 0], [10, 10], [0, 0]]],
+            [[[20, 0], [30, 0], [30, 10], [20, 0]]] ] } } ] })";
+
+    std::vector<ProjectedFeature> features;
+    REQUIRE(parseFeatures(data, features));
+    REQUIRE(features.size() == 2);
+
+    auto& point = features[0];
+    REQUIRE(point.geometryType == GeometryType::points);
+    REQUIRE(point.parts.size() == 1);
+    REQUIRE(std::abs(point.parts[0][0].x - 0.5) < 1e-9);
+    REQUIRE(std::abs(point.parts[0][0].y - 0.5) < 1e-9);
+
+    Properties props;
+    props.setShared(point.properties, std::vector<Properties::Tag>(point.tags));
+    REQUIRE(props.getString("name") == "a");
+    REQUIRE(props.getNumber("height") == 10);
+
+    auto& polygons = features[1];
+    REQUIRE(polygons.geometryType == GeometryType::polygons);
+    REQUIRE(polygons.parts.size() == 2);
+    REQUIRE(polygons.ringCounts == std::vector<uint32_t>({ 1, 1 }));
+    REQUIRE(std::abs(polygons.max.x - (30.0 / 360 + 0.5)) < 1e-9);
+    REQUIRE(polygons.max.y == 0.5);
+
+    REQUIRE(!parseFeatures("{ \"type\": ", features));
+}
+
+TEST_CASE("Lines are cut to the buffered area of each tile", "[Core][GeoJsonTiler]") {
+    auto line = makeFeature(GeometryType::lines, { { {0.25, 0.25}, {0.75, 0.25} } });
+
+    Feature left;
+    REQUIRE(cutFeature(line, TileID(0, 0, 1), left));
+    REQUIRE(left.geometryType == GeometryType::lines);
+    REQUIRE(left.lines.size() == 1);
+    REQUIRE(left.lines[0] == Line({ {0.5f, 0.5f, 0.f}, {1.015625f, 0.5f, 0.f} }));
+
+    // Properties reference the feature instead of being copied
+    REQUIRE(left.props.isShared());
+    REQUIRE(left.props.getString("name") == "a");
+
+    Feature right;
+    REQUIRE(cutFeature(line, TileID(1, 0, 1), right));
+    REQUIRE(right.lines[0] == Line({ {-0.015625f, 0.5f, 0.f}, {0.5f, 0.5f, 0.f} }));
+
+    Feature below;
+    REQUIRE(!cutFeature(line, TileID(0, 1, 1), below));
+}
+
+TEST_CASE("Polygons and points are cut to tiles", "[Core][GeoJsonTiler]") {
+    auto polygon = makeFeature(GeometryType::polygons,
+                               { { {0.1, 0.1}, {0.9, 0.1}, {0.9, 0.9}, {0.1, 0.9}, {0.1, 0.1} } });
+
+    Feature feature;
+    REQUIRE(cutFeature(polygon, TileID(0, 0, 1), feature));
+    REQUIRE(feature.polygons.size() == 1);
+
+    auto& ring = feature.polygons[0][0];
+    REQUIRE(ring.size() == 5);
+    REQUIRE(ring.front() == ring.back());
+
+    // Within the buffer, rounded to 1/extent
+    float e = 1.f / extent;
+    for (auto& p : ring) {
+        REQUIRE(p.x >= 0.2f - e);
+        REQUIRE(p.x <= 1.015625f + e);
+        REQUIRE(p.y >= -0.015625f - e);
+        REQUIRE(p.y <= 0.8f + e);
+    }
+
+    // Points belong to a single tile, y goes up in tile coordinates
+    auto point = makeFeature(GeometryType::points, { { project(LngLat(0, 0)) } });
+
+    Feature inside;
+    REQUIRE(cutFeature(point, TileID(1, 1, 1), inside));
+    REQUIRE(inside.points == std::vector<Point>({ {0.f, 1.f, 0.f} }));
+
+    Feature outside;
+    REQUIRE(!cutFeature(point, TileID(0, 0, 1), outside));
+}
+
+TEST_CASE("Lines are simplified to the zoom of each tile", "[Core][GeoJsonTiler]") {
+    // The middle vertex is below one unit of the tile extent at low zooms
+    auto line = makeFeature(GeometryType::lines,
+                            { { {0.1, 0.5}, {0.15, 0.5 + 1e-6}, {0.2, 0.5} } });
+
+    REQUIRE(line.vertexZooms.size() == 1);
+    REQUIRE(line.vertexZooms[0].front() == 0);
+    REQUIRE(line.vertexZooms[0].back() == 0);
+
+    Feature low;
+    REQUIRE(cutFeature(line, TileID(0, 0, 0), low));
+    REQUIRE(low.lines.size() == 1);
+    REQUIRE(low.lines[0].size() == 2);
+
+    Feature high;
+    REQUIRE(cutFeature(line, TileID(153, 512, 10), high));
+    REQUIRE(high.lines.size() == 1);
+    REQUIRE(high.lines[0].size() == 3);
+}
+
+TEST_CASE("The index finds the features near a tile", "[Core][GeoJsonTiler]") {
+    Index::Features features;
+    features.push_back(std::make_shared<ProjectedFeature>(
+        makeFeature(GeometryType::points, { { {0.1, 0.1} } })));
+    features.push_back(std::make_shared<ProjectedFeature>(
+        makeFeature(GeometryType::points, { { {0.9, 0.9} } })));
+    // Spans more than max_feature_cells
+    features.push_back(std::make_shared<ProjectedFeature>(
+        makeFeature(GeometryType::lines, { { {0.0, 0.49}, {1.0, 0.51} } })));
+
+    Index index(features);
+    REQUIRE(index.size() == 3);
+
+    std::vector<const ProjectedFeature*> found;
+    index.query(TileID(0, 0, 2), found);
+    REQUIRE(found == std::vector<const ProjectedFeature*>{ features[0].get() });
+
+    found.clear();
+    index.query(TileID(3, 3, 2), found);
+    REQUIRE(found == std::vector<const ProjectedFeature*>{ features[1].get() });
+
+    found.clear();
+    index.query(TileID(1, 1, 2), found);
+    REQUIRE(found == std::vector<const ProjectedFeature*>{ features[2].get() });
+
+    found.clear();
+    index.query(TileID(0, 0, 0), found);
+    REQUIRE(found.size() == 3);
+    REQUIRE(found[0] == features[0].get());
+    REQUIRE(found[2] == features[2].get());
+}
@@ -4,6 +4,8 @@
 #include "style/textStyle.h"
 #include "labels/textLabel.h"
 #include "labels/textLabels.h"
+#include "labels/labelSet.h"
+#include "labels/labelCollider.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 
@@ -261,3 +263,94 @@ TEST_CASE( "Ensure anchor fallback behavior when looping over all fallback and f
     REQUIRE(l.state() == Label::State::visible);
 }
 #endif
+
+TEST_CASE( "Label sets project their labels like single label updates", "[Core][Label]" ) {
+    glm::mat4 proj = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.f, -1.f, 2.f), glm::vec3(0.f), glm::vec3(0.f, 0.f, 1.f));
+    glm::mat4 mvp = proj * view;
+
+    std::vector<std::unique_ptr<Label>> labels;
+    labels.push_back(std::make_unique<TextLabel>(makeLabel({{0.1f, 0.2f}}, Label::Type::point)));
+    labels.push_back(std::make_unique<TextLabel>(makeLabel({{-0.5f, 0.f}, {0.5f, 0.3f}}, Label::Type::line)));
+    // Behind the camera
+    labels.push_back(std::make_unique<TextLabel>(makeLabel({{0.f, -10.f}}, Label::Type::point)));
+
+    TextLabel point(makeLabel({{0.1f, 0.2f}}, Label::Type::point));
+    TextLabel line(makeLabel({{-0.5f, 0.f}, {0.5f, 0.3f}}, Label::Type::line));
+    TextLabel hidden(makeLabel({{0.f, -10.f}}, Label::Type::point));
+
+    LabelSet labelSet;
+    labelSet.setLabels(labels);
+    labelSet.updateTransforms(mvp, screenSize, 0, false);
+
+    auto& setLabels = labelSet.getLabels();
+
+    REQUIRE(labelSet.isUpdated(0) == point.update(mvp, screenSize, 0));
+    REQUIRE(labelSet.isUpdated(1) == line.update(mvp, screenSize, 0));
+    REQUIRE(labelSet.isUpdated(2) == hidden.update(mvp, screenSize, 0));
+    REQUIRE(!labelSet.isUpdated(2));
+
+    auto p0 = setLabels[0]->transform().state.screenPos;
+    auto p1 = setLabels[1]->transform().state.screenPos;
+    REQUIRE(std::abs(p0.x - point.transform().state.screenPos.x) < 1e-3);
+    REQUIRE(std::abs(p0.y - point.transform().state.screenPos.y) < 1e-3);
+    REQUIRE(std::abs(p1.x - line.transform().state.screenPos.x) < 1e-3);
+    REQUIRE(std::abs(p1.y - line.transform().state.screenPos.y) < 1e-3);
+}
+
+TEST_CASE( "Labels anchored in the tile buffer are left to the neighbour tile", "[Core][Label]" ) {
+    std::vector<std::unique_ptr<Label>> labels;
+    labels.push_back(std::make_unique<TextLabel>(makeLabel({{0.5f, 0.5f}}, Label::Type::point)));
+    // On the edge shared with the right neighbour
+    labels.push_back(std::make_unique<TextLabel>(makeLabel({{1.f, 0.5f}}, Label::Type::point)));
+    labels.push_back(std::make_unique<TextLabel>(makeLabel({{0.5f, -0.1f}}, Label::Type::point)));
+    // Line crossing the border, anchored at its midpoint inside of the tile
+    labels.push_back(std::make_unique<TextLabel>(makeLabel({{-0.2f, 0.5f}, {0.4f, 0.5f}}, Label::Type::line)));
+    labels.push_back(std::make_unique<TextLabel>(makeLabel({{0.8f, 0.5f}, {1.4f, 0.5f}}, Label::Type::line)));
+
+    LabelCollider collider;
+    collider.setup(256.f, 1.f, 0);
+    collider.addLabels(labels);
+    collider.process();
+
+    REQUIRE(labels[0]->state() != Label::State::dead);
+    REQUIRE(labels[1]->state() == Label::State::dead);
+    REQUIRE(labels[2]->state() == Label::State::dead);
+    REQUIRE(labels[3]->state() != Label::State::dead);
+    REQUIRE(labels[4]->state() == Label::State::dead);
+}
+
+TEST_CASE( "Labels that only collide when zoomed out get a minimum zoom", "[Core][Label]" ) {
+    auto makeBoxLabel = [](glm::vec2 _pos, float _priority) {
+        Label::Options options;
+        options.anchors.anchor[0] = LabelProperty::Anchor::center;
+        options.anchors.count = 1;
+        options.priority = _priority;
+
+        return std::make_unique<TextLabel>(Label::Transform{_pos}, Label::Type::point, options,
+                                           TextLabel::FontVertexAttributes{}, glm::vec2{20, 10},
+                                           dummy, TextRange{}, TextLabelProperty::Align::none);
+    };
+
+    std::vector<std::unique_ptr<Label>> labels;
+    labels.push_back(makeBoxLabel({0.5f, 0.5f}, 1));
+    // 25.6px apart at the maximum scale of the tile (512px)
+    labels.push_back(makeBoxLabel({0.55f, 0.5f}, 2));
+    labels.push_back(makeBoxLabel({0.5f, 0.1f}, 2));
+
+    LabelCollider collider;
+    collider.setup(256.f, 1.f, 10);
+    collider.addLabels(labels);
+    collider.process();
+
+    for (auto& label : labels) {
+        REQUIRE(label->state() != Label::State::dead);
+    }
+
+    REQUIRE(labels[0]->minZoom() == 0.f);
+    REQUIRE(labels[1]->minZoom() > 10.f);
+    REQUIRE(labels[1]->minZoom() < 11.f);
+    REQUIRE(labels[1]->minZoomLabel() == labels[0].get());
+    // Apart down to the minimum scale
+    REQUIRE(labels[2]->minZoom() == 0.f);
+}
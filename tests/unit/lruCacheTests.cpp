@@ -0,0 +1,93 @@
+#include "catch.hpp"
+
+#include "util/lruCache.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Tangram;
+
+TEST_CASE("Cached values are found until they are evicted", "[Core][LruCache]") {
+    // One stripe to make the eviction order deterministic
+    ConcurrentLruCache<std::string, int, std::hash<std::string>, 1> cache(2);
+    std::vector<int> evicted;
+
+    cache.put("a", 1, evicted);
+    cache.put("b", 2, evicted);
+    REQUIRE(evicted.empty());
+
+    int value = 0;
+    REQUIRE(cache.get("a", [&](const int& v) { value = v; }));
+    REQUIRE(value == 1);
+
+    // 'b' is least recently used
+    cache.put("c", 3, evicted);
+    REQUIRE(evicted == std::vector<int>{ 2 });
+    REQUIRE(!cache.get("b", [](const int&) {}));
+    REQUIRE(cache.get("c", [](const int&) {}));
+
+    REQUIRE(cache.hits() == 2);
+    REQUIRE(cache.misses() == 1);
+}
+
+TEST_CASE("Values are evicted by their cost", "[Core][LruCache]") {
+    ConcurrentLruCache<std::string, int, std::hash<std::string>, 1> cache(100);
+    std::vector<int> evicted;
+
+    cache.put("a", 1, evicted, 40);
+    cache.put("b", 2, evicted, 40);
+    REQUIRE(evicted.empty());
+    REQUIRE(cache.cost() == 80);
+
+    // Evicts 'a' to fit
+    cache.put("c", 3, evicted, 40);
+    REQUIRE(evicted == std::vector<int>{ 1 });
+    REQUIRE(cache.cost() == 80);
+
+    // Larger than the capacity on its own, only the new value remains
+    evicted.clear();
+    cache.put("d", 4, evicted, 200);
+    REQUIRE(evicted == std::vector<int>({ 2, 3 }));
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.cost() == 200);
+}
+
+TEST_CASE("Replaced and cleared values are handed back", "[Core][LruCache]") {
+    ConcurrentLruCache<std::string, int> cache(64);
+    std::vector<int> evicted;
+
+    cache.put("a", 1, evicted);
+    cache.put("a", 2, evicted);
+    REQUIRE(evicted == std::vector<int>{ 1 });
+    REQUIRE(cache.size() == 1);
+
+    evicted.clear();
+    cache.clear(evicted);
+    REQUIRE(evicted == std::vector<int>{ 2 });
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("Cache can be shared between threads", "[Core][LruCache]") {
+    ConcurrentLruCache<int, int> cache(1024);
+    std::atomic<int> wrongValues{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            std::vector<int> evicted;
+            for (int i = 0; i < 1000; i++) {
+                int key = i % 100;
+                if (!cache.get(key, [&](const int& v) { if (v != key * 2) { wrongValues++; } })) {
+                    cache.put(key, key * 2, evicted);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    REQUIRE(wrongValues == 0);
+    REQUIRE(cache.size() == 100);
+    REQUIRE((cache.hits() + cache.misses()) == 4000);
+}
@@ -0,0 +1,55 @@
+#include "catch.hpp"
+
+#include "data/properties.h"
+#include "data/propertyItem.h"
+
+#include <memory>
+
+using namespace Tangram;
+
+static std::shared_ptr<PropertyDictionary> makeDictionary() {
+    auto dictionary = std::make_shared<PropertyDictionary>();
+    dictionary->keys = { "kind", "name", "height" };
+    dictionary->values = { std::string("residential"), std::string("a"), 10.0 };
+    return dictionary;
+}
+
+TEST_CASE("Properties reference the values of a shared dictionary", "[Core][Properties]") {
+    auto dictionary = makeDictionary();
+
+    Properties props;
+    props.setShared(dictionary, { {2, 2}, {0, 0} });
+    props.sort();
+
+    REQUIRE(props.isShared());
+    REQUIRE(props.size() == 2);
+    REQUIRE(props.getString("kind") == "residential");
+    REQUIRE(props.getNumber("height") == 10);
+    REQUIRE(!props.contains("name"));
+    REQUIRE(props.toJson() == "{ \"kind\": \"residential\",\"height\": \"10.000000\" }");
+
+    // The strings are owned by the dictionary
+    REQUIRE(&props.getString("kind") == &dictionary->values[0].get<std::string>());
+}
+
+TEST_CASE("Properties are copied out of the dictionary on modification", "[Core][Properties]") {
+    auto dictionary = makeDictionary();
+
+    Properties props;
+    props.setShared(dictionary, { {0, 0}, {1, 1} });
+
+    Properties copy = props;
+    copy.set("name", "b");
+    copy.set("min_zoom", 12);
+
+    REQUIRE(!copy.isShared());
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy.getString("kind") == "residential");
+    REQUIRE(copy.getString("name") == "b");
+    REQUIRE(copy.getNumber("min_zoom") == 12);
+
+    // The original and the dictionary are unchanged
+    REQUIRE(props.isShared());
+    REQUIRE(props.getString("name") == "a");
+    REQUIRE(dictionary->values[1].get<std::string>() == "a");
+}
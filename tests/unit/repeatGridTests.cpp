@@ -0,0 +1,41 @@
+#include "catch.hpp"
+
+#include "labels/repeatGrid.h"
+
+using namespace Tangram;
+
+TEST_CASE("Positions within the repeat distance are found across cells", "[Labels][RepeatGrid]") {
+    RepeatGrid grid(10.f);
+
+    REQUIRE(!grid.withinDistance({0.f, 0.f}, 10.f));
+
+    grid.insert({9.5f, 9.5f});
+    REQUIRE(grid.size() == 1);
+
+    // Neighbouring cells
+    REQUIRE(grid.withinDistance({10.5f, 10.5f}, 10.f));
+    REQUIRE(grid.withinDistance({0.f, 9.5f}, 10.f));
+    REQUIRE(grid.withinDistance({9.5f, 19.f}, 10.f));
+
+    // Same or adjacent cell, but too far
+    REQUIRE(!grid.withinDistance({0.f, 0.f}, 10.f));
+    REQUIRE(!grid.withinDistance({19.6f, 9.5f}, 10.f));
+    REQUIRE(!grid.withinDistance({40.f, 40.f}, 10.f));
+}
+
+TEST_CASE("Queries with a larger distance than the cell size look further", "[Labels][RepeatGrid]") {
+    RepeatGrid grid(10.f);
+    grid.insert({-25.f, 0.f});
+
+    REQUIRE(!grid.withinDistance({0.f, 0.f}, 10.f));
+    REQUIRE(grid.withinDistance({0.f, 0.f}, 30.f));
+}
+
+TEST_CASE("Reset removes all positions", "[Labels][RepeatGrid]") {
+    RepeatGrid grid(10.f);
+    grid.insert({1.f, 1.f});
+
+    grid.reset(5.f);
+    REQUIRE(grid.size() == 0);
+    REQUIRE(!grid.withinDistance({1.f, 1.f}, 5.f));
+}
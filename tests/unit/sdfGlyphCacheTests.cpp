@@ -0,0 +1,70 @@
+#include "catch.hpp"
+
+#include "text/sdfGlyphCache.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace Tangram;
+
+static std::vector<unsigned char> makeBitmap(uint16_t _width, uint16_t _height, unsigned char _seed) {
+    std::vector<unsigned char> bitmap(size_t(_width) * _height);
+    for (size_t i = 0; i < bitmap.size(); i++) {
+        bitmap[i] = (i * 31 + _seed) & 0xff;
+    }
+    return bitmap;
+}
+
+TEST_CASE("Distance fields are found by their glyph", "[Core][SdfGlyphCache]") {
+    SdfGlyphCache cache;
+
+    auto sdf = makeBitmap(8, 10, 2);
+    uint64_t face = SdfGlyphCache::hash("NotoSans-Regular.ttf", 20);
+    uint64_t key = SdfGlyphCache::key(face, 42, 16);
+
+    std::vector<unsigned char> out(sdf.size());
+    REQUIRE(!cache.get(key, 8, 10, out.data()));
+
+    cache.put(key, 8, 10, sdf.data());
+    REQUIRE(cache.get(key, 8, 10, out.data()));
+    REQUIRE(out == sdf);
+
+    // Another shape of the same key is not a match
+    REQUIRE(!cache.get(key, 10, 8, out.data()));
+
+    REQUIRE(SdfGlyphCache::key(face, 43, 16) != key);
+    REQUIRE(SdfGlyphCache::key(face, 42, 28) != key);
+    REQUIRE(SdfGlyphCache::key(face + 1, 42, 16) != key);
+}
+
+TEST_CASE("Glyph cache is stored and loaded again", "[Core][SdfGlyphCache]") {
+    const char* path = "sdfGlyphCacheTest.bin";
+
+    auto sdf = makeBitmap(12, 12, 6);
+    uint64_t key = SdfGlyphCache::key(1, 42, 16);
+
+    {
+        SdfGlyphCache cache;
+        cache.put(key, 12, 12, sdf.data());
+        REQUIRE(cache.store(path, 6));
+    }
+
+    {
+        SdfGlyphCache cache;
+        REQUIRE(cache.load(path, 6));
+        REQUIRE(cache.size() == 1);
+
+        std::vector<unsigned char> out(sdf.size());
+        REQUIRE(cache.get(key, 12, 12, out.data()));
+        REQUIRE(out == sdf);
+    }
+
+    {
+        // Distance fields of another radius don't match
+        SdfGlyphCache cache;
+        REQUIRE(!cache.load(path, 4));
+        REQUIRE(cache.size() == 0);
+    }
+
+    std::remove(path);
+}
@@ -0,0 +1,101 @@
+#include "catch.hpp"
+
+#include "gl_mock.h"
+#include "gl/renderState.h"
+#include "gl/shaderCache.h"
+#include "gl/shaderProgram.h"
+
+#include <memory>
+
+using namespace Tangram;
+
+static const std::string vertSrc = "#pragma tangram: defines\nvoid main() {}\n";
+static const std::string fragSrc = "void main() {}\n";
+
+static std::unique_ptr<ShaderProgram> makeProgram(const std::string& _define = "") {
+    auto program = std::make_unique<ShaderProgram>();
+    program->setSourceStrings(fragSrc, vertSrc);
+    if (!_define.empty()) {
+        program->addSourceBlock("defines", "#define " + _define + "\n");
+    }
+    return program;
+}
+
+TEST_CASE("Programs with the same source share one GL program", "[Core][ShaderCache]") {
+    RenderState rs;
+
+    auto a = makeProgram();
+    auto b = makeProgram();
+    auto c = makeProgram("OTHER");
+
+    GLMock::reset();
+
+    REQUIRE(a->use(rs));
+    REQUIRE(b->use(rs));
+    REQUIRE(c->use(rs));
+
+    REQUIRE(a->getGlProgram() == b->getGlProgram());
+    REQUIRE(a->getGlProgram() != c->getGlProgram());
+
+    REQUIRE(GLMock::calls.createProgram == 2);
+    REQUIRE(GLMock::calls.compileShader == 4);
+
+    REQUIRE(rs.shaderCache().hits() == 1);
+    REQUIRE(rs.shaderCache().misses() == 2);
+}
+
+TEST_CASE("Cached programs outlive their users for the next scene", "[Core][ShaderCache]") {
+    RenderState rs;
+
+    GLuint glProgram = 0;
+    {
+        auto a = makeProgram();
+        REQUIRE(a->use(rs));
+        glProgram = a->getGlProgram();
+    }
+    // Run the disposer of the first program
+    rs.jobQueue.runJobs();
+
+    GLMock::reset();
+
+    auto b = makeProgram();
+    REQUIRE(b->use(rs));
+
+    REQUIRE(b->getGlProgram() == glProgram);
+    REQUIRE(GLMock::calls.createProgram == 0);
+    REQUIRE(GLMock::calls.compileShader == 0);
+    REQUIRE(GLMock::calls.deleteProgram == 0);
+}
+
+TEST_CASE("Unused programs are deleted beyond the cache limit", "[Core][ShaderCache]") {
+    RenderState rs;
+
+    {
+        std::vector<std::unique_ptr<ShaderProgram>> programs;
+        for (size_t i = 0; i < ShaderCache::MAX_UNUSED_PROGRAMS + 2; i++) {
+            programs.push_back(makeProgram("PROGRAM_" + std::to_string(i)));
+            REQUIRE(programs.back()->use(rs));
+        }
+    }
+
+    GLMock::reset();
+    rs.jobQueue.runJobs();
+
+    REQUIRE(GLMock::calls.deleteProgram == 2);
+    REQUIRE(rs.shaderCache().size() == ShaderCache::MAX_UNUSED_PROGRAMS);
+}
+
+TEST_CASE("Shader cache is emptied when the GL context is lost", "[Core][ShaderCache]") {
+    RenderState rs;
+
+    auto a = makeProgram();
+    REQUIRE(a->use(rs));
+
+    rs.increaseGeneration();
+
+    GLMock::reset();
+
+    REQUIRE(a->use(rs));
+    REQUIRE(GLMock::calls.createProgram == 1);
+    REQUIRE(rs.shaderCache().size() == 1);
+}
@@ -0,0 +1,159 @@
+#include "catch.hpp"
+
+#include "gl_mock.h"
+#include "gl/dynamicQuadMesh.h"
+#include "gl/hardware.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
+#include "gl/vertexLayout.h"
+
+using namespace Tangram;
+
+struct QuadVertex {
+    float x;
+    float y;
+};
+
+static std::shared_ptr<VertexLayout> quadLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+    {"a_position", 2, GL_FLOAT, false, 0},
+}));
+
+static void pushQuads(DynamicQuadMesh<QuadVertex>& mesh, int count) {
+    for (int i = 0; i < count; i++) {
+        auto* quad = mesh.pushQuad();
+        for (int j = 0; j < 4; j++) { quad[j] = { float(i), float(j) }; }
+    }
+}
+
+static void setupShader(ShaderProgram& shader) {
+    shader.setSourceStrings("void main() {}\n", "void main() {}\n");
+}
+
+TEST_CASE("Dynamic quad meshes of one frame are uploaded at once", "[Core][StreamBuffer]") {
+    RenderState rs;
+    ShaderProgram shader;
+    setupShader(shader);
+
+    DynamicQuadMesh<QuadVertex> text(quadLayout, GL_TRIANGLES);
+    DynamicQuadMesh<QuadVertex> sprites(quadLayout, GL_TRIANGLES);
+    DynamicQuadMesh<QuadVertex> empty(quadLayout, GL_TRIANGLES);
+
+    pushQuads(text, 10);
+    pushQuads(sprites, 3);
+
+    GLMock::reset();
+
+    rs.quadStream().beginFrame();
+    text.upload(rs);
+    sprites.upload(rs);
+    empty.upload(rs);
+
+    // Staging does not touch GL
+    REQUIRE(GLMock::calls.bufferData == 0);
+    REQUIRE(rs.quadStream().stagedBytes() == 13 * 4 * sizeof(QuadVertex));
+
+    REQUIRE(text.draw(rs, shader));
+    REQUIRE(sprites.draw(rs, shader));
+    REQUIRE(!empty.draw(rs, shader));
+
+    REQUIRE(rs.quadStream().uploadCount() == 1);
+    REQUIRE(GLMock::calls.bufferData == 1);
+    REQUIRE(GLMock::calls.drawElements == 2);
+}
+
+TEST_CASE("Quad stream uploads once per frame", "[Core][StreamBuffer]") {
+    RenderState rs;
+    ShaderProgram shader;
+    setupShader(shader);
+
+    DynamicQuadMesh<QuadVertex> meshA(quadLayout, GL_TRIANGLES);
+    DynamicQuadMesh<QuadVertex> meshB(quadLayout, GL_TRIANGLES);
+
+    GLMock::reset();
+
+    const int frames = 5;
+    for (int frame = 0; frame < frames; frame++) {
+        meshA.clear();
+        meshB.clear();
+        pushQuads(meshA, frame + 1);
+        pushQuads(meshB, 2);
+
+        rs.quadStream().beginFrame();
+        meshA.upload(rs);
+        meshB.upload(rs);
+
+        meshA.draw(rs, shader);
+        meshB.draw(rs, shader);
+
+        REQUIRE(rs.quadStream().uploadCount() == 1);
+    }
+
+    REQUIRE(GLMock::calls.bufferData == frames);
+}
+
+TEST_CASE("Quad stream orphans and maps the buffer when mapbuffer is supported", "[Core][StreamBuffer]") {
+    RenderState rs;
+    ShaderProgram shader;
+    setupShader(shader);
+
+    DynamicQuadMesh<QuadVertex> mesh(quadLayout, GL_TRIANGLES);
+    pushQuads(mesh, 4);
+
+    Hardware::supportsMapBuffer = true;
+    GLMock::reset();
+
+    rs.quadStream().beginFrame();
+    mesh.upload(rs);
+    mesh.draw(rs, shader);
+
+    Hardware::supportsMapBuffer = false;
+
+    REQUIRE(rs.quadStream().uploadCount() == 1);
+    REQUIRE(GLMock::calls.mapBuffer == 1);
+    // Orphaning call, then the mocked map fails and the data goes through glBufferSubData
+    REQUIRE(GLMock::calls.bufferData == 1);
+    REQUIRE(GLMock::calls.bufferSubData == 1);
+}
+
+TEST_CASE("Unchanged quad meshes are not staged again", "[Core][StreamBuffer]") {
+    RenderState rs;
+    ShaderProgram shader;
+    setupShader(shader);
+
+    DynamicQuadMesh<QuadVertex> meshA(quadLayout, GL_TRIANGLES);
+    DynamicQuadMesh<QuadVertex> meshB(quadLayout, GL_TRIANGLES);
+    pushQuads(meshA, 2);
+    pushQuads(meshB, 2);
+
+    GLMock::reset();
+
+    rs.quadStream().beginFrame();
+    meshA.upload(rs);
+    meshB.upload(rs);
+    REQUIRE(meshA.draw(rs, shader));
+    REQUIRE(meshB.draw(rs, shader));
+    REQUIRE(GLMock::calls.bufferData == 1);
+
+    // Nothing changed, the previous buffer is drawn again
+    rs.quadStream().beginFrame();
+    meshA.upload(rs);
+    meshB.upload(rs);
+    REQUIRE(rs.quadStream().stagedBytes() == 4 * 4 * sizeof(QuadVertex));
+    REQUIRE(meshA.draw(rs, shader));
+    REQUIRE(meshB.draw(rs, shader));
+    REQUIRE(rs.quadStream().uploadCount() == 0);
+    REQUIRE(GLMock::calls.bufferData == 1);
+
+    // A changed mesh starts a new frame, the unchanged one is staged along with it
+    meshB.clear();
+    pushQuads(meshB, 1);
+
+    rs.quadStream().beginFrame();
+    meshA.upload(rs);
+    meshB.upload(rs);
+    REQUIRE(meshA.draw(rs, shader));
+    REQUIRE(meshB.draw(rs, shader));
+    REQUIRE(rs.quadStream().stagedBytes() == 3 * 4 * sizeof(QuadVertex));
+    REQUIRE(rs.quadStream().uploadCount() == 1);
+    REQUIRE(GLMock::calls.bufferData == 2);
+}
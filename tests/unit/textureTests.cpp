@@ -9,6 +9,8 @@ class TestTexture : public Texture {
 public:
     using Texture::Texture;
     const std::vector<DirtyRange>& dirtyRanges() { return m_dirtyRanges; }
+    const std::vector<GLuint>& data() { return m_data; }
+    using Texture::setRGBAData;
 };
 
 TEST_CASE("Merging of dirty Regions - Non overlapping, test ordering", "[Texture]") {
@@ -113,3 +115,45 @@ TEST_CASE("Merging of dirty Regions - Merge three regions, when 3rd region is ad
     }
 
 }
+
+TEST_CASE("RGBA pixels are packed into 16 bit formats", "[Texture]") {
+    // Red, green, blue and half transparent white
+    const unsigned char rgba[] = { 255, 0, 0, 255,   0, 255, 0, 255,
+                                   0, 0, 255, 255,   255, 255, 255, 128 };
+    auto pixels = reinterpret_cast<const GLuint*>(rgba);
+
+    {
+        TextureOptions options = {GL_RGB, GL_RGB, {GL_LINEAR, GL_LINEAR},
+                                  {GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE}, GL_UNSIGNED_SHORT_5_6_5};
+        TestTexture texture(0u, 0u, options);
+        texture.setRGBAData(pixels, 2, 2);
+
+        REQUIRE(texture.data().size() == 2);
+        auto packed = reinterpret_cast<const uint16_t*>(texture.data().data());
+        REQUIRE(packed[0] == 0xf800);
+        REQUIRE(packed[1] == 0x07e0);
+        REQUIRE(packed[2] == 0x001f);
+        REQUIRE(packed[3] == 0xffff);
+    }
+    {
+        TextureOptions options = {GL_RGBA, GL_RGBA, {GL_LINEAR, GL_LINEAR},
+                                  {GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE}, GL_UNSIGNED_SHORT_4_4_4_4};
+        TestTexture texture(0u, 0u, options);
+        texture.setRGBAData(pixels, 2, 2);
+
+        REQUIRE(texture.data().size() == 2);
+        auto packed = reinterpret_cast<const uint16_t*>(texture.data().data());
+        REQUIRE(packed[0] == 0xf00f);
+        REQUIRE(packed[3] == 0xfff8);
+    }
+    {
+        // Rows with an odd number of pixels keep 32 bits per pixel
+        TextureOptions options = {GL_RGB, GL_RGB, {GL_LINEAR, GL_LINEAR},
+                                  {GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE}, GL_UNSIGNED_SHORT_5_6_5};
+        TestTexture texture(0u, 0u, options);
+        texture.setRGBAData(pixels, 1, 4);
+
+        REQUIRE(texture.data().size() == 4);
+        REQUIRE(texture.data()[0] == pixels[0]);
+    }
+}
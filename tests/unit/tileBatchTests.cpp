@@ -0,0 +1,145 @@
+#include "catch.hpp"
+
+#include "gl_mock.h"
+#include "gl/hardware.h"
+#include "gl/mesh.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
+#include "gl/tileBatch.h"
+#include "gl/vertexLayout.h"
+
+using namespace Tangram;
+
+struct BatchVertex {
+    float x;
+    float y;
+};
+
+static std::shared_ptr<VertexLayout> batchVertexLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+    {"a_position", 2, GL_FLOAT, false, 0},
+}));
+
+static std::unique_ptr<Mesh<BatchVertex>> makeTileMesh(size_t quads) {
+    std::vector<BatchVertex> vertices;
+    std::vector<uint16_t> indices;
+
+    for (size_t i = 0; i < quads; i++) {
+        uint16_t base = vertices.size();
+        vertices.insert(vertices.end(), { {0, 0}, {1, 0}, {1, 1}, {0, 1} });
+        indices.insert(indices.end(), { base, uint16_t(base + 1), uint16_t(base + 2),
+                                        base, uint16_t(base + 2), uint16_t(base + 3) });
+    }
+
+    auto mesh = std::make_unique<Mesh<BatchVertex>>(batchVertexLayout, GL_TRIANGLES);
+    mesh->retainData();
+    mesh->compile(MeshData<BatchVertex>(std::move(indices), std::move(vertices)));
+    return mesh;
+}
+
+TEST_CASE("Tile meshes of a style are drawn with one draw call per batch", "[Core][TileBatch]") {
+    RenderState rs;
+    ShaderProgram shader;
+    shader.setSourceStrings("void main() {}\n", "void main() {}\n");
+
+    std::vector<std::unique_ptr<Mesh<BatchVertex>>> tiles;
+    for (int i = 0; i < 20; i++) { tiles.push_back(makeTileMesh(10)); }
+
+    GLMock::reset();
+
+    for (auto& mesh : tiles) { mesh->draw(rs, shader); }
+
+    REQUIRE(GLMock::calls.drawElements == 20);
+
+    TileBatch batch(TileBatch::createLayout(*batchVertexLayout), GL_TRIANGLES);
+    std::vector<RetainedMeshData> retained;
+
+    for (auto& mesh : tiles) {
+        RetainedMeshData data;
+        REQUIRE(mesh->retainedData(data));
+        REQUIRE(batch.add(data));
+        retained.push_back(data);
+    }
+    batch.compile();
+
+    REQUIRE(batch.tileCount() == 20);
+    REQUIRE(batch.holds(retained.data(), retained.size()));
+    REQUIRE(!batch.holds(retained.data(), retained.size() - 1));
+
+    GLMock::reset();
+
+    REQUIRE(batch.draw(rs, shader));
+    REQUIRE(GLMock::calls.drawElements == 1);
+}
+
+TEST_CASE("Tile batches are split at the maximum index value", "[Core][TileBatch]") {
+    RenderState rs;
+    ShaderProgram shader;
+    shader.setSourceStrings("void main() {}\n", "void main() {}\n");
+
+    // 40000 vertices per tile
+    auto meshA = makeTileMesh(10000);
+    auto meshB = makeTileMesh(10000);
+
+    TileBatch batch(TileBatch::createLayout(*batchVertexLayout), GL_TRIANGLES);
+
+    RetainedMeshData data;
+    REQUIRE(meshA->retainedData(data));
+    batch.add(data);
+    REQUIRE(meshB->retainedData(data));
+    batch.add(data);
+    batch.compile();
+
+    GLMock::reset();
+
+    REQUIRE(batch.draw(rs, shader));
+    REQUIRE(GLMock::calls.drawElements == 2);
+}
+
+TEST_CASE("Tile batches hold a limited number of tiles", "[Core][TileBatch]") {
+    auto mesh = makeTileMesh(1);
+    RetainedMeshData data;
+    REQUIRE(mesh->retainedData(data));
+
+    TileBatch batch(TileBatch::createLayout(*batchVertexLayout), GL_TRIANGLES);
+
+    for (size_t i = 0; i < TileBatch::MAX_TILES; i++) {
+        REQUIRE(batch.add(data));
+    }
+    REQUIRE(!batch.add(data));
+}
+
+TEST_CASE("Tiles per batch fit into the vertex uniforms of the hardware", "[Core][TileBatch]") {
+    uint32_t vectors = Hardware::maxVertexUniformVectors;
+
+    // OpenGL ES 2.0 minimum
+    Hardware::maxVertexUniformVectors = 128;
+    REQUIRE(TileBatch::maxTiles() == 24);
+
+    Hardware::maxVertexUniformVectors = 1024;
+    REQUIRE(TileBatch::maxTiles() == TileBatch::MAX_TILES);
+
+    Hardware::maxVertexUniformVectors = vectors;
+
+    auto mesh = makeTileMesh(1);
+    RetainedMeshData data;
+    REQUIRE(mesh->retainedData(data));
+
+    TileBatch batch(TileBatch::createLayout(*batchVertexLayout), GL_TRIANGLES, 4);
+    for (size_t i = 0; i < 4; i++) { REQUIRE(batch.add(data)); }
+    REQUIRE(!batch.add(data));
+}
+
+TEST_CASE("Meshes only provide retained data when requested", "[Core][TileBatch]") {
+    auto mesh = std::make_unique<Mesh<BatchVertex>>(batchVertexLayout, GL_TRIANGLES);
+    mesh->compile(MeshData<BatchVertex>({ 0, 1, 2 }, { {0, 0}, {1, 0}, {1, 1} }));
+
+    RetainedMeshData data;
+    REQUIRE(!mesh->retainedData(data));
+    REQUIRE(mesh->pendingUploadSize() > 0);
+
+    auto retained = makeTileMesh(1);
+    REQUIRE(retained->retainedData(data));
+    REQUIRE(data.nVertices == 4);
+    REQUIRE(data.nIndices == 6);
+    REQUIRE(retained->pendingUploadSize() == 0);
+}
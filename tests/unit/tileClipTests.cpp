@@ -0,0 +1,119 @@
+#include "catch.hpp"
+
+#include "data/propertyItem.h"
+#include "data/tileData.h"
+#include "tile/tileID.h"
+#include "util/tileClip.h"
+
+using namespace Tangram;
+
+TEST_CASE("Descendants are positioned within their ancestor", "[Core][TileClip]") {
+    TileID parent(10, 20, 5);
+
+    // Top left child, TileID y goes down while tile coordinates go up
+    TileClip::Transform topLeft(parent, TileID(20, 40, 6));
+    Point p = topLeft({0.f, 1.f, 0.f});
+    REQUIRE(p == Point(0.f, 1.f, 0.f));
+    p = topLeft({0.5f, 0.5f, 0.25f});
+    REQUIRE(p == Point(1.f, 0.f, 0.5f));
+
+    // Lower right grandchild
+    TileClip::Transform lowerRight(parent, TileID(43, 83, 7));
+    p = lowerRight({1.f, 0.f, 0.f});
+    REQUIRE(p == Point(1.f, 0.f, 0.f));
+    p = lowerRight({0.75f, 0.25f, 0.f});
+    REQUIRE(p == Point(0.f, 1.f, 0.f));
+}
+
+TEST_CASE("Lines are split where they leave the clip area", "[Core][TileClip]") {
+    // Leaves the area on the right and comes back
+    Line line = { {0.5f, 0.5f, 0.f}, {1.5f, 0.5f, 0.f}, {1.5f, 0.75f, 0.f}, {0.5f, 0.75f, 0.f} };
+
+    std::vector<Line> parts;
+    TileClip::clipLine(line, 0.f, 1.f, parts);
+
+    REQUIRE(parts.size() == 2);
+    REQUIRE(parts[0] == Line({ {0.5f, 0.5f, 0.f}, {1.f, 0.5f, 0.f} }));
+    REQUIRE(parts[1] == Line({ {1.f, 0.75f, 0.f}, {0.5f, 0.75f, 0.f} }));
+
+    // Passing outside
+    parts.clear();
+    TileClip::clipLine({ {-1.f, 2.f, 0.f}, {2.f, 2.f, 0.f} }, 0.f, 1.f, parts);
+    REQUIRE(parts.empty());
+}
+
+TEST_CASE("Polygon rings are closed after clipping", "[Core][TileClip]") {
+    Line ring = { {-1.f, -1.f, 0.f}, {0.5f, -1.f, 0.f}, {0.5f, 0.5f, 0.f}, {-1.f, 0.5f, 0.f}, {-1.f, -1.f, 0.f} };
+
+    Line clipped;
+    REQUIRE(TileClip::clipRing(ring, 0.f, 1.f, clipped));
+
+    REQUIRE(clipped.size() == 5);
+    REQUIRE(clipped.front() == clipped.back());
+    for (auto& p : clipped) {
+        REQUIRE(p.x > -1e-6f);
+        REQUIRE(p.x < 0.5f + 1e-6f);
+        REQUIRE(p.y > -1e-6f);
+        REQUIRE(p.y < 0.5f + 1e-6f);
+    }
+
+    REQUIRE(!TileClip::clipRing({ {2.f, 2.f, 0.f}, {3.f, 2.f, 0.f}, {3.f, 3.f, 0.f} }, 0.f, 1.f, clipped));
+}
+
+TEST_CASE("Descendants get their share of the features", "[Core][TileClip]") {
+    TileData tileData;
+    tileData.layers.emplace_back("layer");
+    auto& features = tileData.layers.back().features;
+
+    Feature point;
+    point.geometryType = GeometryType::points;
+    point.points = { {0.25f, 0.75f, 0.f}, {0.75f, 0.75f, 0.f} };
+    point.id = 1;
+    features.push_back(point);
+
+    Feature line;
+    line.geometryType = GeometryType::lines;
+    line.lines = { { {0.f, 0.25f, 0.f}, {1.f, 0.25f, 0.f} } };
+    line.id = 2;
+    features.push_back(line);
+
+    Feature polygon;
+    polygon.geometryType = GeometryType::polygons;
+    polygon.polygons = { { { {0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {1.f, 1.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, 0.f, 0.f} } } };
+    polygon.id = 3;
+    features.push_back(polygon);
+
+    TileID parent(0, 0, 1);
+
+    // Top left child gets one point and the polygon
+    auto topLeft = TileClip::clipToDescendant(tileData, parent, TileID(0, 0, 2), 0.f);
+    REQUIRE(topLeft->layers.size() == 1);
+
+    auto& clipped = topLeft->layers[0].features;
+    REQUIRE(clipped.size() == 2);
+    REQUIRE(clipped[0].id == 1);
+    REQUIRE(clipped[0].points == std::vector<Point>({ {0.5f, 0.5f, 0.f} }));
+    REQUIRE(clipped[1].id == 3);
+    REQUIRE(clipped[1].polygons.size() == 1);
+    REQUIRE(clipped[1].polygons[0][0].size() == 5);
+
+    // Lower left child gets the line and the polygon
+    auto lowerLeft = TileClip::clipToDescendant(tileData, parent, TileID(0, 1, 2), 0.f);
+    auto& lowerFeatures = lowerLeft->layers[0].features;
+    REQUIRE(lowerFeatures.size() == 2);
+    REQUIRE(lowerFeatures[0].id == 2);
+    REQUIRE(lowerFeatures[0].lines[0] == Line({ {0.f, 0.5f, 0.f}, {1.f, 0.5f, 0.f} }));
+    REQUIRE(lowerFeatures[1].id == 3);
+
+    // The buffer extends lines only, polygons end at the edges of the tile
+    auto buffered = TileClip::clipToDescendant(tileData, parent, TileID(0, 1, 2), 0.125f);
+    auto& bufferedFeatures = buffered->layers[0].features;
+    REQUIRE(bufferedFeatures.size() == 2);
+    REQUIRE(bufferedFeatures[0].lines[0] == Line({ {0.f, 0.5f, 0.f}, {1.125f, 0.5f, 0.f} }));
+    for (auto& p : bufferedFeatures[1].polygons[0][0]) {
+        REQUIRE(p.x >= 0.f);
+        REQUIRE(p.x <= 1.f);
+        REQUIRE(p.y >= 0.f);
+        REQUIRE(p.y <= 1.f);
+    }
+}
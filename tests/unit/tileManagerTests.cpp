@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
 #include "data/dataSource.h"
+#include "gl/renderState.h"
+#include "style/polygonStyle.h"
 #include "tile/tileManager.h"
 #include "tile/tileWorker.h"
 #include "util/mapProjection.h"
@@ -272,3 +274,179 @@ TEST_CASE( "Use proxy Tile - circular proxies", "[TileManager][updateTileSets]"
     REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,0));
 
 }
+
+struct PendingUploadMesh : StyledMesh {
+    bool uploaded = false;
+
+    bool draw(RenderState& rs, ShaderProgram& _shader) override { return true; }
+    size_t bufferSize() const override { return 1024; }
+    size_t pendingUploadSize() const override { return uploaded ? 0 : 1024; }
+    void uploadPending(RenderState& rs) override { uploaded = true; }
+};
+
+TEST_CASE( "Keep proxy Tiles until meshes are uploaded", "[TileManager][uploadTiles]" ) {
+    TestTileWorker worker;
+    TileManager tileManager(worker);
+    ViewState viewState { s_projection, true, glm::vec2(0), 1 };
+    PolygonStyle style("polygons");
+    RenderState rs;
+
+    auto source = std::make_shared<TestDataSource>();
+    std::vector<std::shared_ptr<DataSource>> sources = { source };
+    tileManager.setDataSources(sources);
+
+    std::set<TileID> visibleTiles = { TileID{0,0,0} };
+    tileManager.updateTileSets(viewState, visibleTiles);
+
+    auto task = worker.tasks.front();
+    worker.processTask();
+    task->tile()->setMesh(style, std::make_unique<PendingUploadMesh>());
+
+    tileManager.updateTileSets(viewState, visibleTiles);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 0);
+    REQUIRE(tileManager.hasPendingUploads());
+    REQUIRE(tileManager.hasLoadingTiles());
+
+    tileManager.uploadTiles(rs);
+
+    REQUIRE(!tileManager.hasPendingUploads());
+
+    tileManager.updateTileSets(viewState, visibleTiles);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(tileManager.getVisibleTiles()[0]->getPendingUploadSize() == 0);
+}
+
+TEST_CASE( "Upload at least one Tile per frame within budget", "[TileManager][uploadTiles]" ) {
+    TestTileWorker worker;
+    TileManager tileManager(worker);
+    ViewState viewState { s_projection, true, glm::vec2(0), 1 };
+    PolygonStyle style("polygons");
+    RenderState rs;
+
+    auto source = std::make_shared<TestDataSource>();
+    std::vector<std::shared_ptr<DataSource>> sources = { source };
+    tileManager.setDataSources(sources);
+    tileManager.setUploadBudget(1, 1000.f);
+
+    std::set<TileID> visibleTiles = { TileID{0,0,1}, TileID{1,0,1} };
+    tileManager.updateTileSets(viewState, visibleTiles);
+
+    while (!worker.tasks.empty()) {
+        auto task = worker.tasks.front();
+        worker.processTask();
+        task->tile()->setMesh(style, std::make_unique<PendingUploadMesh>());
+    }
+
+    tileManager.updateTileSets(viewState, visibleTiles);
+    REQUIRE(tileManager.getVisibleTiles().size() == 0);
+
+    tileManager.uploadTiles(rs);
+    REQUIRE(tileManager.hasPendingUploads());
+
+    tileManager.updateTileSets(viewState, visibleTiles);
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+
+    tileManager.uploadTiles(rs);
+    REQUIRE(!tileManager.hasPendingUploads());
+
+    tileManager.updateTileSets(viewState, visibleTiles);
+    REQUIRE(tileManager.getVisibleTiles().size() == 2);
+}
+
+TEST_CASE( "Pause loading Tiles beyond the memory budget", "[TileManager][loadingMemory]" ) {
+    TestTileWorker worker;
+    TileManager tileManager(worker);
+    ViewState viewState { s_projection, true, glm::vec2(0), 1 };
+    PolygonStyle style("polygons");
+    RenderState rs;
+
+    auto source = std::make_shared<TestDataSource>();
+    std::vector<std::shared_ptr<DataSource>> sources = { source };
+    tileManager.setDataSources(sources);
+    tileManager.setLoadingMemoryBudget(1200);
+
+    std::set<TileID> visibleTiles = { TileID{0,0,2}, TileID{1,1,2} };
+    tileManager.updateTileSets(viewState, visibleTiles);
+    REQUIRE(source->tileTaskCount == 2);
+
+    while (!worker.tasks.empty()) {
+        auto task = worker.tasks.front();
+        worker.processTask();
+        task->tile()->setMesh(style, std::make_unique<PendingUploadMesh>());
+    }
+
+    // The meshes of both Tiles exceed the budget, both are kept
+    tileManager.updateTileSets(viewState, visibleTiles);
+    REQUIRE(tileManager.getLoadingMemory().meshes == 2048);
+
+    // Loading waits until the Tiles freed their memory
+    visibleTiles.insert(TileID{2,2,2});
+    tileManager.updateTileSets(viewState, visibleTiles);
+    REQUIRE(source->tileTaskCount == 2);
+
+    tileManager.uploadTiles(rs);
+    tileManager.updateTileSets(viewState, visibleTiles);
+    REQUIRE(tileManager.getVisibleTiles().size() == 2);
+    REQUIRE(source->tileTaskCount == 3);
+}
+
+struct CachingDataSource : TestDataSource {
+    std::set<TileID> loaded;
+    bool respond = true;
+
+    bool loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) override {
+        tileTaskCount++;
+        if (respond) {
+            loaded.insert(_task->tileId());
+            static_cast<Task*>(_task.get())->gotData = true;
+            _cb.func(std::move(_task));
+        }
+        return true;
+    }
+
+    std::shared_ptr<TileTask> createTask(TileID _tileId, int _subTask) override {
+        auto task = TestDataSource::createTask(_tileId, _subTask);
+        static_cast<Task*>(task.get())->gotData = loaded.count(_tileId) > 0;
+        return task;
+    }
+};
+
+TEST_CASE( "Prefetch Tiles along the predicted view", "[TileManager][prefetch]" ) {
+    TestTileWorker worker;
+    TileManager tileManager(worker);
+    ViewState viewState { s_projection, true, glm::vec2(0), 1 };
+
+    auto source = std::make_shared<CachingDataSource>();
+    std::vector<std::shared_ptr<DataSource>> sources = { source };
+    tileManager.setDataSources(sources);
+
+    std::set<TileID> visibleTiles_1 = { TileID{0,0,1} };
+    tileManager.setPrefetchTiles({ TileID{1,0,1} });
+    tileManager.updateTileSets(viewState, visibleTiles_1);
+
+    REQUIRE(source->tileTaskCount == 2);
+    REQUIRE(tileManager.getPrefetchStats().requested == 1);
+
+    // The prefetched Tile becomes visible and is built from the cached data
+    std::set<TileID> visibleTiles_2 = { TileID{0,0,1}, TileID{1,0,1} };
+    tileManager.setPrefetchTiles({});
+    tileManager.updateTileSets(viewState, visibleTiles_2);
+
+    REQUIRE(source->tileTaskCount == 2);
+    REQUIRE(tileManager.getPrefetchStats().fetched == 1);
+    REQUIRE(tileManager.getPrefetchStats().hits == 1);
+
+    // Prefetches that are no longer predicted are canceled
+    source->respond = false;
+    tileManager.setPrefetchTiles({ TileID{0,1,1} });
+    tileManager.updateTileSets(viewState, visibleTiles_2);
+    REQUIRE(tileManager.getPrefetchStats().requested == 2);
+
+    tileManager.setPrefetchTiles({ TileID{1,1,1} });
+    tileManager.updateTileSets(viewState, visibleTiles_2);
+    REQUIRE(tileManager.getPrefetchStats().requested == 3);
+    REQUIRE(tileManager.getPrefetchStats().canceled == 1);
+    REQUIRE(tileManager.getPrefetchStats().hits == 1);
+}